@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_BATCH_QUERY_ENGINE_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_BATCH_QUERY_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+struct BatchLatencyStats {
+    size_t chunkCount = 0;
+    int64_t p50Us = 0;
+    int64_t p90Us = 0;
+    int64_t p99Us = 0;
+    int64_t maxUs = 0;
+};
+
+// runs the queries of a list-style command in chunks on a bounded number of threads
+class BatchQueryEngine {
+public:
+    // a chunkSize of 0 queries all the items in one chunk
+    BatchQueryEngine(int32_t jobs, size_t chunkSize);
+
+    // keeps the first of equal keys in input order, and returns for every input the index of its unique key
+    template <typename Key>
+    static std::vector<size_t> Deduplicate(const std::vector<Key> &inputs, std::vector<Key> &uniqueKeys)
+    {
+        std::vector<size_t> uniqueIndexes;
+        uniqueIndexes.reserve(inputs.size());
+        std::unordered_map<Key, size_t> keyIndexes;
+        keyIndexes.reserve(inputs.size());
+        uniqueKeys.clear();
+        for (const auto &input : inputs) {
+            auto [iter, isNew] = keyIndexes.emplace(input, uniqueKeys.size());
+            if (isNew) {
+                uniqueKeys.emplace_back(input);
+            }
+            uniqueIndexes.emplace_back(iter->second);
+        }
+        return uniqueIndexes;
+    }
+
+    // query(begin, end) is called once per chunk of [0, count), and must write only the results of its chunk
+    void Run(size_t count, const std::function<void(size_t begin, size_t end)> &query);
+    BatchLatencyStats GetLatencyStats() const;
+    static std::string FormatLatencyStats(const BatchLatencyStats &stats);
+
+private:
+    int32_t jobs_ = 1;
+    size_t chunkSize_ = 0;
+    std::vector<int64_t> chunkLatencies_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_BATCH_QUERY_ENGINE_H
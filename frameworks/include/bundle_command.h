@@ -16,16 +16,20 @@
 #ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_BM_INCLUDE_BUNDLE_COMMAND_H
 #define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_BM_INCLUDE_BUNDLE_COMMAND_H
 
+#include <iostream>
+
 #include "shell_command.h"
 #include "bundle_mgr_interface.h"
 #include "bundle_installer_interface.h"
+#include "content_hash_cache.h"
+#include "status_receiver_impl.h"
 
 namespace OHOS {
 namespace AppExecFwk {
 namespace {
 const std::string TOOL_NAME = "bm";
 
-const std::string HELP_MSG = "usage: bm <command> <options>\n"
+const std::string HELP_MSG = "usage: bm [--trace[=<file>]] <command> <options>\n"
                              "These are common bm commands list:\n"
                              "  help         list available commands\n"
                              "  install      install a bundle with options\n"
@@ -40,7 +44,8 @@ const std::string HELP_MSG = "usage: bm <command> <options>\n"
                              "  dump-overlay dump overlay info of the specific overlay bundle\n"
                              "  dump-target-overlay dump overlay info of the specific target bundle\n"
                              "  dump-dependencies dump dependencies by given bundle name and module name\n"
-                             "  dump-shared dump inter-application shared library information by bundle name\n";
+                             "  dump-shared dump inter-application shared library information by bundle name\n"
+                             "  batch        execute bm commands from a script file or stdin in one process\n";
 
 const std::string ENABLE_DISABLE_HELP_MSG = "  enable       enable the bundle\n"
                                             "  disable      disable the bundle\n";
@@ -81,18 +86,43 @@ const std::string HELP_MSG_INSTALL =
     "                                                                    the maximum waitting time is 600s\n"
     "  -d, --downgrade                                                install allow downgrade\n"
     "  -g, --grant-permission                                         grant permissions for installation\n"
-    "  -v, --variant-bundle                                     specify the bundle is same name with variant bundle\n";
+    "  -v, --variant-bundle                                     specify the bundle is same name with variant bundle\n"
+    "  --parallel <parallel-number>                                   install different bundles concurrently,\n"
+    "                                                                    paths are grouped by bundle name,\n"
+    "                                                                    the maximum parallel number is 16\n"
+    "  --progress                                                     print the install progress in json lines\n"
+    "  --verify                                                       check the zip structure and module.json of\n"
+    "                                                                    the files before installing them, FA model\n"
+    "                                                                    files with config.json are not supported\n"
+    "  --force                                                        install the files even if they are unchanged,\n"
+    "                                                                    with BM_SKIP_UNCHANGED=1 an install of the\n"
+    "                                                                    files of the last install is skipped while\n"
+    "                                                                    their modules are still installed\n";
+
+const std::string HELP_MSG_BATCH =
+    "usage: bm batch <options>\n"
+    "options list:\n"
+    "  -h, --help                           list available commands\n"
+    "  -f, --file <script-path>             execute the bm commands in the script, one command per line,\n"
+    "                                          read the commands from stdin if no file or '-' is given,\n"
+    "                                          empty lines and lines starting with '#' are ignored\n";
 
 const std::string HELP_MSG_UNINSTALL =
     "usage: bm uninstall <options>\n"
     "options list:\n"
     "  -h, --help                           list available commands\n"
-    "  -n, --bundle-name <bundle-name>      uninstall a bundle by bundle name\n"
+    "  -n, --bundle-name <bundle-name>      uninstall a bundle by bundle name, repeat it or separate the names\n"
+    "                                          by commas to uninstall many bundles\n"
     "  -m, --module-name <module-name>      uninstall a module by module name\n"
     "  -u, --user-id <user-id>              specify a user id,only supports current user or userId is 0\n"
     "  -k, --keep-data                      keep the user data after uninstall\n"
     "  -s, --shared                         uninstall inter-application shared library\n"
-    "  -v, --version                        uninstall a inter-application shared library by versionCode\n";
+    "  -v, --version                        uninstall a inter-application shared library by versionCode\n"
+    "  --from-file <file-path>              uninstall the bundles listed in the file, one bundle name per line,\n"
+    "                                          read the names from stdin if '-' is given\n"
+    "  --parallel <parallel-number>         uninstall many bundles concurrently, default is 4,\n"
+    "                                          the maximum parallel number is 16\n"
+    "  --progress                           print the uninstall progress in json lines\n";
 
 const std::string HELP_MSG_UNINSTALL_SHARE =
     "usage: bm uninstall-shared <options>\n"
@@ -111,17 +141,24 @@ const std::string HELP_MSG_DUMP =
     "  -s, --shortcut-info                  list the shortcut info\n"
     "  -d, --device-id <device-id>          specify a device id\n"
     "  -u, --user-id <user-id>              specify a user id,only supports current user or userId is 0\n"
-    "  -l, --label                          list the label info\n";
+    "  -l, --label                          list the label info\n"
+    "  --offset <offset>                    with -a, skip the first offset bundles of the sorted list\n"
+    "  --limit <limit>                      with -a, list at most limit bundles\n";
 
 const std::string HELP_MSG_CLEAN =
     "usage: bm clean <options>\n"
     "options list:\n"
     "  -h, --help                                      list available commands\n"
-    "  -n, --bundle-name  <bundle-name>                bundle name\n"
+    "  -n, --bundle-name  <bundle-name>                bundle name, repeat it or separate the names by commas\n"
+    "                                                    to clean many bundles\n"
     "  -c, --cache                                     clean bundle cache files by bundle name\n"
-    "  -d, --data                                      clean bundle data files by bundle name\n"
+    "  -d, --data                                      clean bundle data files by bundle name, with '-c' the\n"
+    "                                                    cache is cleaned first\n"
     "  -u, --user-id <user-id>                         specify a user id,only supports current user or userId is 0\n"
-    "  -i, --app-index <app-index>                     specify a app index\n";
+    "  -i, --app-index <app-index>                     specify a app index\n"
+    "  --all-third-party                               clean all the bundles that are not system apps\n"
+    "  --parallel <parallel-number>                    clean many bundles concurrently, default is 4,\n"
+    "                                                    the maximum parallel number is 16\n";
 
 const std::string HELP_MSG_ENABLE =
     "usage: bm enable <options>\n"
@@ -156,9 +193,14 @@ const std::string HELP_MSG_QUICK_FIX =
     "-a, --apply                                  indicates apply quickfix, used with -f or --file-path\n"
     "-t, --target <target-path>                   indicates a target path to apply quickfix\n"
     "-o, --overwrite                              apply a quickfix in overwrite mode\n"
+    "--force                                      apply the quickfix files even if they are unchanged, with\n"
+    "                                             BM_SKIP_UNCHANGED=1 the files of the last apply are skipped\n"
+    "                                             while their patch is still applied\n"
     "-f, --file-path <file-path>                  apply a quickfix file by a specified path\n"
     "-f, --file-path <file-path> <file-path> ...  apply some quickfix files of one bundle\n"
-    "-f, --file-path <bundle-direction>           apply quickfix files by direction, under which are quickfix files\n";
+    "-f, --file-path <bundle-direction>           apply quickfix files by direction, under which are quickfix files\n"
+    "-f <file-path> ... -f <file-path> ...        apply the quickfix files of many bundles concurrently,\n"
+    "                                             one -f per bundle\n";
 
 const std::string HELP_MSG_OVERLAY =
     "usage: bm dump-overlay <options>\n"
@@ -167,6 +209,7 @@ const std::string HELP_MSG_OVERLAY =
     "  -b, --bundle-name <bundle-name>                    bundle name of the overlay bundle\n"
     "  -m, --module-name <module-name>                    module name of the overlay bundle\n"
     "  -t, --target-module-name <target-module-name>      target module name of overlay bundle\n"
+    "  -a, --all                                          overlay graph of all bundles, without -b, -m and -t\n"
     "  -u, --user-id <user-id>                            specify a user id,\n"
     "                                                         only supports current user or userId is 0\n";
 
@@ -221,11 +264,22 @@ const std::string HELP_MSG_NO_BUNDLE_PATH_OPTION =
 const std::string HELP_MSG_NO_BUNDLE_NAME_OPTION =
     "error: you must specify a bundle name with '-n' or '--bundle-name'.";
 
+const std::string HELP_MSG_DUMP_PAGE_WITHOUT_ALL =
+    "error: '--offset' and '--limit' only page the list of all bundles, use them with '-a' or '--all'.";
+
 const std::string STRING_INSTALL_BUNDLE_OK = "install bundle successfully.";
 const std::string STRING_INSTALL_BUNDLE_NG = "error: failed to install bundle.";
+const std::string STRING_INSTALL_BUNDLE_PARTIAL_NG = "error: failed to install some bundles.";
+
+const std::string STRING_BATCH_OPEN_FILE_NG = "error: failed to open the batch script.";
+const std::string STRING_BATCH_NESTED_NG = "error: batch is not supported in a batch script.";
 
 const std::string STRING_UNINSTALL_BUNDLE_OK = "uninstall bundle successfully.";
 const std::string STRING_UNINSTALL_BUNDLE_NG = "error: failed to uninstall bundle.";
+const std::string STRING_UNINSTALL_BUNDLE_PARTIAL_NG = "error: failed to uninstall some bundles.";
+const std::string STRING_UNINSTALL_OPEN_FILE_NG = "error: failed to open the bundle name file.";
+const std::string STRING_UNINSTALL_MULTIPLE_BUNDLES_NG =
+    "error: '-m' and '-s' can not be used with more than one bundle.";
 
 const std::string HELP_MSG_NO_DATA_OR_CACHE_OPTION =
     "error: you must specify '-c' or '-d' for 'bm clean' option.";
@@ -234,6 +288,8 @@ const std::string STRING_CLEAN_CACHE_BUNDLE_NG = "error: failed to clean bundle
 
 const std::string STRING_CLEAN_DATA_BUNDLE_OK = "clean bundle data files successfully.";
 const std::string STRING_CLEAN_DATA_BUNDLE_NG = "error: failed to clean bundle data files.";
+const std::string STRING_CLEAN_BUNDLE_PARTIAL_NG = "error: failed to clean some bundles.";
+const std::string STRING_CLEAN_GET_BUNDLES_NG = "error: failed to get the third party bundles.";
 
 const std::string STRING_ENABLE_BUNDLE_OK = "enable bundle successfully.";
 const std::string STRING_ENABLE_BUNDLE_NG = "error: failed to enable bundle.";
@@ -264,6 +320,42 @@ const std::string WARNING_USER =
     "Warning: The current user is %. If you want to set the userId as $, please switch to $.\n";
 } // namespace
 
+class AppMgrClient;
+
+struct BundleInstallGroup {
+    std::string bundleName;
+    std::vector<std::string> bundlePaths;
+    int32_t resultCode = ERR_OK;
+    std::string resultMsg;
+    int64_t costTime = 0;
+};
+
+struct BundleCleanTask {
+    std::string bundleName;
+    bool isSuccess = false;
+    bool isCacheSuccess = false;
+    bool isDataSuccess = false;
+    // the size of the data, database and cache of the bundle, before and after the clean
+    bool hasStats = false;
+    int64_t reclaimedSize = 0;
+    int64_t costTime = 0;
+};
+
+struct BundleUninstallTask {
+    std::string bundleName;
+    sptr<StatusReceiverImpl> statusReceiver;
+    bool isStarted = false;
+    int32_t resultCode = ERR_OK;
+    int64_t costTime = 0;
+};
+
+// the overlay modules of a bundle and the overlay bundles which target it, empty for a bundle without overlay
+struct BundleOverlayEdges {
+    ErrCode errCode = ERR_OK;
+    std::vector<OverlayModuleInfo> overlayModuleInfos;
+    std::vector<OverlayBundleInfo> overlayBundleInfos;
+};
+
 class BundleManagerShellCommand : public ShellCommand {
 public:
     BundleManagerShellCommand(int argc, char *argv[]);
@@ -277,6 +369,7 @@ private:
 
     ErrCode RunAsHelpCommand();
     ErrCode RunAsInstallCommand();
+    ErrCode RunAsBatchCommand();
     ErrCode RunAsUninstallCommand();
     ErrCode RunAsDumpCommand();
     ErrCode RunAsCleanCommand();
@@ -300,6 +393,12 @@ private:
     std::string CompileReset(const std::string &bundleName, bool isAllBundle) const;
 
     std::string DumpBundleList(int32_t userId) const;
+    // all bundles of the user with their clones in a stable order, so that the pages of a list do not overlap
+    bool GetSortedBundleInfos(int32_t userId, std::vector<BundleInfo> &bundleInfos) const;
+    // the distinct bundle names of GetSortedBundleInfos
+    bool GetSortedBundleNames(int32_t userId, std::vector<std::string> &bundleNames) const;
+    // every page is written as soon as it is ready, so the first bundles are printed before the last are fetched
+    ErrCode DumpBundleListByPage(int32_t userId, bool withLabel, int32_t offset, int32_t limit);
     std::string DumpDebugBundleList(int32_t userId) const;
     std::string DumpBundleInfo(const std::string &bundleName, int32_t userId) const;
     std::string DumpShortcutInfos(const std::string &bundleName, int32_t userId) const;
@@ -313,23 +412,66 @@ private:
 
     int32_t InstallOperation(const std::vector<std::string> &bundlePaths, InstallParam &installParam,
         int32_t waittingTime, std::string &resultMsg) const;
+    int32_t StreamInstallOperation(const std::vector<std::string> &absPaths, const InstallParam &installParam,
+        int32_t waittingTime, std::string &resultMsg) const;
+    int32_t ParallelInstallOperation(const std::vector<std::string> &bundlePaths, InstallParam &installParam,
+        int32_t waittingTime, int32_t parallelNum, std::string &resultMsg) const;
+    void GroupBundlePathsByBundleName(const std::vector<std::string> &absPaths, int32_t parallelNum,
+        std::vector<BundleInstallGroup> &groups) const;
+    std::string GetArchiveBundleName(const std::string &path) const;
+    // checks the files locally so that a broken one fails the install before any ipc
+    bool VerifyInstallFiles(const std::vector<std::string> &bundlePaths, const InstallParam &installParam,
+        bool allowManyBundles, std::string &resultMsg) const;
+    // true if every file is recorded in the cache with its current content and its module is still installed,
+    // fileEntries keeps the hashes of all the files for the record after the install
+    bool IsInstallUnchanged(const std::vector<std::string> &absPaths, int32_t userId,
+        const ContentHashCache &hashCache, std::vector<ContentHashEntry> &fileEntries) const;
+    // the entries keep the update time of the installed bundle, which identifies the exact build on the device
+    void RecordInstalledFiles(const std::vector<std::string> &absPaths, int32_t userId,
+        std::vector<ContentHashEntry> &fileEntries, ContentHashCache &hashCache) const;
+    void ExecBatchScript(std::istream &input, std::ostream &output);
+    bool ExecBatchLine(const std::vector<std::string> &args, std::string &result);
+    void AttachProgressOutput(const sptr<StatusReceiverImpl> &statusReceiver, const std::string &operation,
+        const std::string &target) const;
+    void PrintOperationLatency(const sptr<StatusReceiverImpl> &statusReceiver, const std::string &operation,
+        const std::string &target, int32_t resultCode) const;
     int32_t UninstallOperation(const std::string &bundleName, const std::string &moduleName,
                                InstallParam &installParam) const;
     int32_t UninstallSharedOperation(const UninstallParam &uninstallParam) const;
+    // at most parallelNum uninstalls are in flight at a time, the outcome of every bundle is put in resultMsg
+    int32_t ParallelUninstallOperation(const std::vector<std::string> &bundleNames,
+        const InstallParam &installParam, int32_t parallelNum, std::string &resultMsg) const;
+    bool StartUninstallTask(BundleUninstallTask &task, const InstallParam &installParam) const;
     std::string GetUdid() const;
     bool IsInstallOption(int index) const;
-    void GetAbsPaths(const std::vector<std::string> &paths, std::vector<std::string> &absPaths) const;
+    // real and de-duplicated paths in command line order, with directories expanded on demand
+    void GetAbsPaths(const std::vector<std::string> &paths, std::vector<std::string> &absPaths,
+        bool expandDirs = false) const;
 
     ErrCode GetBundlePath(const std::string& param, std::vector<std::string>& bundlePaths) const;
 
     bool CleanBundleCacheFilesOperation(const std::string &bundleName, int32_t userId, int32_t appIndex = 0) const;
-    bool CleanBundleDataFilesOperation(const std::string &bundleName, int32_t userId, int32_t appIndex = 0) const;
+    bool CleanBundleDataFilesOperation(const std::string &bundleName, int32_t userId, int32_t appIndex,
+        AppMgrClient &appMgrClient) const;
+    // at most parallelNum bundles are cleaned at a time, sharing one app manager client, the cache of a bundle is
+    // cleaned before its data, the outcome and the reclaimed size of every bundle is put in resultMsg
+    int32_t ParallelCleanOperation(const std::vector<std::string> &bundleNames, int32_t userId, int32_t appIndex,
+        bool cleanCache, bool cleanData, int32_t parallelNum, std::string &resultMsg) const;
+    bool GetBundleCleanableSize(const std::string &bundleName, int32_t userId, int32_t appIndex,
+        int64_t &size) const;
+    bool GetThirdPartyBundleNames(int32_t userId, std::vector<std::string> &bundleNames) const;
     void GetUdidOperation();
 
     bool SetApplicationEnabledOperation(const AbilityInfo &abilityInfo, bool isEnable, int32_t userId) const;
     std::string DumpOverlayInfo(const std::string &bundleName, const std::string &moduleName,
         const std::string &targetModuleName, int32_t userId);
     std::string DumpTargetOverlayInfo(const std::string &bundleName, const std::string &moduleName, int32_t userId);
+    // the overlay edges of every bundle of the user in one compact json, eg:
+    // {"userId":100,"bundleCount":2,"overlayModules":{"<overlay bundle>":[["<module>","<target module>",
+    // <priority>,<state>]]},"overlayBundles":{"<target bundle>":[["<overlay bundle>",<priority>,<state>]]}}
+    std::string DumpOverlayGraph(int32_t userId);
+    // fetched once and kept with the other proxies, the workers of a graph dump share it
+    sptr<IOverlayManager> GetOverlayManagerProxy();
     ErrCode ParseSharedDependenciesCommand(int32_t option, std::string &bundleName, std::string &moduleName);
     ErrCode ParseSharedCommand(int32_t option, std::string &bundleName, bool &dumpSharedAll);
     ErrCode ParseCopyApCommand(int32_t option, std::string &bundleName, bool &isAllBundle);
@@ -345,6 +487,8 @@ private:
 
     sptr<IBundleMgr> bundleMgrProxy_;
     sptr<IBundleInstaller> bundleInstallerProxy_;
+    sptr<IOverlayManager> overlayManagerProxy_;
+    bool showProgress_ = false;
 
     static std::map<int32_t, int32_t> errCodeMap_;
 };
@@ -19,6 +19,7 @@
 #include "bundle_mgr_interface.h"
 #include "bundle_installer_interface.h"
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -28,8 +29,18 @@ class BundleCommandCommon {
 public:
     static sptr<IBundleMgr> GetBundleMgrProxy();
 
+    // the foreground user and the foreground state of a user are queried once per process, until the
+    // cache is invalidated
     static int32_t GetCurrentUserId(int32_t userId);
     static bool IsUserForeground(int32_t userId);
+    static void InvalidateUserCache();
+    // invalidates the user cache on every user switch, for the commands that outlive a switch, eg: bm batch,
+    // false if a switch is not seen and the caller has to invalidate the cache itself
+    static bool SubscribeUserSwitch();
+    static void UnsubscribeUserSwitch();
+
+    // run task(0) ... task(taskCount - 1) on at most jobs threads, the caller thread included
+    static void ParallelFor(size_t taskCount, int32_t jobs, const std::function<void(size_t)> &task);
 
     static std::map<int32_t, std::string> bundleMessageMap_;
 };
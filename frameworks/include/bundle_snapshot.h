@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_BUNDLE_SNAPSHOT_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_BUNDLE_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+struct BundleSnapshotRecord {
+    std::string bundleName;
+    std::string deviceType;
+    int32_t uid = -1;
+    int32_t appIndex = 0;
+    int32_t apiTargetVersion = 0;
+};
+
+/*
+ * A read-only index of the bundles of one user, mapped from a file and searched by bundle name or uid.
+ * The file is trusted only while its watcher holds the lock next to it, the lock is released by the system when
+ * the watcher exits in any way.
+ */
+class BundleSnapshot {
+public:
+    BundleSnapshot() = default;
+    ~BundleSnapshot();
+
+    // the path of the snapshot set by the environment, empty if the snapshot is not enabled
+    static std::string GetPathFromEnv();
+    // write the records to a temporary file and rename it to path, so that readers never see a partial file
+    static bool Write(const std::string &path, int32_t userId, bool isWatched,
+        const std::vector<BundleSnapshotRecord> &records);
+    static void Invalidate(const std::string &path);
+    // the descriptor of the watcher lock of path, -1 if another watcher holds it
+    static int32_t LockWatcher(const std::string &path);
+    static void UnlockWatcher(int32_t lockFd);
+
+    // a snapshot which is not watched is only opened with isWatchRequired unset, eg: to inspect it
+    bool Open(const std::string &path, bool isWatchRequired = true);
+    void Close();
+    int32_t GetUserId() const;
+    size_t GetRecordCount() const;
+    bool FindByBundleName(const std::string &bundleName, int32_t appIndex, BundleSnapshotRecord &record) const;
+    bool FindByUid(int32_t uid, BundleSnapshotRecord &record) const;
+
+private:
+    bool CheckLayout() const;
+    void GetRecord(uint32_t index, BundleSnapshotRecord &record) const;
+
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    DISALLOW_COPY_AND_MOVE(BundleSnapshot);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_BUNDLE_SNAPSHOT_H
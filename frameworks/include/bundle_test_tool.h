@@ -16,25 +16,42 @@
 #ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_FRAMEWORK_BUNDLE_TOOL_INCLUDE_BUNDLE_TEST_TOOL_H
 #define FOUNDATION_BUNDLEMANAGER_BUNDLE_FRAMEWORK_BUNDLE_TOOL_INCLUDE_BUNDLE_TEST_TOOL_H
 
+#include <functional>
 #include <getopt.h>
+#include <iostream>
+#include <map>
+#include <set>
 
 #include "shell_command.h"
 #include "bundle_event_callback_host.h"
+#include "bundle_snapshot.h"
 #include "bundle_mgr_interface.h"
 #include "bundle_installer_interface.h"
+#include "option_schema.h"
 
 namespace OHOS {
 namespace AppExecFwk {
 class BundleEventCallbackImpl : public BundleEventCallbackHost {
 public:
     BundleEventCallbackImpl();
+    // eventHandler is called with the bundle name of every received event
+    explicit BundleEventCallbackImpl(const std::function<void(const std::string &)> &eventHandler);
     virtual ~BundleEventCallbackImpl() override;
     virtual void OnReceiveEvent(const EventFwk::CommonEventData eventData) override;
 
 private:
+    std::function<void(const std::string &)> eventHandler_;
     DISALLOW_COPY_AND_MOVE(BundleEventCallbackImpl);
 };
 
+// the options of the snapshot command
+struct SnapshotOptions {
+    int32_t userId = Constants::UNSPECIFIED_USERID;
+    std::string path;
+    bool isWatch = false;
+    bool isDelete = false;
+};
+
 class BundleTestTool : public ShellCommand {
 public:
     BundleTestTool(int argc, char *argv[]);
@@ -152,7 +169,24 @@ private:
     ErrCode RunAsGetTopNLargestItemsInAppDataDir();
     // eg: bundle_test_tool batchGetBundleInfo -n <bundle-name>,<bundle-name> -f <flags> -u <user-id>
     ErrCode RunAsBatchGetBundleInfo();
+    ErrCode StreamBatchGetBundleInfo(const std::vector<std::string> &bundleNames, int32_t flags, int32_t userId,
+        int32_t chunkSize, std::ostream &output, size_t &bundleCount);
+    // appends the message of a failed parse, the caller appends the help text
+    bool CheckOptionParseResult(OptionParseResult parseResult, std::string &errorOption);
+    static const OptionSchema<SnapshotOptions> &GetSnapshotOptionSchema();
+    // eg: bundle_test_tool snapshot -u <user-id> -f <file-path> -w
+    ErrCode RunAsSnapshotCommand();
+    ErrCode BuildBundleSnapshot(int32_t userId, const std::string &path, bool isWatched, size_t &bundleCount);
+    ErrCode WatchBundleSnapshot(int32_t userId, const std::string &path);
+    bool FindInBundleSnapshot(const std::string &bundleName, int32_t userId, int32_t appIndex,
+        BundleSnapshotRecord &record) const;
     ErrCode RunAsParseSpmModule();
+    // a directory is searched recursively for module.json files
+    void CollectModuleJsonPaths(const std::string &path, std::vector<std::string> &moduleJsonPaths) const;
+    bool ParseSpmModuleFile(const std::string &moduleJsonPath, int32_t indent, std::string &resultMsg) const;
+    bool ReadModuleJsonFile(const std::string &moduleJsonPath, std::string &moduleJson, std::string &errorMsg) const;
+    // resultMsg is the parsed module in json, it is left as is on a failure
+    bool ParseSpmModuleJson(const std::string &moduleJson, int32_t indent, std::string &resultMsg) const;
     ErrCode RunAsQueryAbilityInfo();
     ErrCode ParseQueryAbilityInfoOptions(std::string &bundleName, std::string &moduleName,
         std::string &abilityName, int32_t &flags, int32_t &userId);
@@ -241,6 +275,12 @@ private:
     bool StrToUint32(const std::string &str, uint32_t &value);
     ErrCode DeployQuickFix(const std::vector<std::string> &quickFixPaths,
         std::shared_ptr<QuickFixResult> &quickFixRes, bool isDebug);
+    // deploys the patches of many bundles, the hqf files are grouped by the bundleName of their patch.json
+    ErrCode DeployQuickFixByBundle(const std::vector<std::string> &quickFixPaths, bool isDebug,
+        std::string &resultMsg);
+    // appends a line to errorMsg for every patch path or hqf file that is invalid
+    static bool GroupQuickFixPathsByBundle(const std::vector<std::string> &quickFixPaths,
+        std::map<std::string, std::set<std::string>> &groupedPaths, std::string &errorMsg);
     ErrCode SwitchQuickFix(const std::string &bundleName, int32_t enable,
         std::shared_ptr<QuickFixResult> &quickFixRes);
     ErrCode DeleteQuickFix(const std::string &bundleName, std::shared_ptr<QuickFixResult> &quickFixRes);
@@ -250,15 +290,15 @@ private:
     bool GetBundleInodeCount(const std::string &bundleName, int32_t appIndex, int32_t userId, std::string &msg);
     bool BatchGetBundleStats(const std::vector<std::string> &bundleNames, int32_t userId, std::string &msg);
     bool GetAllBundleStats(int32_t userId, std::string &msg);
-    bool GetEachBundleCacheStat(int32_t userId, std::string &msg);
+    bool GetEachBundleCacheStat(int32_t userId, std::string &msg, int32_t jobs = 1, int32_t batchSize = 0);
+    void GetBundleCacheStatsByBatch(const std::vector<BundleInfo> &bundleInfos, int32_t userId, int32_t batchSize,
+        std::vector<int64_t> &cacheSizes);
+    ErrCode EachBundleCacheStatCommonFunc(int32_t &userId, int32_t &jobs, int32_t &batchSize);
     ErrCode GetAppProvisionInfo(const std::string &bundleName, int32_t userId, std::string &msg);
     ErrCode GetDistributedBundleName(const std::string &networkId, int32_t accessTokenId, std::string &msg);
     ErrCode BundleNameAndUserIdCommonFunc(std::string &bundleName, int32_t &userId, int32_t &appIndex);
     ErrCode BatchBundleNameAndUserIdCommonFunc(std::vector<std::string> &bundleNames, int32_t &userId);
     ErrCode UserIdCommonFunc(int32_t &userId);
-    ErrCode BatchBundleNameCommonFunc(std::string short_option,
-                                      const struct option *long_options,
-                                      std::vector<std::string> &bundleNames);
     ErrCode CheckGetDistributedBundleNameCorrectOption(int32_t option, const std::string &commandName,
         std::string &networkId, int32_t &accessTokenId);
     bool QueryDataGroupInfos(const std::string &bundleName, int32_t userId, std::string& msg);
@@ -285,7 +325,6 @@ private:
     bool ProcessAppDistributionTypeEnums(std::vector<std::string> appDistributionTypeStrings,
         std::set<AppDistributionTypeEnum> &appDistributionTypeEnums);
     void ReloadNativeTokenInfo();
-    ErrCode InnerGetSimpleAppInfoForUid(const int32_t &option, std::vector<std::int32_t> &uids);
     ErrCode UninstallPreInstallBundleOperation(
         const std::string &bundleName, InstallParam &installParam) const;
     bool CheckUnisntallCorrectOption(int option, const std::string &commandName,
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_COMMAND_TRACE_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_COMMAND_TRACE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+enum class TraceCategory : uint8_t {
+    COMMAND,
+    PARSE,
+    PROXY,
+    IPC,
+    SERIALIZE,
+    OUTPUT,
+};
+
+struct TraceEvent {
+    // a string literal, the events outlive the spans
+    const char *name = "";
+    TraceCategory category = TraceCategory::COMMAND;
+    int64_t beginUs = 0;
+    int64_t wallUs = 0;
+    int64_t cpuUs = 0;
+    int64_t threadId = 0;
+};
+
+// the timing of one command, recorded only while a trace target is set
+class CommandTrace {
+public:
+    // "--trace" or "--trace=<file>" before the command name, removed from argv by ShellCommand
+    static constexpr const char *TRACE_OPTION = "--trace";
+    // "1" or "summary" for a summary line on stderr, or a file path with a '/' for chrome trace-event json,
+    // "0", an empty value or any other value disables the trace
+    static constexpr const char *TRACE_ENV = "BM_TRACE";
+
+    // an empty target disables the trace, the events of the previous command are dropped
+    static void Start(const std::string &target);
+    static bool IsEnabled();
+    static void Record(const TraceEvent &event);
+    // writes the events to the target and clears them
+    static void Finish();
+    static int64_t GetElapsedUs();
+    static int64_t GetThreadCpuUs();
+
+    static std::string FormatSummary(const std::vector<TraceEvent> &events);
+    static std::string FormatChromeTrace(const std::vector<TraceEvent> &events);
+};
+
+class CommandTraceSpan {
+public:
+    CommandTraceSpan(const char *name, TraceCategory category);
+    ~CommandTraceSpan();
+
+    CommandTraceSpan(const CommandTraceSpan &) = delete;
+    CommandTraceSpan &operator=(const CommandTraceSpan &) = delete;
+
+    // ends the span before the scope does, eg: when the options are parsed
+    void End();
+
+private:
+    bool isEnabled_ = false;
+    TraceEvent event_;
+};
+
+// eg: bool ret = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&] { return proxy->DumpInfos(...); });
+template <typename Function>
+auto TracedCall(const char *name, TraceCategory category, Function &&function) -> decltype(function())
+{
+    CommandTraceSpan span(name, category);
+    return std::forward<Function>(function)();
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_COMMAND_TRACE_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_COMPLETION_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_COMPLETION_H
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+class Deadline {
+public:
+    // the earlier of now + timeout and the deadline of the current thread
+    static Deadline After(std::chrono::milliseconds timeout);
+    static Deadline Never();
+    // the deadline set by the innermost ScopedDeadline of the current thread
+    static Deadline Current();
+
+    Deadline Min(const Deadline &other) const;
+    bool IsExpired() const;
+    std::chrono::steady_clock::time_point GetTimePoint() const;
+
+private:
+    explicit Deadline(std::chrono::steady_clock::time_point timePoint);
+
+    std::chrono::steady_clock::time_point timePoint_;
+};
+
+// bound every wait of the current thread by the deadline until the scope ends
+class ScopedDeadline {
+public:
+    explicit ScopedDeadline(const Deadline &deadline);
+    ~ScopedDeadline();
+
+private:
+    Deadline previous_;
+    DISALLOW_COPY_AND_MOVE(ScopedDeadline);
+};
+
+// a one-shot signal set by an ipc callback, any number of signals can be waited for by one thread
+class CompletionSignal {
+public:
+    enum class WaitResult {
+        READY,
+        TIMEOUT,
+        CANCELED,
+    };
+
+    CompletionSignal() = default;
+    virtual ~CompletionSignal() = default;
+
+    // false if the signal is set already
+    bool Signal();
+    bool IsSignaled() const;
+    WaitResult Wait(const Deadline &deadline) const;
+
+    static WaitResult WaitAll(const std::vector<const CompletionSignal *> &signals, const Deadline &deadline);
+    // index is the first signal which is set when READY is returned
+    static WaitResult WaitAny(const std::vector<const CompletionSignal *> &signals, const Deadline &deadline,
+        size_t &index);
+
+    // the first SIGINT cancels the waits in progress, a SIGINT without any wait in progress or the second one
+    // terminates the process as before
+    static void InstallInterruptHandler();
+    static void RequestCancel();
+    static bool IsCancelRequested();
+    static void ResetCancel();
+
+private:
+    bool signaled_ = false;
+    DISALLOW_COPY_AND_MOVE(CompletionSignal);
+};
+
+// a completion signal carrying the result, which can be read any number of times
+template<typename T>
+class Completion : public CompletionSignal {
+public:
+    Completion() = default;
+    ~Completion() override = default;
+
+    // false if the value is set already, the first value wins
+    bool SetValue(const T &value)
+    {
+        std::lock_guard<std::mutex> lock(valueMutex_);
+        if (IsSignaled()) {
+            return false;
+        }
+        value_ = value;
+        return Signal();
+    }
+
+    using CompletionSignal::Wait;
+    WaitResult Wait(const Deadline &deadline, T &value) const
+    {
+        WaitResult result = Wait(deadline);
+        if (result == WaitResult::READY) {
+            std::lock_guard<std::mutex> lock(valueMutex_);
+            value = value_;
+        }
+        return result;
+    }
+
+private:
+    mutable std::mutex valueMutex_;
+    T value_ {};
+    DISALLOW_COPY_AND_MOVE(Completion);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_COMPLETION_H
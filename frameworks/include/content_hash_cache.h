@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_CONTENT_HASH_CACHE_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_CONTENT_HASH_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace AppExecFwk {
+struct ContentHashEntry {
+    std::string hash;
+    int64_t size = 0;
+    std::string bundleName;
+    // empty for a quick fix file
+    std::string moduleName;
+    // the bundle version code of a hap or hsp, the patch version code of a hqf
+    int64_t versionCode = -1;
+    // the exact build on the device: the update time of the bundle for a hap or hsp, the hash of the applied patch
+    // info for a hqf, a build of the same version installed in between does not match it
+    std::string buildId;
+};
+
+// the content hashes of the files pushed by a successful install or quick fix apply, so that a file which is
+// unchanged and still installed is not sent to the bundle manager service again
+class ContentHashCache {
+public:
+    // "1" enables the skip of unchanged files, "--force" of the command pushes them anyway
+    static constexpr const char *SKIP_UNCHANGED_ENV = "BM_SKIP_UNCHANGED";
+    static constexpr const char *FORCE_OPTION = "--force";
+    static constexpr const char *DEFAULT_CACHE_PATH = "/data/local/tmp/bm_content_hash_cache.json";
+
+    static bool IsSkipUnchangedEnabled();
+    // crc32 and adler32 of the content, both streamed through zlib in chunks
+    static bool ComputeHash(const std::string &path, std::string &hash, int64_t &size);
+    static std::string ComputeTextHash(const std::string &text);
+    static std::string FormatAvoidedSize(size_t fileCount, int64_t avoidedSize);
+
+    explicit ContentHashCache(const std::string &cachePath = DEFAULT_CACHE_PATH);
+
+    // a missing or broken cache file is an empty cache, and so is one which another user owns or may write
+    void Load();
+    // written to a temporary file and renamed, a concurrent bm never reads half a cache
+    bool Save() const;
+    // false if the path is unknown or its content changed since the entry was recorded
+    bool Lookup(const std::string &path, const std::string &hash, int64_t size, ContentHashEntry &entry) const;
+    void Update(const std::string &path, const ContentHashEntry &entry);
+    // drops the entries of the bundle, eg: when its patch is replaced without a record, false if it had none
+    bool Erase(const std::string &bundleName);
+
+private:
+    std::string cachePath_;
+    std::unordered_map<std::string, ContentHashEntry> entries_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_CONTENT_HASH_CACHE_H
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_HAP_VERIFIER_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_HAP_VERIFIER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+struct HapVerifyResult {
+    std::string path;
+    bool isValid = false;
+    std::string errorMsg;
+    std::string bundleName;
+    std::string moduleName;
+    int64_t versionCode = -1;
+};
+
+// checks the hap and hsp files on the device before they are sent to the bundle manager service
+class HapVerifier {
+public:
+    // the zip central directory and module.json of one archive, an FA model archive with config.json fails
+    static bool VerifyArchive(const std::string &path, HapVerifyResult &result);
+    // every archive on at most jobs threads, then the archives of one bundle must have one version and
+    // distinct modules, and all of them must belong to one bundle unless allowManyBundles is set
+    static bool VerifyArchives(const std::vector<std::string> &paths, int32_t jobs, bool allowManyBundles,
+        std::vector<HapVerifyResult> &results, std::string &errorMsg);
+    // the bundleName in patch.json of one hqf file
+    static bool GetQuickFixBundleName(const std::string &path, std::string &bundleName, std::string &errorMsg);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_HAP_VERIFIER_H
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_OPTION_SCHEMA_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_OPTION_SCHEMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "command_trace.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+enum class OptionType : uint8_t {
+    FLAG,
+    STRING,
+    // the option may be repeated, every value is kept
+    STRING_LIST,
+    INT32,
+};
+
+enum class OptionParseResult : uint8_t {
+    OK,
+    HELP,
+    UNKNOWN_OPTION,
+    MISSING_VALUE,
+    INVALID_VALUE,
+    MISSING_REQUIRED,
+};
+
+// what the parser, the help text and the input schema need to know about one option
+struct OptionSpec {
+    char shortName = '\0';
+    const char *longName = "";
+    OptionType type = OptionType::FLAG;
+    const char *valueName = "";
+    // a line break starts an indented line in the help text
+    const char *description = "";
+    bool isRequired = false;
+    int32_t minValue = std::numeric_limits<int32_t>::min();
+    int32_t maxValue = std::numeric_limits<int32_t>::max();
+};
+
+// an option and the member of T that it is parsed into
+template <typename T>
+struct OptionField {
+    OptionSpec spec;
+    bool T::*flag = nullptr;
+    std::string T::*text = nullptr;
+    std::vector<std::string> T::*texts = nullptr;
+    int32_t T::*number = nullptr;
+};
+
+template <typename T>
+constexpr OptionField<T> FlagOption(char shortName, const char *longName, bool T::*member,
+    const char *description)
+{
+    OptionField<T> field;
+    field.spec.shortName = shortName;
+    field.spec.longName = longName;
+    field.spec.type = OptionType::FLAG;
+    field.spec.description = description;
+    field.flag = member;
+    return field;
+}
+
+template <typename T>
+constexpr OptionField<T> StringOption(char shortName, const char *longName, std::string T::*member,
+    const char *valueName, const char *description, bool isRequired = false)
+{
+    OptionField<T> field;
+    field.spec.shortName = shortName;
+    field.spec.longName = longName;
+    field.spec.type = OptionType::STRING;
+    field.spec.valueName = valueName;
+    field.spec.description = description;
+    field.spec.isRequired = isRequired;
+    field.text = member;
+    return field;
+}
+
+template <typename T>
+constexpr OptionField<T> StringListOption(char shortName, const char *longName,
+    std::vector<std::string> T::*member, const char *valueName, const char *description, bool isRequired = false)
+{
+    OptionField<T> field;
+    field.spec.shortName = shortName;
+    field.spec.longName = longName;
+    field.spec.type = OptionType::STRING_LIST;
+    field.spec.valueName = valueName;
+    field.spec.description = description;
+    field.spec.isRequired = isRequired;
+    field.texts = member;
+    return field;
+}
+
+template <typename T>
+constexpr OptionField<T> Int32Option(char shortName, const char *longName, int32_t T::*member,
+    const char *valueName, int32_t minValue, int32_t maxValue, const char *description, bool isRequired = false)
+{
+    OptionField<T> field;
+    field.spec.shortName = shortName;
+    field.spec.longName = longName;
+    field.spec.type = OptionType::INT32;
+    field.spec.valueName = valueName;
+    field.spec.description = description;
+    field.spec.isRequired = isRequired;
+    field.spec.minValue = minValue;
+    field.spec.maxValue = maxValue;
+    field.number = member;
+    return field;
+}
+
+class OptionSchemaHelper {
+public:
+    static bool ParseInt32(const char *text, int32_t minValue, int32_t maxValue, int32_t &value);
+    static void AppendHelpLine(const OptionSpec &spec, std::string &help);
+    // a property in the inputSchema format of a cli tool config.json
+    static void AppendSchemaProperty(const OptionSpec &spec, std::string &schema);
+    static void AppendSchemaString(std::string_view text, std::string &schema);
+    static std::string ToCamelCase(std::string_view longName);
+};
+
+// the options of one command, -h and --help are implied
+template <typename T>
+class OptionSchema {
+public:
+    template <size_t N>
+    constexpr OptionSchema(const char *usage, const OptionField<T> (&fields)[N])
+        : usage_(usage), fields_(fields), fieldCount_(N)
+    {
+        static_assert(N <= MAX_FIELD_COUNT, "too many options for the required option mask");
+    }
+
+    // one pass over argv from firstIndex without the global getopt state, errorOption is the argument
+    // that stopped the parse
+    OptionParseResult Parse(int argc, char *argv[], int firstIndex, T &options, std::string &errorOption) const
+    {
+        CommandTraceSpan parseSpan("OptionSchema::Parse", TraceCategory::PARSE);
+        uint64_t seenMask = 0;
+        for (int index = firstIndex; index < argc; ++index) {
+            std::string_view arg = argv[index];
+            errorOption = arg;
+            if (arg.size() < MIN_OPTION_SIZE || arg[0] != '-') {
+                return OptionParseResult::UNKNOWN_OPTION;
+            }
+            OptionParseResult result = arg[1] == '-' ?
+                ParseLongOption(argc, argv, index, options, seenMask) :
+                ParseShortOptions(argc, argv, index, options, seenMask);
+            if (result != OptionParseResult::OK) {
+                return result;
+            }
+        }
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            if (fields_[i].spec.isRequired && (seenMask & (1ULL << i)) == 0) {
+                errorOption = std::string("--") + fields_[i].spec.longName;
+                return OptionParseResult::MISSING_REQUIRED;
+            }
+        }
+        errorOption.clear();
+        return OptionParseResult::OK;
+    }
+
+    std::string GetHelp() const
+    {
+        std::string help = usage_;
+        help.append("options list:\n");
+        OptionSpec helpSpec;
+        helpSpec.shortName = 'h';
+        helpSpec.longName = "help";
+        helpSpec.description = "list available commands";
+        OptionSchemaHelper::AppendHelpLine(helpSpec, help);
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            OptionSchemaHelper::AppendHelpLine(fields_[i].spec, help);
+        }
+        return help;
+    }
+
+    std::string GetInputSchema() const
+    {
+        std::string schema = "{\"type\":\"object\",\"properties\":{\"help\":{\"type\":\"boolean\",\"default\":false}";
+        std::string required;
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            schema.push_back(',');
+            OptionSchemaHelper::AppendSchemaProperty(fields_[i].spec, schema);
+            if (fields_[i].spec.isRequired) {
+                required.append(required.empty() ? "" : ",");
+                OptionSchemaHelper::AppendSchemaString(OptionSchemaHelper::ToCamelCase(fields_[i].spec.longName),
+                    required);
+            }
+        }
+        schema.push_back('}');
+        if (!required.empty()) {
+            schema.append(",\"required\":[").append(required).append("]");
+        }
+        schema.push_back('}');
+        return schema;
+    }
+
+private:
+    static constexpr size_t MAX_FIELD_COUNT = 64;
+    static constexpr size_t MIN_OPTION_SIZE = 2;
+    static constexpr size_t LONG_PREFIX_SIZE = 2;
+
+    OptionParseResult ParseLongOption(int argc, char *argv[], int &index, T &options, uint64_t &seenMask) const
+    {
+        std::string_view name = std::string_view(argv[index]).substr(LONG_PREFIX_SIZE);
+        const char *value = nullptr;
+        size_t equalPos = name.find('=');
+        if (equalPos != std::string_view::npos) {
+            value = argv[index] + LONG_PREFIX_SIZE + equalPos + 1;
+            name = name.substr(0, equalPos);
+        }
+        if (name == "help") {
+            return OptionParseResult::HELP;
+        }
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            if (name != fields_[i].spec.longName) {
+                continue;
+            }
+            if (fields_[i].spec.type == OptionType::FLAG) {
+                return value == nullptr ? Assign(i, nullptr, options, seenMask) : OptionParseResult::INVALID_VALUE;
+            }
+            if (value == nullptr) {
+                if (index + 1 >= argc) {
+                    return OptionParseResult::MISSING_VALUE;
+                }
+                value = argv[++index];
+            }
+            return Assign(i, value, options, seenMask);
+        }
+        return OptionParseResult::UNKNOWN_OPTION;
+    }
+
+    // flags may be grouped as in -wd, and a value may follow its option directly as in -u100
+    OptionParseResult ParseShortOptions(int argc, char *argv[], int &index, T &options, uint64_t &seenMask) const
+    {
+        const char *arg = argv[index];
+        for (size_t pos = 1; arg[pos] != '\0'; ++pos) {
+            if (arg[pos] == 'h') {
+                return OptionParseResult::HELP;
+            }
+            size_t i = 0;
+            while (i < fieldCount_ && fields_[i].spec.shortName != arg[pos]) {
+                ++i;
+            }
+            if (i == fieldCount_) {
+                return OptionParseResult::UNKNOWN_OPTION;
+            }
+            if (fields_[i].spec.type == OptionType::FLAG) {
+                Assign(i, nullptr, options, seenMask);
+                continue;
+            }
+            const char *value = arg + pos + 1;
+            if (*value == '\0') {
+                if (index + 1 >= argc) {
+                    return OptionParseResult::MISSING_VALUE;
+                }
+                value = argv[++index];
+            }
+            return Assign(i, value, options, seenMask);
+        }
+        return OptionParseResult::OK;
+    }
+
+    OptionParseResult Assign(size_t fieldIndex, const char *value, T &options, uint64_t &seenMask) const
+    {
+        const OptionField<T> &field = fields_[fieldIndex];
+        seenMask |= 1ULL << fieldIndex;
+        switch (field.spec.type) {
+            case OptionType::FLAG:
+                options.*(field.flag) = true;
+                return OptionParseResult::OK;
+            case OptionType::STRING:
+                options.*(field.text) = value;
+                return OptionParseResult::OK;
+            case OptionType::STRING_LIST:
+                (options.*(field.texts)).emplace_back(value);
+                return OptionParseResult::OK;
+            case OptionType::INT32:
+                return OptionSchemaHelper::ParseInt32(value, field.spec.minValue, field.spec.maxValue,
+                    options.*(field.number)) ? OptionParseResult::OK : OptionParseResult::INVALID_VALUE;
+            default:
+                return OptionParseResult::INVALID_VALUE;
+        }
+    }
+
+    const char *usage_ = "";
+    const OptionField<T> *fields_ = nullptr;
+    size_t fieldCount_ = 0;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_OPTION_SCHEMA_H
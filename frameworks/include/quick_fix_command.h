@@ -18,16 +18,27 @@
 
 #include <vector>
 
+#include "content_hash_cache.h"
 #include "quick_fix_info.h"
 
 namespace OHOS {
 namespace AppExecFwk {
 class QuickFixCommand {
 public:
+// with BM_SKIP_UNCHANGED=1 the files of the last apply are not applied again unless isForce is set
 static int32_t ApplyQuickFix(const std::vector<std::string> &quickFixFiles, std::string &resultInfo,
-    bool isDebug = false, bool isReplace = false);
+    bool isDebug = false, bool isReplace = false, bool isForce = false);
+// every patch set holds the quick fix files of one bundle, the sets are applied concurrently
+static int32_t ApplyQuickFixes(const std::vector<std::vector<std::string>> &patchSets, std::string &resultInfo,
+    bool isDebug = false, bool isReplace = false, bool isForce = false);
 static int32_t GetApplyedQuickFixInfo(const std::string &bundleName, std::string &resultInfo);
 static std::string GetQuickFixInfoString(const AAFwk::ApplicationQuickFixInfo &quickFixInfo);
+// true if every file is recorded in the cache with its current content, record is the entry of the first file and
+// fileEntries keeps the hashes of all the files for the record after the apply
+static bool IsQuickFixUnchanged(const std::vector<std::string> &quickFixFiles, const ContentHashCache &hashCache,
+    std::vector<std::string> &realPaths, std::vector<ContentHashEntry> &fileEntries, ContentHashEntry &record);
+// true if the applied patch of the bundle is still the recorded one
+static bool IsQuickFixStillApplied(const ContentHashEntry &record, const AAFwk::ApplicationQuickFixInfo &quickFixInfo);
 };
 } // namespace AppExecFwk
 } // namespace OHOS
@@ -17,11 +17,13 @@
 #define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_BM_INCLUDE_SHELL_COMMAND_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <functional>
 #include <vector>
 
 #include "errors.h"
+#include "output_sink.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -41,6 +43,8 @@ public:
     std::string GetCommandErrorMsg() const;
     std::string GetUnknownOptionMsg(std::string &unknownOption) const;
     std::string GetMessageFromCode(const int32_t code) const;
+    // once a sink is set, the output is written to it instead of being returned by ExecCommand
+    void SetOutputSink(const std::shared_ptr<OutputSink> &outputSink);
 
     virtual ErrCode CreateCommandMap() = 0;
     virtual ErrCode CreateMessageMap() = 0;
@@ -49,8 +53,13 @@ public:
 protected:
     static constexpr int MIN_ARGUMENT_NUMBER = 2;
 
+    // write the pending resultReceiver_ and data to the sink, or append data to resultReceiver_ without a sink
+    void WriteOutput(std::string &&data);
+
     int argc_;
     char **argv_;
+    // the argv seen by the command, argv_ points into it
+    std::vector<char *> args_;
 
     std::string cmd_;
     std::vector<std::string> argList_;
@@ -60,6 +69,7 @@ protected:
     std::map<int32_t, std::string> messageMap_;
 
     std::string resultReceiver_ = "";
+    std::shared_ptr<OutputSink> outputSink_;
 };
 
 }  // namespace AppExecFwk
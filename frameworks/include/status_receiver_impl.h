@@ -16,13 +16,23 @@
 #ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_BM_INCLUDE_STATUS_RECEIVER_IMPL_H
 #define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_BM_INCLUDE_STATUS_RECEIVER_IMPL_H
 
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include "completion.h"
 #include "status_receiver_host.h"
 
 namespace OHOS {
 namespace AppExecFwk {
 class StatusReceiverImpl : public StatusReceiverHost {
 public:
+    // progress and the elapsed milliseconds since the receiver is created
+    using ProgressCallback = std::function<void(int32_t progress, int64_t elapsedTime)>;
+    // the result code of a wait canceled by SIGINT, out of the range of the IStatusReceiver codes
+    static constexpr int32_t ERR_OPERATION_CANCELED = 9001;
+
     StatusReceiverImpl(int32_t waittingTime);
     StatusReceiverImpl();
     virtual ~StatusReceiverImpl() override;
@@ -31,13 +41,24 @@ public:
     virtual void OnFinished(const int32_t resultCode, const std::string &resultMsg) override;
     int32_t GetResultCode() const;
     std::string GetResultMsg() const;
+    void SetProgressCallback(const ProgressCallback &callback);
+    // elapsed milliseconds since the receiver is created, -1 if it has not happened
+    int64_t GetFirstProgressTime() const;
+    int64_t GetFinishTime() const;
+    // set when OnFinished is called, for waiting on many receivers at once
+    const CompletionSignal &GetCompletion() const;
 
 private:
-    mutable std::promise<int32_t> resultCodeSignal_;
-    mutable std::promise<std::string> resultMsgSignal_;
+    int64_t GetElapsedTime() const;
+    CompletionSignal::WaitResult WaitForResult(std::pair<int32_t, std::string> &result) const;
+
+    Completion<std::pair<int32_t, std::string>> result_;
     int32_t waittingTime_;
-    bool isSetValue = false;
-    std::mutex setValueMutex_;
+    std::chrono::steady_clock::time_point beginTime_;
+    std::atomic<int64_t> firstProgressTime_ { -1 };
+    std::atomic<int64_t> finishTime_ { -1 };
+    std::mutex progressMutex_;
+    ProgressCallback progressCallback_;
     DISALLOW_COPY_AND_MOVE(StatusReceiverImpl);
 };
 }  // namespace AppExecFwk
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_TEXT_BUILDER_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_TEXT_BUILDER_H
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace OHOS {
+namespace AppExecFwk {
+// one fragment of a line, an integer is formatted into the fragment itself instead of a std::to_string temporary
+class TextPiece {
+public:
+    TextPiece(std::string_view text) : text_(text)
+    {}
+    TextPiece(const std::string &text) : text_(text)
+    {}
+    TextPiece(const char *text) : text_(text == nullptr ? std::string_view() : std::string_view(text))
+    {}
+    TextPiece(char ch) : text_(buffer_, 1)
+    {
+        buffer_[0] = ch;
+    }
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+        !std::is_same<T, char>::value, int>::type = 0>
+    TextPiece(T value)
+    {
+        std::to_chars_result result = std::to_chars(buffer_, buffer_ + sizeof(buffer_), value);
+        text_ = std::string_view(buffer_, static_cast<size_t>(result.ptr - buffer_));
+    }
+
+    // the view may point into the piece, a piece is never copied or moved
+    TextPiece(const TextPiece &) = delete;
+    TextPiece &operator=(const TextPiece &) = delete;
+
+    std::string_view Get() const
+    {
+        return text_;
+    }
+
+private:
+    // enough for the sign and the digits of an int64_t
+    static constexpr size_t INTEGER_BUFFER_SIZE = 24;
+
+    char buffer_[INTEGER_BUFFER_SIZE] = {0};
+    std::string_view text_;
+};
+
+// appends the fragments of a text output to the end of the target in place, the target grows geometrically so a
+// few thousand lines cost a few allocations, eg: builder.AppendLine("  bundle name: ", info.bundleName);
+class TextBuilder {
+public:
+    explicit TextBuilder(std::string &target, size_t reserveSize = 0);
+
+    // reserves size more bytes after the current end of the target
+    void Reserve(size_t size);
+    size_t GetSize() const;
+
+    template <typename... Args>
+    TextBuilder &Append(const Args &...args)
+    {
+        const TextPiece pieces[] = { TextPiece(args)... };
+        size_t size = 0;
+        for (const TextPiece &piece : pieces) {
+            size += piece.Get().size();
+        }
+        Grow(size);
+        for (const TextPiece &piece : pieces) {
+            target_.append(piece.Get().data(), piece.Get().size());
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    TextBuilder &AppendLine(const Args &...args)
+    {
+        return Append(args..., '\n');
+    }
+
+private:
+    void Grow(size_t size);
+
+    std::string &target_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_INCLUDE_TEXT_BUILDER_H
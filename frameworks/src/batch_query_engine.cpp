@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "batch_query_engine.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "app_log_wrapper.h"
+#include "bundle_command_common.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+constexpr size_t PERCENT_50 = 50;
+constexpr size_t PERCENT_90 = 90;
+constexpr size_t PERCENT_99 = 99;
+constexpr size_t PERCENT_100 = 100;
+
+// nearest rank of the sorted latencies
+int64_t GetPercentile(const std::vector<int64_t> &sortedLatencies, size_t percent)
+{
+    size_t rank = (sortedLatencies.size() * percent + PERCENT_100 - 1) / PERCENT_100;
+    return sortedLatencies[std::max<size_t>(rank, 1) - 1];
+}
+}  // namespace
+
+BatchQueryEngine::BatchQueryEngine(int32_t jobs, size_t chunkSize)
+    : jobs_(std::max(jobs, 1)), chunkSize_(chunkSize)
+{}
+
+void BatchQueryEngine::Run(size_t count, const std::function<void(size_t begin, size_t end)> &query)
+{
+    size_t chunkSize = chunkSize_ == 0 ? std::max<size_t>(count, 1) : chunkSize_;
+    size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    chunkLatencies_.assign(chunkCount, 0);
+    BundleCommandCommon::ParallelFor(chunkCount, jobs_, [this, count, chunkSize, &query](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        size_t end = std::min(begin + chunkSize, count);
+        auto start = std::chrono::steady_clock::now();
+        query(begin, end);
+        chunkLatencies_[chunk] = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    });
+    APP_LOGD("batch query finished, count: %{public}zu, chunkCount: %{public}zu", count, chunkCount);
+}
+
+BatchLatencyStats BatchQueryEngine::GetLatencyStats() const
+{
+    BatchLatencyStats stats;
+    stats.chunkCount = chunkLatencies_.size();
+    if (chunkLatencies_.empty()) {
+        return stats;
+    }
+    std::vector<int64_t> sortedLatencies = chunkLatencies_;
+    std::sort(sortedLatencies.begin(), sortedLatencies.end());
+    stats.p50Us = GetPercentile(sortedLatencies, PERCENT_50);
+    stats.p90Us = GetPercentile(sortedLatencies, PERCENT_90);
+    stats.p99Us = GetPercentile(sortedLatencies, PERCENT_99);
+    stats.maxUs = sortedLatencies.back();
+    return stats;
+}
+
+std::string BatchQueryEngine::FormatLatencyStats(const BatchLatencyStats &stats)
+{
+    std::string msg = "chunk count: " + std::to_string(stats.chunkCount);
+    msg.append(", chunk latency(us) p50: ").append(std::to_string(stats.p50Us));
+    msg.append(", p90: ").append(std::to_string(stats.p90Us));
+    msg.append(", p99: ").append(std::to_string(stats.p99Us));
+    msg.append(", max: ").append(std::to_string(stats.maxUs)).append("\n");
+    return msg;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
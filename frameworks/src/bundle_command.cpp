@@ -14,12 +14,26 @@
  */
 #include "bundle_command.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <dirent.h>
+#include <fstream>
 #include <future>
 #include <getopt.h>
+#include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "app_log_wrapper.h"
 #include "appexecfwk_errors.h"
@@ -28,6 +42,9 @@
 #include "bundle_mgr_client.h"
 #include "bundle_mgr_proxy.h"
 #include "clean_cache_callback_host.h"
+#include "command_trace.h"
+#include "completion.h"
+#include "hap_verifier.h"
 #include "json_serializer.h"
 #include "nlohmann/json.hpp"
 #include "parameter.h"
@@ -47,6 +64,10 @@ const std::string BUNDLE_NAME_EMPTY = "";
 const std::string OVERLAY_MODULE_INFOS = "overlayModuleInfos";
 const std::string OVERLAY_BUNDLE_INFOS = "overlayBundleInfos";
 const std::string OVERLAY_MODULE_INFO = "overlayModuleInfo";
+const std::string OVERLAY_GRAPH_USER_ID = "userId";
+const std::string OVERLAY_GRAPH_BUNDLE_COUNT = "bundleCount";
+const std::string OVERLAY_GRAPH_MODULES = "overlayModules";
+const std::string OVERLAY_GRAPH_BUNDLES = "overlayBundles";
 const std::string SHARED_BUNDLE_INFO = "sharedBundleInfo";
 const std::string DEPENDENCIES = "dependencies";
 const char* IS_ROOT_MODE_PARAM = "const.debuggable";
@@ -62,8 +83,29 @@ const int32_t MAX_ARGUEMENTS_NUMBER = 3;
 const int32_t MAX_OVERLAY_ARGUEMENTS_NUMBER = 8;
 const int32_t MINIMUM_WAITTING_TIME = 180; // 3 mins
 const int32_t MAXIMUM_WAITTING_TIME = 600; // 10 mins
+const int32_t MAX_PARALLEL_NUMBER = 16;
+const int32_t DEFAULT_UNINSTALL_PARALLEL_NUMBER = 4;
+const int32_t DEFAULT_CLEAN_PARALLEL_NUMBER = 4;
+// the app size comes first in the bundle stats, a clean leaves it as it is
+const size_t BUNDLE_STATS_CLEANABLE_BEGIN_INDEX = 1;
+// the paged list of bm dump -a is written page by page as the pages are filled
+const size_t DUMP_PAGE_SIZE = 64;
+const int32_t DUMP_LABEL_PARALLEL_NUMBER = 8;
+const int32_t DUMP_OVERLAY_PARALLEL_NUMBER = 8;
+const int32_t MILLISECONDS_PER_SECOND = 1000;
+const std::string HAP_FILE_SUFFIX = ".hap";
+const std::string HSP_FILE_SUFFIX = ".hsp";
+const int32_t RESOLVE_BUNDLE_PATH_JOBS = 8;
 const int32_t INITIAL_SANDBOX_APP_INDEX = 3000;
 
+const std::string BATCH_COMMAND = "batch";
+const std::string BATCH_STDIN_PATH = "-";
+const std::string STRING_ERROR_PREFIX = "error:";
+const std::string OPERATION_INSTALL = "install";
+const std::string OPERATION_UNINSTALL = "uninstall";
+std::mutex g_progressOutputMutex;
+const char BATCH_COMMENT_PREFIX = '#';
+
 class DeathRecipientGuard {
 public:
     DeathRecipientGuard(const sptr<IRemoteObject> &object, const sptr<IRemoteObject::DeathRecipient> &recipient)
@@ -89,6 +131,100 @@ private:
     sptr<IRemoteObject::DeathRecipient> recipient_;
 };
 
+// one death recipient for all the receivers of a batch, it finishes every receiver if the service dies
+class BatchDeathRecipient : public IRemoteObject::DeathRecipient {
+public:
+    void AddStatusReceiver(const sptr<StatusReceiverImpl> &statusReceiver)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (isDied_) {
+            statusReceiver->OnFinished(IStatusReceiver::ERR_FAILED_SERVICE_DIED, "");
+            return;
+        }
+        statusReceivers_.emplace_back(statusReceiver);
+    }
+
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        APP_LOGE("bundle installer died, finish %{public}zu receivers", statusReceivers_.size());
+        isDied_ = true;
+        for (const auto &statusReceiver : statusReceivers_) {
+            statusReceiver->OnFinished(IStatusReceiver::ERR_FAILED_SERVICE_DIED, "");
+        }
+        statusReceivers_.clear();
+    }
+
+private:
+    std::mutex mutex_;
+    bool isDied_ = false;
+    std::vector<sptr<StatusReceiverImpl>> statusReceivers_;
+};
+
+// append the bundle names separated by commas in order, skipping the empty and the repeated ones
+void AppendBundleNames(const std::string &names, std::vector<std::string> &bundleNames,
+    std::unordered_set<std::string> &nameSet)
+{
+    std::stringstream nameStream(names);
+    std::string name;
+    while (std::getline(nameStream, name, ',')) {
+        if (!name.empty() && nameSet.insert(name).second) {
+            bundleNames.emplace_back(name);
+        }
+    }
+}
+
+// one bundle name per line, blanks, empty lines and lines starting with '#' are ignored
+void ReadBundleNames(std::istream &input, std::vector<std::string> &bundleNames,
+    std::unordered_set<std::string> &nameSet)
+{
+    std::string line;
+    while (std::getline(input, line)) {
+        line.erase(std::remove_if(line.begin(), line.end(),
+            [](unsigned char ch) { return std::isspace(ch) != 0; }), line.end());
+        if (line.empty() || line[0] == BATCH_COMMENT_PREFIX) {
+            continue;
+        }
+        AppendBundleNames(line, bundleNames, nameSet);
+    }
+}
+
+// split a line of batch script by blank, the content in quotes is kept as one argument
+std::vector<std::string> SplitBatchLine(const std::string &line)
+{
+    std::vector<std::string> args;
+    std::string arg;
+    bool hasArg = false;
+    char quote = '\0';
+    for (char ch : line) {
+        if (quote != '\0') {
+            if (ch == quote) {
+                quote = '\0';
+            } else {
+                arg.push_back(ch);
+            }
+            continue;
+        }
+        if (ch == '"' || ch == '\'') {
+            quote = ch;
+            hasArg = true;
+        } else if (std::isspace(static_cast<unsigned char>(ch))) {
+            if (hasArg) {
+                args.emplace_back(std::move(arg));
+                arg.clear();
+                hasArg = false;
+            }
+        } else {
+            arg.push_back(ch);
+            hasArg = true;
+        }
+    }
+    if (hasArg) {
+        args.emplace_back(std::move(arg));
+    }
+    return args;
+}
+
 const std::string SHORT_OPTIONS_COMPILE = "hm:r:";
 const struct option LONG_OPTIONS_COMPILE[] = {
     {"help", no_argument, nullptr, 'h'},
@@ -140,6 +276,17 @@ const struct option LONG_OPTIONS[] = {
     {"app-index", required_argument, nullptr, 'i'},
     {"grant-permission", no_argument, nullptr, 'g'},
     {"variant-bundle", no_argument, nullptr, 'v'},
+    {"parallel", required_argument, nullptr, 'P'},
+    {"progress", no_argument, nullptr, 'R'},
+    {"verify", no_argument, nullptr, 'V'},
+    {"force", no_argument, nullptr, 'F'},
+    {nullptr, 0, nullptr, 0},
+};
+
+const std::string BATCH_SHORT_OPTIONS = "hf:";
+const struct option BATCH_LONG_OPTIONS[] = {
+    {"help", no_argument, nullptr, 'h'},
+    {"file", required_argument, nullptr, 'f'},
     {nullptr, 0, nullptr, 0},
 };
 
@@ -151,6 +298,8 @@ const struct option CLEAN_LONG_OPTIONS[] = {
     {"data", no_argument, nullptr, 'd'},
     {"user-id", required_argument, nullptr, 'u'},
     {"app-index", required_argument, nullptr, 'i'},
+    {"all-third-party", no_argument, nullptr, 'A'},
+    {"parallel", required_argument, nullptr, 'P'},
     {nullptr, 0, nullptr, 0},
 };
 
@@ -163,6 +312,9 @@ const struct option UNINSTALL_LONG_OPTIONS[] = {
     {"keep-data", no_argument, nullptr, 'k'},
     {"version", required_argument, nullptr, 'v'},
     {"shared", no_argument, nullptr, 's'},
+    {"progress", no_argument, nullptr, 'R'},
+    {"from-file", required_argument, nullptr, 'F'},
+    {"parallel", required_argument, nullptr, 'P'},
     {nullptr, 0, nullptr, 0},
 };
 
@@ -177,6 +329,8 @@ const struct option LONG_OPTIONS_DUMP[] = {
     {"device-id", required_argument, nullptr, 'd'},
     {"debug-bundle", no_argument, nullptr, 'g'},
     {"label", no_argument, nullptr, 'l'},
+    {"offset", required_argument, nullptr, 'O'},
+    {"limit", required_argument, nullptr, 'L'},
     {nullptr, 0, nullptr, 0},
 };
 
@@ -187,9 +341,10 @@ const struct option LONG_OPTIONS_GET[] = {
     {nullptr, 0, nullptr, 0},
 };
 
-const std::string SHORT_OPTIONS_OVERLAY = "hb:m:t:u:";
+const std::string SHORT_OPTIONS_OVERLAY = "hab:m:t:u:";
 const struct option LONG_OPTIONS_OVERLAY[] = {
     {"help", no_argument, nullptr, 'h'},
+    {"all", no_argument, nullptr, 'a'},
     {"bundle-name", required_argument, nullptr, 'b'},
     {"module-name", required_argument, nullptr, 'm'},
     {"target-module-name", required_argument, nullptr, 't'},
@@ -221,39 +376,92 @@ const struct option LONG_OPTIONS_DUMP_SHARED[] = {
     {"all", no_argument, nullptr, 'a'},
     {nullptr, 0, nullptr, 0},
 };
+
+// the real path with the symbolic links resolved like bms does, a path which can not be resolved is kept as it is
+// so that bms reports it
+std::string ResolveBundlePath(const std::string &path)
+{
+    std::string realPath;
+    return PathToRealPath(path, realPath) ? realPath : path;
+}
+
+// list the haps and hsps directly under a directory like bms does, a symbolic link to a file is listed by the real
+// path of the file, nothing is listed for a file or an empty directory
+void ExpandBundleDir(const std::string &path, std::vector<std::string> &bundleFilePaths)
+{
+    struct stat pathStat;
+    if (stat(path.c_str(), &pathStat) != 0 || !S_ISDIR(pathStat.st_mode)) {
+        return;
+    }
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        APP_LOGW("open dir %{private}s failed", path.c_str());
+        return;
+    }
+    std::string prefix = path.back() == '/' ? path : path + "/";
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string fileName = entry->d_name;
+        if (entry->d_type == DT_DIR ||
+            !(EndsWith(fileName, HAP_FILE_SUFFIX) || EndsWith(fileName, HSP_FILE_SUFFIX))) {
+            continue;
+        }
+        std::string filePath = prefix + fileName;
+        struct stat fileStat;
+        if (stat(filePath.c_str(), &fileStat) == 0 && S_ISDIR(fileStat.st_mode)) {
+            continue;
+        }
+        bundleFilePaths.emplace_back(ResolveBundlePath(filePath));
+    }
+    closedir(dir);
+    // readdir order depends on the file system, sort to keep the install order stable
+    std::sort(bundleFilePaths.begin(), bundleFilePaths.end());
+}
+
+// the overlay queries fail with these codes for a bundle which is not an overlay bundle or not a target, such a
+// bundle has no edge in the overlay graph
+bool IsNoOverlayEdge(ErrCode ret)
+{
+    return ret == ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_MISSING_OVERLAY_BUNDLE ||
+        ret == ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NON_OVERLAY_BUNDLE ||
+        ret == ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NO_OVERLAY_MODULE_INFO ||
+        ret == ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NO_OVERLAY_BUNDLE_INFO ||
+        ret == ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_TARGET_BUNDLE_IS_OVERLAY_BUNDLE;
+}
 }  // namespace
 
 class CleanCacheCallbackImpl : public CleanCacheCallbackHost {
 public:
-    CleanCacheCallbackImpl() : signal_(std::make_shared<std::promise<bool>>())
+    CleanCacheCallbackImpl()
     {}
     ~CleanCacheCallbackImpl() override
     {}
     void OnCleanCacheFinished(bool error) override;
     bool GetResultCode();
+    const CompletionSignal &GetCompletion() const;
 private:
-    std::shared_ptr<std::promise<bool>> signal_;
+    Completion<bool> result_;
     DISALLOW_COPY_AND_MOVE(CleanCacheCallbackImpl);
 };
 
 void CleanCacheCallbackImpl::OnCleanCacheFinished(bool error)
 {
-    if (signal_ != nullptr) {
-        signal_->set_value(error);
-    }
+    result_.SetValue(error);
 }
 
 bool CleanCacheCallbackImpl::GetResultCode()
 {
-    if (signal_ != nullptr) {
-        auto future = signal_->get_future();
-        std::chrono::milliseconds span(MAX_WAITING_TIME);
-        if (future.wait_for(span) == std::future_status::timeout) {
-            return false;
-        }
-        return future.get();
+    bool result = false;
+    if (result_.Wait(Deadline::After(std::chrono::milliseconds(MAX_WAITING_TIME)), result) !=
+        CompletionSignal::WaitResult::READY) {
+        return false;
     }
-    return false;
+    return result;
+}
+
+const CompletionSignal &CleanCacheCallbackImpl::GetCompletion() const
+{
+    return result_;
 }
 
 std::map<int32_t, int32_t> BundleManagerShellCommand::errCodeMap_ = {
@@ -295,6 +503,7 @@ ErrCode BundleManagerShellCommand::CreateCommandMap()
     commandMap_ = {
         {"help", [this] { return this->RunAsHelpCommand(); } },
         {"install", [this] { return this->RunAsInstallCommand(); } },
+        {"batch", [this] { return this->RunAsBatchCommand(); } },
         {"uninstall", [this] { return this->RunAsUninstallCommand(); } },
         {"install-plugin", [this] { return this->RunAsInstallPluginCommand(); } },
         {"uninstall-plugin", [this] { return this->RunAsUninstallPluginCommand(); } },
@@ -333,7 +542,9 @@ ErrCode BundleManagerShellCommand::Init()
         bundleMgrProxy_ = BundleCommandCommon::GetBundleMgrProxy();
         if (bundleMgrProxy_) {
             if (bundleInstallerProxy_ == nullptr) {
-                bundleInstallerProxy_ = bundleMgrProxy_->GetBundleInstaller();
+                bundleInstallerProxy_ = TracedCall("IBundleMgr::GetBundleInstaller", TraceCategory::PROXY, [&]() {
+                    return bundleMgrProxy_->GetBundleInstaller();
+                });
             }
         }
     }
@@ -377,7 +588,9 @@ bool BundleManagerShellCommand::IsInstallOption(int index) const
         argList_[index - INDEX_OFFSET] == "-s" || argList_[index - INDEX_OFFSET] == "--shared-bundle-dir-path" ||
         argList_[index - INDEX_OFFSET] == "-d" || argList_[index - INDEX_OFFSET] == "--downgrade" ||
         argList_[index - INDEX_OFFSET] == "-g" || argList_[index - INDEX_OFFSET] == "--add-permission" ||
-        argList_[index - INDEX_OFFSET] == "-v" || argList_[index - INDEX_OFFSET] == "--variant-bundle") {
+        argList_[index - INDEX_OFFSET] == "-v" || argList_[index - INDEX_OFFSET] == "--variant-bundle" ||
+        argList_[index - INDEX_OFFSET] == "--parallel" || argList_[index - INDEX_OFFSET] == "--progress" ||
+        argList_[index - INDEX_OFFSET] == "--verify" || argList_[index - INDEX_OFFSET] == "--force") {
         return true;
     }
     return false;
@@ -626,7 +839,12 @@ ErrCode BundleManagerShellCommand::RunAsInstallCommand()
     std::string warning;
     bool isDowngrade = false;
     bool grantPermission = false;
+    int32_t parallelNum = 0;
+    bool isVerify = false;
+    bool isForce = false;
     AppCategory appCategory = AppCategory::APP_CATEGORY_UNSPECIFIED;
+    showProgress_ = false;
+    CommandTraceSpan parseSpan("bm install options", TraceCategory::PARSE);
     while (true) {
         counter++;
         int32_t option = getopt_long(argc_, argv_, SHORT_OPTIONS.c_str(), LONG_OPTIONS, nullptr);
@@ -674,6 +892,13 @@ ErrCode BundleManagerShellCommand::RunAsInstallCommand()
                     result = OHOS::ERR_INVALID_VALUE;
                     break;
                 }
+                case 'P': {
+                    // 'bm install --parallel' with no argument: bm install --parallel
+                    APP_LOGD("'bm install --parallel' with no argument.");
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
                 default: {
                     // 'bm install' with an unknown option: bm install -x
                     // 'bm install' with an unknown option: bm install -xxx
@@ -725,7 +950,7 @@ ErrCode BundleManagerShellCommand::RunAsInstallCommand()
                 }
                 if (userId != Constants::DEFAULT_USERID && !BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -767,12 +992,41 @@ ErrCode BundleManagerShellCommand::RunAsInstallCommand()
                 APP_LOGI("appCategory set to APP_CATEGORY_DIFF_PACKAGE");
                 break;
             }
+            case 'P': {
+                // 'bm install -p <bundle-file-path> <bundle-file-path> --parallel <parallel-number>'
+                APP_LOGD("'bm install %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+                if (!OHOS::StrToInt(optarg, parallelNum) || parallelNum < 1 || parallelNum > MAX_PARALLEL_NUMBER) {
+                    APP_LOGE("bm install with error parallel number %{private}s", optarg);
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                break;
+            }
+            case 'R': {
+                // 'bm install -p <bundle-file-path> --progress'
+                APP_LOGD("'bm install %{public}s'", argv_[optind - 1]);
+                showProgress_ = true;
+                break;
+            }
+            case 'V': {
+                // 'bm install -p <bundle-file-path> --verify'
+                APP_LOGD("'bm install %{public}s'", argv_[optind - 1]);
+                isVerify = true;
+                break;
+            }
+            case 'F': {
+                // 'bm install -p <bundle-file-path> --force'
+                APP_LOGD("'bm install %{public}s'", argv_[optind - 1]);
+                isForce = true;
+                break;
+            }
             default: {
                 result = OHOS::ERR_INVALID_VALUE;
                 break;
             }
         }
     }
+    parseSpan.End();
 
     for (; index < argc_ && index >= INDEX_OFFSET; ++index) {
         if (IsInstallOption(index)) {
@@ -833,7 +1087,47 @@ ErrCode BundleManagerShellCommand::RunAsInstallCommand()
             installParam.parameters[BMS_PARA_INSTALL_GRANT_PERMISSION] = "true";
         }
         std::string resultMsg;
+        if (isVerify && !VerifyInstallFiles(bundlePath, installParam, parallelNum > 0, resultMsg)) {
+            resultReceiver_ = STRING_INSTALL_BUNDLE_NG + "\n" + resultMsg;
+            return OHOS::ERR_INVALID_VALUE;
+        }
+        if (parallelNum > 0) {
+            int32_t installResult = ParallelInstallOperation(bundlePath, installParam, waittingTime,
+                parallelNum, resultMsg);
+            if (installResult == OHOS::ERR_OK) {
+                resultReceiver_ = STRING_INSTALL_BUNDLE_OK + "\n";
+            } else {
+                resultReceiver_ = STRING_INSTALL_BUNDLE_PARTIAL_NG + "\n";
+                resultReceiver_.append(GetMessageFromCode(installResult));
+            }
+            resultReceiver_.append(resultMsg);
+            if (!warning.empty()) {
+                resultReceiver_ = warning + resultReceiver_;
+            }
+            APP_LOGI("end");
+            return result;
+        }
+        bool isSkipUnchanged = !isForce && sharedBundleDirPaths.empty() &&
+            ContentHashCache::IsSkipUnchangedEnabled();
+        ContentHashCache hashCache;
+        std::vector<std::string> absPaths;
+        std::vector<ContentHashEntry> fileEntries;
+        if (isSkipUnchanged) {
+            hashCache.Load();
+            GetAbsPaths(bundlePath, absPaths, true);
+            if (IsInstallUnchanged(absPaths, userId, hashCache, fileEntries)) {
+                int64_t avoidedSize = std::accumulate(fileEntries.begin(), fileEntries.end(), static_cast<int64_t>(0),
+                    [](int64_t sum, const ContentHashEntry &entry) { return sum + entry.size; });
+                resultReceiver_ = warning + STRING_INSTALL_BUNDLE_OK + "\n" +
+                    ContentHashCache::FormatAvoidedSize(fileEntries.size(), avoidedSize);
+                APP_LOGI("end");
+                return result;
+            }
+        }
         int32_t installResult = InstallOperation(bundlePath, installParam, waittingTime, resultMsg);
+        if (isSkipUnchanged && installResult == OHOS::ERR_OK) {
+            RecordInstalledFiles(absPaths, userId, fileEntries, hashCache);
+        }
         if (installResult == OHOS::ERR_OK) {
             resultReceiver_ = STRING_INSTALL_BUNDLE_OK + "\n";
             if (!resultMsg.empty() && resultMsg[0] != '[') {
@@ -863,7 +1157,8 @@ ErrCode BundleManagerShellCommand::GetBundlePath(const std::string& param,
     if (param == "-r" || param == "--replace" || param == "-p" ||
         param == "--bundle-path" || param == "-u" || param == "--user-id" ||
         param == "-w" || param == "--waitting-time" || param == "-v" ||
-        param == "--variant-bundle") {
+        param == "--variant-bundle" || param == "--parallel" || param == "--progress" || param == "--verify" ||
+        param == "--force") {
         return OHOS::ERR_INVALID_VALUE;
     }
     bundlePaths.emplace_back(param);
@@ -884,12 +1179,173 @@ ErrCode BundleManagerShellCommand::GetPluginPath(const std::string& param,
     return OHOS::ERR_OK;
 }
 
+ErrCode BundleManagerShellCommand::RunAsBatchCommand()
+{
+    APP_LOGI("begin to RunAsBatchCommand");
+    int result = OHOS::ERR_OK;
+    std::string scriptPath = BATCH_STDIN_PATH;
+    int32_t option;
+    while ((option = getopt_long(argc_, argv_, BATCH_SHORT_OPTIONS.c_str(), BATCH_LONG_OPTIONS, nullptr)) != -1) {
+        if (optind < 0 || optind > argc_) {
+            return OHOS::ERR_INVALID_VALUE;
+        }
+        if (option == '?') {
+            if (optopt == 'f') {
+                // 'bm batch -f' with no argument: bm batch -f
+                // 'bm batch --file' with no argument: bm batch --file
+                APP_LOGD("'bm batch -f' with no argument.");
+                resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+            } else {
+                // 'bm batch' with an unknown option: bm batch -x
+                std::string unknownOption = "";
+                std::string unknownOptionMsg = GetUnknownOptionMsg(unknownOption);
+                APP_LOGD("'bm batch' with an unknown option.");
+                resultReceiver_.append(unknownOptionMsg);
+            }
+            result = OHOS::ERR_INVALID_VALUE;
+            break;
+        }
+        if (option == 'f') {
+            // 'bm batch -f <script-path>'
+            // 'bm batch --file <script-path>'
+            APP_LOGD("'bm batch %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+            scriptPath = optarg;
+            continue;
+        }
+        // 'bm batch -h'
+        // 'bm batch --help'
+        result = OHOS::ERR_INVALID_VALUE;
+        break;
+    }
+
+    if (result != OHOS::ERR_OK) {
+        resultReceiver_.append(HELP_MSG_BATCH);
+        return result;
+    }
+    if (scriptPath == BATCH_STDIN_PATH) {
+        ExecBatchScript(std::cin, std::cout);
+    } else {
+        std::ifstream script(scriptPath);
+        if (!script.is_open()) {
+            APP_LOGE("open batch script %{private}s failed", scriptPath.c_str());
+            resultReceiver_.append(STRING_BATCH_OPEN_FILE_NG + "\n");
+            return OHOS::ERR_OK;
+        }
+        ExecBatchScript(script, std::cout);
+    }
+    APP_LOGI("end to RunAsBatchCommand");
+    return result;
+}
+
+void BundleManagerShellCommand::ExecBatchScript(std::istream &input, std::ostream &output)
+{
+    auto beginTime = std::chrono::steady_clock::now();
+    int32_t lineNumber = 0;
+    int32_t successCount = 0;
+    int32_t failCount = 0;
+    // the lines share the resolved user as long as no user switch happens in between
+    bool isUserSwitchSubscribed = BundleCommandCommon::SubscribeUserSwitch();
+    std::string line;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        std::vector<std::string> args = SplitBatchLine(line);
+        if (args.empty() || args[0][0] == BATCH_COMMENT_PREFIX) {
+            continue;
+        }
+        if (args[0] == TOOL_NAME) {
+            args.erase(args.begin());
+        }
+        if (args.empty()) {
+            continue;
+        }
+        if (!isUserSwitchSubscribed) {
+            BundleCommandCommon::InvalidateUserCache();
+        }
+        auto lineBeginTime = std::chrono::steady_clock::now();
+        std::string lineResult;
+        bool isSuccess = ExecBatchLine(args, lineResult);
+        int64_t costTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - lineBeginTime).count();
+        isSuccess ? ++successCount : ++failCount;
+        // every command is framed and flushed at once, so that the caller can consume the result as a stream
+        output << "[batch] line " << lineNumber << ": " << line << "\n" << lineResult;
+        if (!lineResult.empty() && lineResult.back() != '\n') {
+            output << "\n";
+        }
+        output << "[batch] line " << lineNumber << " result: " << (isSuccess ? "success" : "failed")
+            << ", time: " << costTime << "ms\n";
+        output.flush();
+    }
+    BundleCommandCommon::UnsubscribeUserSwitch();
+    int64_t wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - beginTime).count();
+    resultReceiver_.append("batch command count: " + std::to_string(successCount + failCount) + "\n");
+    resultReceiver_.append("success count: " + std::to_string(successCount) + "\n");
+    resultReceiver_.append("fail count: " + std::to_string(failCount) + "\n");
+    resultReceiver_.append("wall time: " + std::to_string(wallTime) + "ms\n");
+}
+
+bool BundleManagerShellCommand::ExecBatchLine(const std::vector<std::string> &args, std::string &result)
+{
+    if (args[0] == BATCH_COMMAND) {
+        result = STRING_BATCH_NESTED_NG + "\n";
+        return false;
+    }
+    // the proxies and maps are kept, only the arguments of the command are replaced
+    std::vector<std::string> lineArgs;
+    lineArgs.reserve(args.size() + 1);
+    lineArgs.emplace_back(TOOL_NAME);
+    lineArgs.insert(lineArgs.end(), args.begin(), args.end());
+    std::vector<char *> lineArgv;
+    lineArgv.reserve(lineArgs.size() + 1);
+    for (auto &arg : lineArgs) {
+        lineArgv.emplace_back(const_cast<char *>(arg.c_str()));
+    }
+    lineArgv.emplace_back(nullptr);
+
+    int batchArgc = argc_;
+    char **batchArgv = argv_;
+    std::string batchCmd = cmd_;
+    std::vector<std::string> batchArgList = std::move(argList_);
+    std::string batchResult = std::move(resultReceiver_);
+    // the output of a line is framed by the batch, so it is collected rather than written to the sink
+    std::shared_ptr<OutputSink> batchOutputSink = std::move(outputSink_);
+
+    argc_ = static_cast<int>(lineArgs.size());
+    argv_ = lineArgv.data();
+    cmd_ = args[0];
+    argList_.assign(args.begin() + 1, args.end());
+    resultReceiver_.clear();
+    optind = 0;
+
+    int ret = OHOS::ERR_OK;
+    auto respond = commandMap_.find(cmd_);
+    if (respond == commandMap_.end() || respond->second == nullptr) {
+        resultReceiver_.append(GetCommandErrorMsg());
+        ret = OHOS::ERR_INVALID_VALUE;
+    } else {
+        ret = respond->second();
+    }
+    result = std::move(resultReceiver_);
+
+    argc_ = batchArgc;
+    argv_ = batchArgv;
+    cmd_ = std::move(batchCmd);
+    argList_ = std::move(batchArgList);
+    resultReceiver_ = std::move(batchResult);
+    outputSink_ = std::move(batchOutputSink);
+    return ret == OHOS::ERR_OK && result.compare(0, STRING_ERROR_PREFIX.size(), STRING_ERROR_PREFIX) != 0;
+}
+
 ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
 {
     APP_LOGI("begin to RunAsUninstallCommand");
     int result = OHOS::ERR_OK;
     int counter = 0;
     std::string bundleName = "";
+    std::vector<std::string> bundleNames;
+    std::unordered_set<std::string> bundleNameSet;
+    std::string bundleNameFile = "";
     std::string moduleName = "";
     const int32_t currentUser = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
     std::string warning;
@@ -897,6 +1353,9 @@ ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
     bool isKeepData = false;
     bool isShared = false;
     int32_t versionCode = Constants::ALL_VERSIONCODE;
+    int32_t parallelNum = 0;
+    showProgress_ = false;
+    CommandTraceSpan parseSpan("bm uninstall options", TraceCategory::PARSE);
     while (true) {
         counter++;
         int32_t option = getopt_long(argc_, argv_, UNINSTALL_OPTIONS.c_str(), UNINSTALL_LONG_OPTIONS, nullptr);
@@ -962,6 +1421,15 @@ ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
                     result = OHOS::ERR_INVALID_VALUE;
                     break;
                 }
+                case 'F':
+                case 'P': {
+                    // 'bm uninstall --from-file' with no argument: bm uninstall --from-file
+                    // 'bm uninstall --parallel' with no argument: bm uninstall --parallel
+                    APP_LOGD("'bm uninstall --from-file' or '--parallel' with no argument.");
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
                 default: {
                     // 'bm uninstall' with an unknown option: bm uninstall -x
                     // 'bm uninstall' with an unknown option: bm uninstall -xxx
@@ -987,8 +1455,25 @@ ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
             case 'n': {
                 // 'bm uninstall -n xxx'
                 // 'bm uninstall --bundle-name xxx'
+                // 'bm uninstall -n xxx,yyy -n zzz'
                 APP_LOGD("'bm uninstall %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
-                bundleName = optarg;
+                AppendBundleNames(optarg, bundleNames, bundleNameSet);
+                break;
+            }
+            case 'F': {
+                // 'bm uninstall --from-file <file-path>'
+                APP_LOGD("'bm uninstall %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+                bundleNameFile = optarg;
+                break;
+            }
+            case 'P': {
+                // 'bm uninstall -n xxx -n yyy --parallel <parallel-number>'
+                APP_LOGD("'bm uninstall %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+                if (!OHOS::StrToInt(optarg, parallelNum) || parallelNum < 1 || parallelNum > MAX_PARALLEL_NUMBER) {
+                    APP_LOGE("bm uninstall with error parallel number %{private}s", optarg);
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
                 break;
             }
             case 'm': {
@@ -1025,6 +1510,12 @@ ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
                 isShared = true;
                 break;
             }
+            case 'R': {
+                // 'bm uninstall -n <bundleName> --progress'
+                APP_LOGD("'bm uninstall %{public}s'", argv_[optind - 1]);
+                showProgress_ = true;
+                break;
+            }
             case 'v': {
                 APP_LOGD("'bm uninstall %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
                 if (!OHOS::StrToInt(optarg, versionCode) || versionCode < 0) {
@@ -1040,7 +1531,28 @@ ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
             }
         }
     }
+    parseSpan.End();
 
+    if (result == OHOS::ERR_OK && !bundleNameFile.empty()) {
+        if (bundleNameFile == BATCH_STDIN_PATH) {
+            ReadBundleNames(std::cin, bundleNames, bundleNameSet);
+        } else {
+            std::ifstream nameFile(bundleNameFile);
+            if (!nameFile.is_open()) {
+                APP_LOGE("open bundle name file %{private}s failed", bundleNameFile.c_str());
+                resultReceiver_.append(STRING_UNINSTALL_OPEN_FILE_NG + "\n");
+                return OHOS::ERR_INVALID_VALUE;
+            }
+            ReadBundleNames(nameFile, bundleNames, bundleNameSet);
+        }
+    }
+    if (result == OHOS::ERR_OK && bundleNames.size() > 1 && (!moduleName.empty() || isShared)) {
+        resultReceiver_.append(STRING_UNINSTALL_MULTIPLE_BUNDLES_NG + "\n");
+        result = OHOS::ERR_INVALID_VALUE;
+    }
+    if (!bundleNames.empty()) {
+        bundleName = bundleNames.front();
+    }
     if (result == OHOS::ERR_OK) {
         if (resultReceiver_ == "" && bundleName.size() == 0) {
             // 'bm uninstall ...' with no bundle name option
@@ -1071,6 +1583,23 @@ ErrCode BundleManagerShellCommand::RunAsUninstallCommand()
         installParam.userId = userId;
         installParam.isKeepData = isKeepData;
         installParam.parameters.emplace(Constants::VERIFY_UNINSTALL_RULE_KEY, Constants::VERIFY_UNINSTALL_RULE_VALUE);
+        if (bundleNames.size() > 1 || parallelNum > 0) {
+            std::string resultMsg;
+            int32_t uninstallResult = ParallelUninstallOperation(bundleNames, installParam,
+                parallelNum > 0 ? parallelNum : DEFAULT_UNINSTALL_PARALLEL_NUMBER, resultMsg);
+            if (uninstallResult == OHOS::ERR_OK) {
+                resultReceiver_ = STRING_UNINSTALL_BUNDLE_OK + "\n";
+            } else {
+                resultReceiver_ = STRING_UNINSTALL_BUNDLE_PARTIAL_NG + "\n";
+                resultReceiver_.append(GetMessageFromCode(uninstallResult));
+            }
+            resultReceiver_.append(resultMsg);
+            if (!warning.empty()) {
+                resultReceiver_ = warning + resultReceiver_;
+            }
+            APP_LOGI("end");
+            return result;
+        }
         int32_t uninstallResult = UninstallOperation(bundleName, moduleName, installParam);
         if (uninstallResult == OHOS::ERR_OK) {
             resultReceiver_ = STRING_UNINSTALL_BUNDLE_OK + "\n";
@@ -1098,10 +1627,14 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
     bool bundleDumpShortcut = false;
     bool bundleDumpDistributedBundleInfo = false;
     bool bundleDumpLabel = false;
+    bool isPaged = false;
+    int32_t offset = 0;
+    int32_t limit = 0;
     std::string deviceId = "";
     const int32_t currentUser = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
     int32_t userId = currentUser;
     std::string warning;
+    CommandTraceSpan parseSpan("bm dump options", TraceCategory::PARSE);
     while (true) {
         counter++;
         int32_t option = getopt_long(argc_, argv_, SHORT_OPTIONS_DUMP.c_str(), LONG_OPTIONS_DUMP, nullptr);
@@ -1148,6 +1681,14 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
                     result = OHOS::ERR_INVALID_VALUE;
                     break;
                 }
+                case 'O':
+                case 'L': {
+                    // 'bm dump -a --offset' or 'bm dump -a --limit' with no argument
+                    APP_LOGD("'bm dump --offset' or '--limit' with no argument.");
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
                 default: {
                     // 'bm dump' with an unknown option: bm dump -x
                     // 'bm dump' with an unknown option: bm dump -xxx
@@ -1216,7 +1757,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
                 }
                 if (userId != Constants::DEFAULT_USERID && !BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -1228,12 +1769,35 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
                 bundleDumpDistributedBundleInfo = true;
                 break;
             }
+            case 'O': {
+                // 'bm dump -a --offset <offset>'
+                APP_LOGD("'bm dump %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+                if (!OHOS::StrToInt(optarg, offset) || offset < 0) {
+                    APP_LOGE("bm dump with error offset %{private}s", optarg);
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                isPaged = true;
+                break;
+            }
+            case 'L': {
+                // 'bm dump -a --limit <limit>'
+                APP_LOGD("'bm dump %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+                if (!OHOS::StrToInt(optarg, limit) || limit < 1) {
+                    APP_LOGE("bm dump with error limit %{private}s", optarg);
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                isPaged = true;
+                break;
+            }
             default: {
                 result = OHOS::ERR_INVALID_VALUE;
                 break;
             }
         }
     }
+    parseSpan.End();
     if (result == OHOS::ERR_OK) {
         if ((resultReceiver_ == "") && bundleDumpShortcut && (bundleName.size() == 0)) {
             // 'bm dump -s ...' with no bundle name option
@@ -1247,9 +1811,20 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
             resultReceiver_.append(HELP_MSG_NO_BUNDLE_NAME_OPTION + "\n");
             result = OHOS::ERR_INVALID_VALUE;
         }
+        if ((resultReceiver_ == "") && isPaged && !bundleDumpAll) {
+            // 'bm dump --offset ...' without -a, only the list of all bundles is paged
+            APP_LOGD("'bm dump' pages without -a option.");
+            resultReceiver_.append(HELP_MSG_DUMP_PAGE_WITHOUT_ALL + "\n");
+            result = OHOS::ERR_INVALID_VALUE;
+        }
     }
     if (result != OHOS::ERR_OK) {
         resultReceiver_.append(HELP_MSG_DUMP);
+    } else if (bundleDumpAll && isPaged) {
+        if (!warning.empty()) {
+            WriteOutput(std::move(warning));
+        }
+        result = DumpBundleListByPage(userId, bundleDumpLabel, offset, limit);
     } else {
         std::string dumpResults = "";
         APP_LOGD("dumpResults: %{public}s", dumpResults.c_str());
@@ -1271,10 +1846,11 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
         if (dumpResults.empty() || (dumpResults == "")) {
             dumpResults = HELP_MSG_DUMP_FAILED + "\n";
         }
-        resultReceiver_.append(dumpResults);
         if (!warning.empty()) {
-            resultReceiver_ = warning + resultReceiver_;
+            WriteOutput(std::move(warning));
         }
+        // the dump of all bundles may be large, hand it to the sink without copying it again
+        WriteOutput(std::move(dumpResults));
     }
     APP_LOGI("end");
     return result;
@@ -1298,7 +1874,11 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
     int32_t appIndex = 0;
     bool cleanCache = false;
     bool cleanData = false;
-    std::string bundleName = "";
+    bool isAllThirdParty = false;
+    int32_t parallelNum = 0;
+    std::vector<std::string> bundleNames;
+    std::unordered_set<std::string> bundleNameSet;
+    CommandTraceSpan parseSpan("bm clean options", TraceCategory::PARSE);
     while (true) {
         counter++;
         int32_t option = getopt_long(argc_, argv_, CLEAN_SHORT_OPTIONS.c_str(), CLEAN_LONG_OPTIONS, nullptr);
@@ -1347,6 +1927,13 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
                     result = OHOS::ERR_INVALID_VALUE;
                     break;
                 }
+                case 'P': {
+                    // 'bm clean --parallel' with no argument: bm clean --parallel
+                    APP_LOGD("'bm clean --parallel' with no argument.");
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
                 default: {
                     // 'bm clean' with an unknown option: bm clear -x
                     // 'bm clean' with an unknown option: bm clear -xxx
@@ -1372,22 +1959,39 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
             case 'n': {
                 // 'bm clean -n xxx'
                 // 'bm clean --bundle-name xxx'
+                // 'bm clean -n xxx,yyy -n zzz'
                 APP_LOGD("'bm clean %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
-                bundleName = optarg;
+                AppendBundleNames(optarg, bundleNames, bundleNameSet);
+                break;
+            }
+            case 'A': {
+                // 'bm clean -d --all-third-party'
+                APP_LOGD("'bm clean %{public}s'", argv_[optind - 1]);
+                isAllThirdParty = true;
+                break;
+            }
+            case 'P': {
+                // 'bm clean -n xxx -n yyy -d --parallel <parallel-number>'
+                APP_LOGD("'bm clean %{public}s %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT], optarg);
+                if (!OHOS::StrToInt(optarg, parallelNum) || parallelNum < 1 || parallelNum > MAX_PARALLEL_NUMBER) {
+                    APP_LOGE("bm clean with error parallel number %{private}s", optarg);
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
                 break;
             }
             case 'c': {
                 // 'bm clean -c'
                 // 'bm clean --cache'
                 APP_LOGD("'bm clean %{public}s'", argv_[optind - OFFSET_REQUIRED_ARGUMENT]);
-                cleanCache = cleanData ? false : true;
+                cleanCache = true;
                 break;
             }
             case 'd': {
                 // 'bm clean -d'
                 // 'bm clean --data'
                 APP_LOGD("'bm clean %{public}s '", argv_[optind - OFFSET_REQUIRED_ARGUMENT]);
-                cleanData = cleanCache ? false : true;
+                cleanData = true;
                 break;
             }
             case 'u': {
@@ -1401,7 +2005,7 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
                 }
                 if (!BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -1419,9 +2023,10 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
             }
         }
     }
+    parseSpan.End();
 
     if (result == OHOS::ERR_OK) {
-        if (resultReceiver_ == "" && bundleName.size() == 0) {
+        if (resultReceiver_ == "" && bundleNames.empty() && !isAllThirdParty) {
             // 'bm clean ...' with no bundle name option
             APP_LOGD("'bm clean' with no bundle name option.");
             resultReceiver_.append(HELP_MSG_NO_BUNDLE_NAME_OPTION + "\n");
@@ -1436,7 +2041,30 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
 
     if (result != OHOS::ERR_OK) {
         resultReceiver_.append(HELP_MSG_CLEAN);
+    } else if (bundleNames.size() != 1 || isAllThirdParty || parallelNum > 0) {
+        // bm clean -n xxx,yyy -c
+        // bm clean --all-third-party -d
+        if (isAllThirdParty && !GetThirdPartyBundleNames(userId, bundleNames)) {
+            resultReceiver_ = STRING_CLEAN_GET_BUNDLES_NG + "\n";
+            return OHOS::ERR_INVALID_VALUE;
+        }
+        std::string resultMsg;
+        int32_t cleanResult = ParallelCleanOperation(bundleNames, userId, appIndex, cleanCache, cleanData,
+            parallelNum > 0 ? parallelNum : DEFAULT_CLEAN_PARALLEL_NUMBER, resultMsg);
+        if (cleanResult == OHOS::ERR_OK) {
+            resultReceiver_ = cleanCache ? STRING_CLEAN_CACHE_BUNDLE_OK + "\n" : "";
+            if (cleanData) {
+                resultReceiver_.append(STRING_CLEAN_DATA_BUNDLE_OK + "\n");
+            }
+        } else {
+            resultReceiver_ = STRING_CLEAN_BUNDLE_PARTIAL_NG + "\n";
+        }
+        resultReceiver_.append(resultMsg);
+        if (!warning.empty()) {
+            resultReceiver_ = warning + resultReceiver_;
+        }
     } else {
+        const std::string &bundleName = bundleNames.front();
         // bm clean -c
         if (cleanCache) {
             if (CleanBundleCacheFilesOperation(bundleName, userId, appIndex)) {
@@ -1447,7 +2075,8 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
         }
         // bm clean -d
         if (cleanData) {
-            if (CleanBundleDataFilesOperation(bundleName, userId, appIndex)) {
+            AppMgrClient appMgrClient;
+            if (CleanBundleDataFilesOperation(bundleName, userId, appIndex, appMgrClient)) {
                 resultReceiver_.append(STRING_CLEAN_DATA_BUNDLE_OK + "\n");
             } else {
                 resultReceiver_.append(STRING_CLEAN_DATA_BUNDLE_NG + "\n");
@@ -1569,7 +2198,7 @@ ErrCode BundleManagerShellCommand::RunAsEnableCommand()
                 }
                 if (!BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -1715,7 +2344,7 @@ ErrCode BundleManagerShellCommand::RunAsDisableCommand()
                 }
                 if (!BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -1837,17 +2466,22 @@ ErrCode BundleManagerShellCommand::RunAsQuickFixCommand()
             std::string argKey = argv_[++index];
             index++;
             if (argKey == "-f" || argKey == "--file-path") {
-                std::vector<std::string> quickFixFiles;
+                // every further -f starts the patch set of another bundle
+                std::vector<std::vector<std::string>> patchSets(1);
                 bool isDebug = false;
                 std::string targetPath;
                 bool isReplace = false;
+                bool isForce = false;
                 // collect value of multi file-path.
                 for (; index < argc_ && index >= INDEX_OFFSET; ++index) {
                     if (argList_[index - INDEX_OFFSET] == "-q" || argList_[index - INDEX_OFFSET] == "--query" ||
                         argList_[index - INDEX_OFFSET] == "-b" || argList_[index - INDEX_OFFSET] == "--bundle-name" ||
-                        argList_[index - INDEX_OFFSET] == "-a" || argList_[index - INDEX_OFFSET] == "--apply" ||
-                        argList_[index - INDEX_OFFSET] == "-f" || argList_[index - INDEX_OFFSET] == "--file-path") {
+                        argList_[index - INDEX_OFFSET] == "-a" || argList_[index - INDEX_OFFSET] == "--apply") {
                         break;
+                    } else if (argList_[index - INDEX_OFFSET] == "-f" ||
+                        argList_[index - INDEX_OFFSET] == "--file-path") {
+                        patchSets.emplace_back();
+                        continue;
                     } else if (argList_[index - INDEX_OFFSET] == "-d" || argList_[index - INDEX_OFFSET] == "--debug") {
                         isDebug = true;
                         continue;
@@ -1862,19 +2496,22 @@ ErrCode BundleManagerShellCommand::RunAsQuickFixCommand()
                         argList_[index - INDEX_OFFSET] == "--overwrite") {
                         isReplace = true;
                         continue;
+                    } else if (argList_[index - INDEX_OFFSET] == ContentHashCache::FORCE_OPTION) {
+                        isForce = true;
+                        continue;
                     }
-                    quickFixFiles.emplace_back(argList_[index - INDEX_OFFSET]);
+                    patchSets.back().emplace_back(argList_[index - INDEX_OFFSET]);
                 }
                 APP_LOGI("end");
                 if (!targetPath.empty()) {
                     std::shared_ptr<QuickFixResult> deployRes = nullptr;
                     int32_t result = OHOS::ERR_OK;
-                    result = DeployQuickFixDisable(quickFixFiles, deployRes, isDebug, targetPath);
+                    result = DeployQuickFixDisable(patchSets.front(), deployRes, isDebug, targetPath);
                     resultReceiver_.append((result == OHOS::ERR_OK) ? "apply quickfix succeed.\n" :
                         ("apply quickfix failed with errno: " + std::to_string(result) + ".\n"));
                     return result;
                 }
-                return QuickFixCommand::ApplyQuickFix(quickFixFiles, resultReceiver_, isDebug, isReplace);
+                return QuickFixCommand::ApplyQuickFixes(patchSets, resultReceiver_, isDebug, isReplace, isForce);
             }
         } else if ((opt == "-q") || (opt == "--query")) {
             if (index >= argc_ - INDEX_OFFSET) {
@@ -1938,6 +2575,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpOverlay()
     std::string bundleName = "";
     std::string moduleName = "";
     std::string targetModuleName = "";
+    bool isAll = false;
     while (true) {
         counter++;
         if (argc_ > MAX_OVERLAY_ARGUEMENTS_NUMBER) {
@@ -2018,6 +2656,12 @@ ErrCode BundleManagerShellCommand::RunAsDumpOverlay()
                 result = OHOS::ERR_INVALID_VALUE;
                 break;
             }
+            case 'a': {
+                // 'bm dump-overlay -a'
+                // 'bm dump-overlay --all'
+                isAll = true;
+                break;
+            }
             case 'b': {
                 // 'bm dump-overlay -b <bundle-name>'
                 // 'bm dump-overlay --bundle-name <bundle-name>'
@@ -2045,7 +2689,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpOverlay()
                 }
                 if (!BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -2055,12 +2699,16 @@ ErrCode BundleManagerShellCommand::RunAsDumpOverlay()
             }
         }
     }
+    if (isAll && (!bundleName.empty() || !moduleName.empty() || !targetModuleName.empty())) {
+        APP_LOGD("'bm dump-overlay -a' with -b, -m or -t.");
+        result = OHOS::ERR_INVALID_VALUE;
+    }
     if (result != OHOS::ERR_OK) {
         resultReceiver_.append(HELP_MSG_OVERLAY);
         return result;
     }
 #ifdef BUNDLE_FRAMEWORK_OVERLAY_INSTALLATION
-    auto res = DumpOverlayInfo(bundleName, moduleName, targetModuleName, userId);
+    auto res = isAll ? DumpOverlayGraph(userId) : DumpOverlayInfo(bundleName, moduleName, targetModuleName, userId);
     if (res.empty()) {
         resultReceiver_.append(STRING_DUMP_OVERLAY_NG + "\n");
     } else {
@@ -2180,7 +2828,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpTargetOverlay()
                 }
                 if (!BundleCommandCommon::IsUserForeground(userId)) {
                     warning = GetWaringString(currentUser, userId);
-                    userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+                    userId = currentUser;
                 }
                 break;
             }
@@ -2229,7 +2877,9 @@ std::string BundleManagerShellCommand::CopyAp(const std::string &bundleName, boo
 {
     std::string result = "";
     std::vector<std::string> copyApResults;
-    ErrCode ret = bundleMgrProxy_->CopyAp(bundleName, isAllBundle, copyApResults);
+    ErrCode ret = TracedCall("IBundleMgr::CopyAp", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->CopyAp(bundleName, isAllBundle, copyApResults);
+    });
     if (ret != ERR_OK) {
         APP_LOGE("failed to copy ap! ret = = %{public}d.", ret);
         return "";
@@ -2246,7 +2896,9 @@ std::string BundleManagerShellCommand::CompileProcessAot(
     const std::string &bundleName, const std::string &compileMode, bool isAllBundle) const
 {
     std::vector<std::string> compileResults;
-    ErrCode CompileRet = bundleMgrProxy_->CompileProcessAOT(bundleName, compileMode, isAllBundle, compileResults);
+    ErrCode CompileRet = TracedCall("IBundleMgr::CompileProcessAOT", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->CompileProcessAOT(bundleName, compileMode, isAllBundle, compileResults);
+    });
     if (CompileRet != ERR_OK) {
         std::string result = "error: compile AOT:\n";
         for (const auto &compileResult : compileResults) {
@@ -2262,7 +2914,9 @@ std::string BundleManagerShellCommand::CompileProcessAot(
 std::string BundleManagerShellCommand::CompileReset(const std::string &bundleName, bool isAllBundle) const
 {
     std::string ResetResults;
-    ErrCode ResetRet = bundleMgrProxy_->CompileReset(bundleName, isAllBundle);
+    ErrCode ResetRet = TracedCall("IBundleMgr::CompileReset", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->CompileReset(bundleName, isAllBundle);
+    });
     if (ResetRet == ERR_APPEXECFWK_PARCEL_ERROR) {
         APP_LOGE("failed to reset AOT.");
         return ResetResults;
@@ -2274,19 +2928,120 @@ std::string BundleManagerShellCommand::CompileReset(const std::string &bundleNam
 std::string BundleManagerShellCommand::DumpBundleList(int32_t userId) const
 {
     std::string dumpResults;
-    bool dumpRet = bundleMgrProxy_->DumpInfos(
-        DumpFlag::DUMP_BUNDLE_LIST, BUNDLE_NAME_EMPTY, userId, dumpResults);
+    bool dumpRet = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->DumpInfos(DumpFlag::DUMP_BUNDLE_LIST, BUNDLE_NAME_EMPTY, userId, dumpResults);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump bundle list.");
     }
     return dumpResults;
 }
 
+bool BundleManagerShellCommand::GetSortedBundleInfos(int32_t userId, std::vector<BundleInfo> &bundleInfos) const
+{
+    // the default flag leaves out the abilities, permissions and extensions, only the names are needed
+    bool ret = TracedCall("IBundleMgr::GetBundleInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetBundleInfos(
+            static_cast<int32_t>(BundleFlag::GET_BUNDLE_DEFAULT), bundleInfos, userId);
+    });
+    if (!ret) {
+        APP_LOGE("get bundle infos of user %{public}d failed", userId);
+        return false;
+    }
+    // the offset of a page refers to the same bundle on every call only in a stable order
+    std::sort(bundleInfos.begin(), bundleInfos.end(), [](const BundleInfo &left, const BundleInfo &right) {
+        return left.name != right.name ? left.name < right.name : left.appIndex < right.appIndex;
+    });
+    return true;
+}
+
+bool BundleManagerShellCommand::GetSortedBundleNames(int32_t userId, std::vector<std::string> &bundleNames) const
+{
+    std::vector<BundleInfo> bundleInfos;
+    if (!GetSortedBundleInfos(userId, bundleInfos)) {
+        return false;
+    }
+    bundleNames.reserve(bundleInfos.size());
+    for (const auto &bundleInfo : bundleInfos) {
+        if (bundleNames.empty() || bundleNames.back() != bundleInfo.name) {
+            bundleNames.emplace_back(bundleInfo.name);
+        }
+    }
+    return true;
+}
+
+ErrCode BundleManagerShellCommand::DumpBundleListByPage(int32_t userId, bool withLabel, int32_t offset,
+    int32_t limit)
+{
+    std::vector<BundleInfo> bundleInfos;
+    if (!GetSortedBundleInfos(userId, bundleInfos)) {
+        WriteOutput(HELP_MSG_DUMP_FAILED + "\n");
+        return OHOS::ERR_INVALID_VALUE;
+    }
+    size_t begin = std::min(static_cast<size_t>(offset), bundleInfos.size());
+    size_t end = bundleInfos.size();
+    if (limit > 0) {
+        end = std::min(begin + static_cast<size_t>(limit), end);
+    }
+    if (!withLabel) {
+        WriteOutput("ID: " + std::to_string(userId) + ":\n");
+    }
+    size_t pageBegin = begin;
+    std::string lastLabel;
+    while (pageBegin < end && !CompletionSignal::IsCancelRequested()) {
+        size_t pageEnd = std::min(pageBegin + DUMP_PAGE_SIZE, end);
+        std::string page;
+        if (withLabel) {
+            // the clones follow their bundle in the sorted list and share its label, which is queried once
+            std::vector<size_t> labelIndexes;
+            for (size_t i = pageBegin; i < pageEnd; ++i) {
+                if (i == begin || bundleInfos[i].name != bundleInfos[i - 1].name) {
+                    labelIndexes.emplace_back(i);
+                }
+            }
+            std::vector<std::string> labels(labelIndexes.size());
+            BundleCommandCommon::ParallelFor(labels.size(), DUMP_LABEL_PARALLEL_NUMBER,
+                [this, &bundleInfos, &labels, &labelIndexes, userId](size_t index) {
+                    labels[index] = DumpBundleLabel(bundleInfos[labelIndexes[index]].name, userId);
+                });
+            size_t labelIndex = 0;
+            for (size_t i = pageBegin; i < pageEnd; ++i) {
+                if (labelIndex < labelIndexes.size() && labelIndexes[labelIndex] == i) {
+                    lastLabel = std::move(labels[labelIndex++]);
+                }
+                if (bundleInfos[i].appIndex == 0 || lastLabel.empty()) {
+                    page.append(lastLabel);
+                    continue;
+                }
+                page.append(lastLabel, 0, lastLabel.back() == '\n' ? lastLabel.size() - 1 : lastLabel.size());
+                page.append(" (appIndex: ").append(std::to_string(bundleInfos[i].appIndex)).append(")\n");
+            }
+        } else {
+            for (size_t i = pageBegin; i < pageEnd; ++i) {
+                page.append("\t").append(bundleInfos[i].name);
+                if (bundleInfos[i].appIndex > 0) {
+                    page.append(" (appIndex: ").append(std::to_string(bundleInfos[i].appIndex)).append(")");
+                }
+                page.append("\n");
+            }
+        }
+        WriteOutput(std::move(page));
+        pageBegin = pageEnd;
+    }
+    std::string summary = "bundle count: " + std::to_string(bundleInfos.size()) + "\n";
+    if (pageBegin < bundleInfos.size()) {
+        summary.append("next offset: " + std::to_string(pageBegin) + "\n");
+    }
+    WriteOutput(std::move(summary));
+    return OHOS::ERR_OK;
+}
+
 std::string BundleManagerShellCommand::DumpBundleLabel(const std::string &bundleName, int32_t userId) const
 {
     std::string dumpResults;
-    bool dumpRet = bundleMgrProxy_->DumpInfos(
-        DumpFlag::DUMP_BUNDLE_LABEL, bundleName, userId, dumpResults);
+    bool dumpRet = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->DumpInfos(DumpFlag::DUMP_BUNDLE_LABEL, bundleName, userId, dumpResults);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump bundle label.");
     }
@@ -2296,8 +3051,9 @@ std::string BundleManagerShellCommand::DumpBundleLabel(const std::string &bundle
 std::string BundleManagerShellCommand::DumpAllLabel(int32_t userId) const
 {
     std::string dumpResults;
-    bool dumpRet = bundleMgrProxy_->DumpInfos(
-        DumpFlag::DUMP_LABEL_LIST, BUNDLE_NAME_EMPTY, userId, dumpResults);
+    bool dumpRet = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->DumpInfos(DumpFlag::DUMP_LABEL_LIST, BUNDLE_NAME_EMPTY, userId, dumpResults);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump bundle label list.");
     }
@@ -2307,8 +3063,9 @@ std::string BundleManagerShellCommand::DumpAllLabel(int32_t userId) const
 std::string BundleManagerShellCommand::DumpDebugBundleList(int32_t userId) const
 {
     std::string dumpResults;
-    bool dumpRet = bundleMgrProxy_->DumpInfos(
-        DumpFlag::DUMP_DEBUG_BUNDLE_LIST, BUNDLE_NAME_EMPTY, userId, dumpResults);
+    bool dumpRet = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->DumpInfos(DumpFlag::DUMP_DEBUG_BUNDLE_LIST, BUNDLE_NAME_EMPTY, userId, dumpResults);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump debug bundle list.");
     }
@@ -2318,8 +3075,9 @@ std::string BundleManagerShellCommand::DumpDebugBundleList(int32_t userId) const
 std::string BundleManagerShellCommand::DumpBundleInfo(const std::string &bundleName, int32_t userId) const
 {
     std::string dumpResults;
-    bool dumpRet = bundleMgrProxy_->DumpInfos(
-        DumpFlag::DUMP_BUNDLE_INFO, bundleName, userId, dumpResults);
+    bool dumpRet = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->DumpInfos(DumpFlag::DUMP_BUNDLE_INFO, bundleName, userId, dumpResults);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump bundle info.");
     }
@@ -2329,8 +3087,9 @@ std::string BundleManagerShellCommand::DumpBundleInfo(const std::string &bundleN
 std::string BundleManagerShellCommand::DumpShortcutInfos(const std::string &bundleName, int32_t userId) const
 {
     std::string dumpResults;
-    bool dumpRet = bundleMgrProxy_->DumpInfos(
-        DumpFlag::DUMP_SHORTCUT_INFO, bundleName, userId, dumpResults);
+    bool dumpRet = TracedCall("IBundleMgr::DumpInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->DumpInfos(DumpFlag::DUMP_SHORTCUT_INFO, bundleName, userId, dumpResults);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump shortcut infos.");
     }
@@ -2342,7 +3101,9 @@ std::string BundleManagerShellCommand::DumpDistributedBundleInfo(
 {
     std::string dumpResults = "";
     DistributedBundleInfo distributedBundleInfo;
-    bool dumpRet = bundleMgrProxy_->GetDistributedBundleInfo(deviceId, bundleName, distributedBundleInfo);
+    bool dumpRet = TracedCall("IBundleMgr::GetDistributedBundleInfo", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetDistributedBundleInfo(deviceId, bundleName, distributedBundleInfo);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump distributed bundleInfo.");
     } else {
@@ -2362,7 +3123,9 @@ std::string BundleManagerShellCommand::DumpDependentModuleNames(
         bundleName.c_str(), moduleName.c_str());
     std::string dumpResults = "";
     std::vector<std::string> dependentModuleNames;
-    bool dumpRet = bundleMgrProxy_->GetAllDependentModuleNames(bundleName, moduleName, dependentModuleNames);
+    bool dumpRet = TracedCall("IBundleMgr::GetAllDependentModuleNames", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetAllDependentModuleNames(bundleName, moduleName, dependentModuleNames);
+    });
     if (!dumpRet) {
         APP_LOGE("failed to dump dependent module name.");
     } else {
@@ -2376,36 +3139,71 @@ std::string BundleManagerShellCommand::DumpDependentModuleNames(
     return dumpResults;
 }
 
-void BundleManagerShellCommand::GetAbsPaths(
-    const std::vector<std::string> &paths, std::vector<std::string> &absPaths) const
+void BundleManagerShellCommand::GetAbsPaths(const std::vector<std::string> &paths,
+    std::vector<std::string> &absPaths, bool expandDirs) const
 {
-    std::vector<std::string> realPathVec;
-    for (auto &bundlePath : paths) {
-        std::string absoluteBundlePath = "";
+    std::string currentPath;
+    bool hasRelativePath = std::any_of(paths.begin(), paths.end(),
+        [](const std::string &path) { return !path.empty() && path.front() != '/'; });
+    if (hasRelativePath) {
+        // resolve the current directory once rather than for every relative path
+        char *currentPathPtr = getcwd(nullptr, 0);
+        if (currentPathPtr != nullptr) {
+            currentPath = currentPathPtr;
+            free(currentPathPtr);
+            currentPathPtr = nullptr;
+        } else {
+            APP_LOGE("getcwd failed, errno: %{public}d", errno);
+        }
+    }
+
+    std::vector<std::string> absolutePaths;
+    absolutePaths.reserve(paths.size());
+    for (const auto &bundlePath : paths) {
         if (bundlePath.empty()) {
             continue;
         }
-        if (bundlePath.at(0) == '/') {
-            // absolute path
-            absoluteBundlePath.append(bundlePath);
+        if (bundlePath.front() == '/' || currentPath.empty()) {
+            // a relative path without the current directory is left to bms to report
+            absolutePaths.emplace_back(bundlePath);
         } else {
-            // relative path
-            char *currentPathPtr = getcwd(nullptr, 0);
-
-            if (currentPathPtr != nullptr) {
-                absoluteBundlePath.append(currentPathPtr);
-                absoluteBundlePath.append('/' + bundlePath);
-
-                free(currentPathPtr);
-                currentPathPtr = nullptr;
-            }
+            absolutePaths.emplace_back(currentPath.back() == '/' ? currentPath + bundlePath :
+                currentPath + "/" + bundlePath);
         }
-        realPathVec.emplace_back(absoluteBundlePath);
     }
 
-    for (const auto &path : realPathVec) {
-        if (std::find(absPaths.begin(), absPaths.end(), path) == absPaths.end()) {
-            absPaths.emplace_back(path);
+    // "." and ".." are resolved after the symbolic links before them, so only realpath resolves them right
+    std::vector<std::string> realPaths(absolutePaths.size());
+    std::vector<std::vector<std::string>> expandedPaths(absolutePaths.size());
+    BundleCommandCommon::ParallelFor(absolutePaths.size(), RESOLVE_BUNDLE_PATH_JOBS,
+        [&absolutePaths, &realPaths, &expandedPaths, expandDirs](size_t index) {
+            realPaths[index] = ResolveBundlePath(absolutePaths[index]);
+            if (expandDirs) {
+                ExpandBundleDir(realPaths[index], expandedPaths[index]);
+            }
+        });
+
+    size_t pathCount = absPaths.size();
+    for (const auto &bundleFilePaths : expandedPaths) {
+        pathCount += bundleFilePaths.empty() ? 1 : bundleFilePaths.size();
+    }
+    // the set refers to the strings of absPaths, which is reserved up front and never reallocated
+    absPaths.reserve(pathCount);
+    std::unordered_set<std::string_view> absPathSet(absPaths.begin(), absPaths.end());
+    auto appendPath = [&absPaths, &absPathSet](std::string &&path) {
+        if (absPathSet.find(path) == absPathSet.end()) {
+            absPaths.emplace_back(std::move(path));
+            absPathSet.emplace(absPaths.back());
+        }
+    };
+    for (size_t i = 0; i < realPaths.size(); ++i) {
+        if (expandedPaths[i].empty()) {
+            // a file, or a directory without haps and hsps which is left to bms
+            appendPath(std::move(realPaths[i]));
+            continue;
+        }
+        for (auto &bundleFilePath : expandedPaths[i]) {
+            appendPath(std::move(bundleFilePath));
         }
     }
 }
@@ -2414,12 +3212,18 @@ int32_t BundleManagerShellCommand::InstallOperation(const std::vector<std::strin
     InstallParam &installParam, int32_t waittingTime, std::string &resultMsg) const
 {
     std::vector<std::string> pathVec;
-    GetAbsPaths(bundlePaths, pathVec);
+    GetAbsPaths(bundlePaths, pathVec, true);
 
     std::vector<std::string> hspPathVec;
-    GetAbsPaths(installParam.sharedBundleDirPaths, hspPathVec);
+    GetAbsPaths(installParam.sharedBundleDirPaths, hspPathVec, true);
     installParam.sharedBundleDirPaths = hspPathVec;
 
+    return StreamInstallOperation(pathVec, installParam, waittingTime, resultMsg);
+}
+
+int32_t BundleManagerShellCommand::StreamInstallOperation(const std::vector<std::string> &absPaths,
+    const InstallParam &installParam, int32_t waittingTime, std::string &resultMsg) const
+{
     sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl(waittingTime));
     if (statusReceiver == nullptr) {
         APP_LOGE("statusReceiver is null");
@@ -2436,11 +3240,17 @@ int32_t BundleManagerShellCommand::InstallOperation(const std::vector<std::strin
         return IStatusReceiver::ERR_UNKNOWN;
     }
     DeathRecipientGuard deathRecipientGuard(bundleInstallerObject, recipient);
-    ErrCode res = bundleInstallerProxy_->StreamInstall(pathVec, installParam, statusReceiver);
+    std::string target = absPaths.empty() ? BUNDLE_NAME_EMPTY : absPaths.front();
+    AttachProgressOutput(statusReceiver, OPERATION_INSTALL, target);
+    ErrCode res = TracedCall("IBundleInstaller::StreamInstall", TraceCategory::IPC, [&]() {
+        return bundleInstallerProxy_->StreamInstall(absPaths, installParam, statusReceiver);
+    });
     APP_LOGD("StreamInstall result is %{public}d", res);
     if (res == ERR_OK) {
         resultMsg = statusReceiver->GetResultMsg();
-        return statusReceiver->GetResultCode();
+        int32_t resultCode = statusReceiver->GetResultCode();
+        PrintOperationLatency(statusReceiver, OPERATION_INSTALL, target, resultCode);
+        return resultCode;
     }
     if (res == ERR_APPEXECFWK_INSTALL_PARAM_ERROR) {
         APP_LOGE("install param error");
@@ -2462,6 +3272,284 @@ int32_t BundleManagerShellCommand::InstallOperation(const std::vector<std::strin
     return res;
 }
 
+std::string BundleManagerShellCommand::GetArchiveBundleName(const std::string &path) const
+{
+    std::string archivePath = path;
+    struct stat pathStat;
+    if (stat(path.c_str(), &pathStat) == 0 && S_ISDIR(pathStat.st_mode)) {
+        // a directory holds the haps or hsps of one bundle, the first one decides the bundle name
+        archivePath.clear();
+        DIR *dir = opendir(path.c_str());
+        if (dir == nullptr) {
+            APP_LOGW("open dir %{private}s failed", path.c_str());
+            return "";
+        }
+        struct dirent *entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr) {
+            std::string fileName = entry->d_name;
+            if (EndsWith(fileName, HAP_FILE_SUFFIX) || EndsWith(fileName, HSP_FILE_SUFFIX)) {
+                archivePath = path + "/" + fileName;
+                break;
+            }
+        }
+        closedir(dir);
+        if (archivePath.empty()) {
+            return "";
+        }
+    }
+    BundleInfo bundleInfo;
+    bool ret = TracedCall("IBundleMgr::GetBundleArchiveInfo", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetBundleArchiveInfo(archivePath, BundleFlag::GET_BUNDLE_DEFAULT, bundleInfo);
+    });
+    if (!ret) {
+        APP_LOGW("get archive info of %{private}s failed", archivePath.c_str());
+        return "";
+    }
+    return bundleInfo.name;
+}
+
+void BundleManagerShellCommand::GroupBundlePathsByBundleName(const std::vector<std::string> &absPaths,
+    int32_t parallelNum, std::vector<BundleInstallGroup> &groups) const
+{
+    std::vector<std::string> bundleNames(absPaths.size());
+    BundleCommandCommon::ParallelFor(absPaths.size(), parallelNum, [this, &absPaths, &bundleNames](size_t index) {
+        bundleNames[index] = GetArchiveBundleName(absPaths[index]);
+    });
+
+    // keep the order in which the bundles first appear on the command line
+    std::unordered_map<std::string, size_t> groupIndexes;
+    for (size_t i = 0; i < absPaths.size(); ++i) {
+        // a path whose bundle name is unknown is installed on its own and let bms report the error
+        std::string groupKey = bundleNames[i].empty() ? absPaths[i] : bundleNames[i];
+        auto iter = groupIndexes.find(groupKey);
+        if (iter == groupIndexes.end()) {
+            groupIndexes.emplace(groupKey, groups.size());
+            BundleInstallGroup group;
+            group.bundleName = groupKey;
+            group.bundlePaths.emplace_back(absPaths[i]);
+            groups.emplace_back(std::move(group));
+            continue;
+        }
+        groups[iter->second].bundlePaths.emplace_back(absPaths[i]);
+    }
+}
+
+bool BundleManagerShellCommand::VerifyInstallFiles(const std::vector<std::string> &bundlePaths,
+    const InstallParam &installParam, bool allowManyBundles, std::string &resultMsg) const
+{
+    int32_t jobs = static_cast<int32_t>(std::min<uint32_t>(std::thread::hardware_concurrency(),
+        static_cast<uint32_t>(MAX_PARALLEL_NUMBER)));
+    std::vector<std::string> absPaths;
+    GetAbsPaths(bundlePaths, absPaths, true);
+    std::vector<HapVerifyResult> results;
+    if (!HapVerifier::VerifyArchives(absPaths, jobs, allowManyBundles, results, resultMsg)) {
+        APP_LOGE("verify bundle files failed");
+        return false;
+    }
+    // inter-application hsp files may come from many bundles
+    std::vector<std::string> hspPaths;
+    GetAbsPaths(installParam.sharedBundleDirPaths, hspPaths, true);
+    std::vector<HapVerifyResult> hspResults;
+    if (!HapVerifier::VerifyArchives(hspPaths, jobs, true, hspResults, resultMsg)) {
+        APP_LOGE("verify shared bundle files failed");
+        return false;
+    }
+    APP_LOGI("verify %{public}zu bundle files ok", absPaths.size() + hspPaths.size());
+    return true;
+}
+
+bool BundleManagerShellCommand::IsInstallUnchanged(const std::vector<std::string> &absPaths, int32_t userId,
+    const ContentHashCache &hashCache, std::vector<ContentHashEntry> &fileEntries) const
+{
+    fileEntries.assign(absPaths.size(), ContentHashEntry());
+    if (absPaths.empty() || bundleMgrProxy_ == nullptr) {
+        return false;
+    }
+    std::vector<char> hashResults(absPaths.size(), 0);
+    int32_t jobs = static_cast<int32_t>(std::min<uint32_t>(std::thread::hardware_concurrency(),
+        static_cast<uint32_t>(MAX_PARALLEL_NUMBER)));
+    BundleCommandCommon::ParallelFor(absPaths.size(), jobs, [&absPaths, &fileEntries, &hashResults](size_t index) {
+        hashResults[index] = ContentHashCache::ComputeHash(absPaths[index], fileEntries[index].hash,
+            fileEntries[index].size) ? 1 : 0;
+    });
+    // one query per bundle, the haps of one install mostly belong to one bundle
+    std::unordered_map<std::string, BundleInfo> bundleInfos;
+    for (size_t index = 0; index < absPaths.size(); ++index) {
+        ContentHashEntry cachedEntry;
+        if (hashResults[index] == 0 ||
+            !hashCache.Lookup(absPaths[index], fileEntries[index].hash, fileEntries[index].size, cachedEntry)) {
+            return false;
+        }
+        auto iter = bundleInfos.find(cachedEntry.bundleName);
+        if (iter == bundleInfos.end()) {
+            BundleInfo bundleInfo;
+            bool ret = TracedCall("IBundleMgr::GetBundleInfo", TraceCategory::IPC, [&]() {
+                return bundleMgrProxy_->GetBundleInfo(cachedEntry.bundleName, BundleFlag::GET_BUNDLE_DEFAULT,
+                    bundleInfo, userId);
+            });
+            if (!ret) {
+                return false;
+            }
+            iter = bundleInfos.emplace(cachedEntry.bundleName, bundleInfo).first;
+        }
+        const BundleInfo &bundleInfo = iter->second;
+        // any install in between, even of the same version, changes the update time of the bundle
+        if (static_cast<int64_t>(bundleInfo.versionCode) != cachedEntry.versionCode ||
+            std::to_string(bundleInfo.updateTime) != cachedEntry.buildId ||
+            std::find(bundleInfo.moduleNames.begin(), bundleInfo.moduleNames.end(), cachedEntry.moduleName) ==
+            bundleInfo.moduleNames.end()) {
+            APP_LOGI("module %{public}s of %{public}s changed", cachedEntry.moduleName.c_str(),
+                cachedEntry.bundleName.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void BundleManagerShellCommand::RecordInstalledFiles(const std::vector<std::string> &absPaths, int32_t userId,
+    std::vector<ContentHashEntry> &fileEntries, ContentHashCache &hashCache) const
+{
+    std::unordered_map<std::string, std::string> buildIds;
+    for (size_t index = 0; index < absPaths.size() && index < fileEntries.size(); ++index) {
+        ContentHashEntry &entry = fileEntries[index];
+        HapVerifyResult verifyResult;
+        if (entry.hash.empty() || !HapVerifier::VerifyArchive(absPaths[index], verifyResult)) {
+            // an app file or a file which is not parsed locally is always installed
+            continue;
+        }
+        auto iter = buildIds.find(verifyResult.bundleName);
+        if (iter == buildIds.end()) {
+            BundleInfo bundleInfo;
+            bool ret = TracedCall("IBundleMgr::GetBundleInfo", TraceCategory::IPC, [&]() {
+                return bundleMgrProxy_->GetBundleInfo(verifyResult.bundleName, BundleFlag::GET_BUNDLE_DEFAULT,
+                    bundleInfo, userId);
+            });
+            // without the installed build the file can not be recognized later, so it is not recorded
+            iter = buildIds.emplace(verifyResult.bundleName, ret ? std::to_string(bundleInfo.updateTime) : "").first;
+        }
+        if (iter->second.empty()) {
+            continue;
+        }
+        entry.bundleName = verifyResult.bundleName;
+        entry.moduleName = verifyResult.moduleName;
+        entry.versionCode = verifyResult.versionCode;
+        entry.buildId = iter->second;
+        hashCache.Update(absPaths[index], entry);
+    }
+    if (!hashCache.Save()) {
+        APP_LOGW("save content hash cache failed");
+    }
+}
+
+int32_t BundleManagerShellCommand::ParallelInstallOperation(const std::vector<std::string> &bundlePaths,
+    InstallParam &installParam, int32_t waittingTime, int32_t parallelNum, std::string &resultMsg) const
+{
+    auto beginTime = std::chrono::steady_clock::now();
+    std::vector<std::string> pathVec;
+    GetAbsPaths(bundlePaths, pathVec, true);
+    std::vector<std::string> hspPathVec;
+    GetAbsPaths(installParam.sharedBundleDirPaths, hspPathVec, true);
+
+    // inter-application hsps are depended by the bundles, so install them before the others
+    if (!hspPathVec.empty()) {
+        InstallParam sharedInstallParam = installParam;
+        sharedInstallParam.sharedBundleDirPaths = hspPathVec;
+        std::string sharedResultMsg;
+        int32_t sharedResult = StreamInstallOperation({}, sharedInstallParam, waittingTime, sharedResultMsg);
+        if (sharedResult != OHOS::ERR_OK) {
+            APP_LOGE("install shared bundles failed %{public}d", sharedResult);
+            resultMsg.append("shared bundle result: failed\n");
+            if (!sharedResultMsg.empty() && sharedResultMsg[0] != '[') {
+                resultMsg.append(sharedResultMsg + "\n");
+            }
+            return sharedResult;
+        }
+        resultMsg.append("shared bundle result: success\n");
+    }
+    installParam.sharedBundleDirPaths.clear();
+
+    std::vector<BundleInstallGroup> groups;
+    GroupBundlePathsByBundleName(pathVec, parallelNum, groups);
+    BundleCommandCommon::ParallelFor(groups.size(), parallelNum,
+        [this, &groups, &installParam, waittingTime](size_t index) {
+            BundleInstallGroup &group = groups[index];
+            auto groupBeginTime = std::chrono::steady_clock::now();
+            group.resultCode = StreamInstallOperation(group.bundlePaths, installParam, waittingTime,
+                group.resultMsg);
+            group.costTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - groupBeginTime).count();
+            APP_LOGI("install %{public}s result %{public}d", group.bundleName.c_str(), group.resultCode);
+        });
+
+    int32_t result = OHOS::ERR_OK;
+    size_t failCount = 0;
+    for (const auto &group : groups) {
+        resultMsg.append("bundleName: " + group.bundleName);
+        resultMsg.append(", result: " + std::string(group.resultCode == OHOS::ERR_OK ? "success" : "failed"));
+        resultMsg.append(", time: " + std::to_string(group.costTime) + "ms\n");
+        if (group.resultCode == OHOS::ERR_OK) {
+            continue;
+        }
+        ++failCount;
+        if (result == OHOS::ERR_OK) {
+            result = group.resultCode;
+        }
+        resultMsg.append(GetMessageFromCode(group.resultCode));
+        if (!group.resultMsg.empty() && group.resultMsg[0] != '[') {
+            resultMsg.append(group.resultMsg + "\n");
+        }
+    }
+    int64_t wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - beginTime).count();
+    resultMsg.append("bundle count: " + std::to_string(groups.size()) + "\n");
+    resultMsg.append("success count: " + std::to_string(groups.size() - failCount) + "\n");
+    resultMsg.append("fail count: " + std::to_string(failCount) + "\n");
+    resultMsg.append("wall time: " + std::to_string(wallTime) + "ms\n");
+    return result;
+}
+
+void BundleManagerShellCommand::AttachProgressOutput(const sptr<StatusReceiverImpl> &statusReceiver,
+    const std::string &operation, const std::string &target) const
+{
+    if (!showProgress_) {
+        return;
+    }
+    statusReceiver->SetProgressCallback([operation, target](int32_t progress, int64_t elapsedTime) {
+        nlohmann::json event = {
+            {"event", "progress"},
+            {"operation", operation},
+            {"target", target},
+            {"timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()},
+            {"elapsedMs", elapsedTime},
+            {"progress", progress},
+        };
+        // progress arrives on the ipc thread, print it at once rather than with the final result
+        std::lock_guard<std::mutex> lock(g_progressOutputMutex);
+        std::cout << event.dump() << std::endl;
+    });
+}
+
+void BundleManagerShellCommand::PrintOperationLatency(const sptr<StatusReceiverImpl> &statusReceiver,
+    const std::string &operation, const std::string &target, int32_t resultCode) const
+{
+    if (!showProgress_) {
+        return;
+    }
+    nlohmann::json event = {
+        {"event", "finished"},
+        {"operation", operation},
+        {"target", target},
+        {"timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()},
+        {"resultCode", resultCode},
+        {"timeToFirstProgressMs", statusReceiver->GetFirstProgressTime()},
+        {"timeToFinishMs", statusReceiver->GetFinishTime()},
+    };
+    std::lock_guard<std::mutex> lock(g_progressOutputMutex);
+    std::cout << event.dump() << std::endl;
+}
+
 int32_t BundleManagerShellCommand::UninstallOperation(
     const std::string &bundleName, const std::string &moduleName, InstallParam &installParam) const
 {
@@ -2485,13 +3573,139 @@ int32_t BundleManagerShellCommand::UninstallOperation(
         return IStatusReceiver::ERR_UNKNOWN;
     }
     DeathRecipientGuard deathRecipientGuard(bundleInstallerObject, recipient);
-    if (moduleName.size() != 0) {
-        bundleInstallerProxy_->Uninstall(bundleName, moduleName, installParam, statusReceiver);
-    } else {
-        bundleInstallerProxy_->Uninstall(bundleName, installParam, statusReceiver);
+    AttachProgressOutput(statusReceiver, OPERATION_UNINSTALL, bundleName);
+    TracedCall("IBundleInstaller::Uninstall", TraceCategory::IPC, [&]() {
+        if (moduleName.size() != 0) {
+            return bundleInstallerProxy_->Uninstall(bundleName, moduleName, installParam, statusReceiver);
+        }
+        return bundleInstallerProxy_->Uninstall(bundleName, installParam, statusReceiver);
+    });
+
+    int32_t resultCode = statusReceiver->GetResultCode();
+    PrintOperationLatency(statusReceiver, OPERATION_UNINSTALL, bundleName, resultCode);
+    return resultCode;
+}
+
+bool BundleManagerShellCommand::StartUninstallTask(BundleUninstallTask &task,
+    const InstallParam &installParam) const
+{
+    task.isStarted = true;
+    task.statusReceiver = new (std::nothrow) StatusReceiverImpl();
+    if (task.statusReceiver == nullptr) {
+        APP_LOGE("statusReceiver is null");
+        task.resultCode = IStatusReceiver::ERR_UNKNOWN;
+        return false;
+    }
+    AttachProgressOutput(task.statusReceiver, OPERATION_UNINSTALL, task.bundleName);
+    bool ret = TracedCall("IBundleInstaller::Uninstall", TraceCategory::IPC, [&]() {
+        return bundleInstallerProxy_->Uninstall(task.bundleName, installParam, task.statusReceiver);
+    });
+    if (!ret) {
+        APP_LOGE("send uninstall request of %{public}s failed", task.bundleName.c_str());
+        task.resultCode = IStatusReceiver::ERR_UNKNOWN;
+        return false;
+    }
+    return true;
+}
+
+int32_t BundleManagerShellCommand::ParallelUninstallOperation(const std::vector<std::string> &bundleNames,
+    const InstallParam &installParam, int32_t parallelNum, std::string &resultMsg) const
+{
+    auto beginTime = std::chrono::steady_clock::now();
+    auto bundleInstallerObject = bundleInstallerProxy_->AsObject();
+    sptr<BatchDeathRecipient> recipient(new (std::nothrow) BatchDeathRecipient());
+    if (bundleInstallerObject == nullptr || recipient == nullptr) {
+        APP_LOGE("bundleInstallerObject or recipient is null");
+        return IStatusReceiver::ERR_UNKNOWN;
     }
+    DeathRecipientGuard deathRecipientGuard(bundleInstallerObject, recipient);
 
-    return statusReceiver->GetResultCode();
+    std::vector<BundleUninstallTask> tasks(bundleNames.size());
+    for (size_t i = 0; i < bundleNames.size(); ++i) {
+        tasks[i].bundleName = bundleNames[i];
+    }
+    // the uninstall requests are asynchronous, so one thread keeps parallelNum of them in flight
+    size_t nextTask = 0;
+    std::vector<size_t> runningTasks;
+    bool isCanceled = false;
+    while (!isCanceled && (nextTask < tasks.size() || !runningTasks.empty())) {
+        while (runningTasks.size() < static_cast<size_t>(parallelNum) && nextTask < tasks.size()) {
+            BundleUninstallTask &task = tasks[nextTask];
+            if (StartUninstallTask(task, installParam)) {
+                recipient->AddStatusReceiver(task.statusReceiver);
+                runningTasks.emplace_back(nextTask);
+            }
+            ++nextTask;
+        }
+        if (runningTasks.empty()) {
+            continue;
+        }
+        std::vector<const CompletionSignal *> signals;
+        for (size_t index : runningTasks) {
+            signals.emplace_back(&tasks[index].statusReceiver->GetCompletion());
+        }
+        size_t finished = 0;
+        CompletionSignal::WaitResult waitResult = CompletionSignal::WaitAny(signals,
+            Deadline::After(std::chrono::seconds(MINIMUM_WAITTING_TIME)), finished);
+        if (waitResult != CompletionSignal::WaitResult::READY) {
+            // nothing finished in time or the user interrupted, give up the bundles in flight
+            APP_LOGE("wait for uninstall failed %{public}d", static_cast<int32_t>(waitResult));
+            isCanceled = waitResult == CompletionSignal::WaitResult::CANCELED;
+            for (size_t index : runningTasks) {
+                tasks[index].resultCode = isCanceled ?
+                    StatusReceiverImpl::ERR_OPERATION_CANCELED : IStatusReceiver::ERR_OPERATION_TIME_OUT;
+            }
+            runningTasks.clear();
+            continue;
+        }
+        BundleUninstallTask &task = tasks[runningTasks[finished]];
+        task.resultCode = task.statusReceiver->GetResultCode();
+        task.costTime = task.statusReceiver->GetFinishTime();
+        PrintOperationLatency(task.statusReceiver, OPERATION_UNINSTALL, task.bundleName, task.resultCode);
+        APP_LOGI("uninstall %{public}s result %{public}d", task.bundleName.c_str(), task.resultCode);
+        runningTasks.erase(runningTasks.begin() + static_cast<std::ptrdiff_t>(finished));
+    }
+
+    int32_t result = OHOS::ERR_OK;
+    size_t failCount = 0;
+    size_t skipCount = 0;
+    for (const auto &task : tasks) {
+        resultMsg.append("bundleName: " + task.bundleName);
+        if (!task.isStarted) {
+            ++skipCount;
+            resultMsg.append(", result: skipped\n");
+            continue;
+        }
+        resultMsg.append(", result: " + std::string(task.resultCode == OHOS::ERR_OK ? "success" : "failed"));
+        resultMsg.append(", time: " + std::to_string(task.costTime) + "ms\n");
+        if (task.resultCode == OHOS::ERR_OK) {
+            continue;
+        }
+        ++failCount;
+        if (result == OHOS::ERR_OK) {
+            result = task.resultCode;
+        }
+        resultMsg.append(GetMessageFromCode(task.resultCode));
+    }
+    if (skipCount > 0 && result == OHOS::ERR_OK) {
+        // only a cancellation leaves bundles unstarted
+        result = StatusReceiverImpl::ERR_OPERATION_CANCELED;
+    }
+    int64_t wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - beginTime).count();
+    size_t successCount = tasks.size() - failCount - skipCount;
+    std::ostringstream throughput;
+    throughput << std::fixed << std::setprecision(2) <<
+        (wallTime > 0 ? static_cast<double>(successCount) * MILLISECONDS_PER_SECOND / wallTime : 0.0);
+    resultMsg.append("bundle count: " + std::to_string(tasks.size()) + "\n");
+    resultMsg.append("success count: " + std::to_string(successCount) + "\n");
+    resultMsg.append("fail count: " + std::to_string(failCount) + "\n");
+    if (skipCount > 0) {
+        resultMsg.append("skip count: " + std::to_string(skipCount) + "\n");
+    }
+    resultMsg.append("wall time: " + std::to_string(wallTime) + "ms\n");
+    resultMsg.append("throughput: " + throughput.str() + " bundles/s\n");
+    return result;
 }
 
 int32_t BundleManagerShellCommand::UninstallSharedOperation(const UninstallParam &uninstallParam) const
@@ -2513,9 +3727,14 @@ int32_t BundleManagerShellCommand::UninstallSharedOperation(const UninstallParam
         return IStatusReceiver::ERR_UNKNOWN;
     }
     DeathRecipientGuard deathRecipientGuard(bundleInstallerObject, recipient);
-
-    bundleInstallerProxy_->Uninstall(uninstallParam, statusReceiver);
-    return statusReceiver->GetResultCode();
+    AttachProgressOutput(statusReceiver, OPERATION_UNINSTALL, uninstallParam.bundleName);
+
+    TracedCall("IBundleInstaller::Uninstall", TraceCategory::IPC, [&]() {
+        return bundleInstallerProxy_->Uninstall(uninstallParam, statusReceiver);
+    });
+    int32_t resultCode = statusReceiver->GetResultCode();
+    PrintOperationLatency(statusReceiver, OPERATION_UNINSTALL, uninstallParam.bundleName, resultCode);
+    return resultCode;
 }
 
 bool BundleManagerShellCommand::CleanBundleCacheFilesOperation(const std::string &bundleName, int32_t userId,
@@ -2528,7 +3747,9 @@ bool BundleManagerShellCommand::CleanBundleCacheFilesOperation(const std::string
         APP_LOGE("cleanCacheCallBack is null");
         return false;
     }
-    ErrCode cleanRet = bundleMgrProxy_->CleanBundleCacheFiles(bundleName, cleanCacheCallBack, userId, appIndex);
+    ErrCode cleanRet = TracedCall("IBundleMgr::CleanBundleCacheFiles", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->CleanBundleCacheFiles(bundleName, cleanCacheCallBack, userId, appIndex);
+    });
     if (cleanRet == ERR_OK) {
         return cleanCacheCallBack->GetResultCode();
     }
@@ -2537,15 +3758,18 @@ bool BundleManagerShellCommand::CleanBundleCacheFilesOperation(const std::string
 }
 
 bool BundleManagerShellCommand::CleanBundleDataFilesOperation(const std::string &bundleName, int32_t userId,
-    int32_t appIndex) const
+    int32_t appIndex, AppMgrClient &appMgrClient) const
 {
     userId = BundleCommandCommon::GetCurrentUserId(userId);
     APP_LOGD("bundleName: %{public}s, userId:%{public}d, appIndex:%{public}d", bundleName.c_str(), userId, appIndex);
-    auto appMgrClient = std::make_unique<AppMgrClient>();
     APP_LOGI("clear start");
-    ErrCode cleanRetAms = appMgrClient->ClearUpApplicationData(bundleName, appIndex, userId);
+    ErrCode cleanRetAms = TracedCall("AppMgrClient::ClearUpApplicationData", TraceCategory::IPC, [&]() {
+        return appMgrClient.ClearUpApplicationData(bundleName, appIndex, userId);
+    });
     APP_LOGI("clear end");
-    bool cleanRetBms = bundleMgrProxy_->CleanBundleDataFiles(bundleName, userId, appIndex);
+    bool cleanRetBms = TracedCall("IBundleMgr::CleanBundleDataFiles", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->CleanBundleDataFiles(bundleName, userId, appIndex);
+    });
     APP_LOGD("cleanRetAms: %{public}d, cleanRetBms: %{public}d", cleanRetAms, cleanRetBms);
     if ((cleanRetAms == ERR_OK) && cleanRetBms) {
         return true;
@@ -2554,6 +3778,108 @@ bool BundleManagerShellCommand::CleanBundleDataFilesOperation(const std::string
     return false;
 }
 
+bool BundleManagerShellCommand::GetBundleCleanableSize(const std::string &bundleName, int32_t userId,
+    int32_t appIndex, int64_t &size) const
+{
+    std::vector<int64_t> bundleStats;
+    bool ret = TracedCall("IBundleMgr::GetBundleStats", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetBundleStats(bundleName, userId, bundleStats, appIndex);
+    });
+    if (!ret || bundleStats.size() <= BUNDLE_STATS_CLEANABLE_BEGIN_INDEX) {
+        APP_LOGW("get bundle stats of %{public}s failed", bundleName.c_str());
+        return false;
+    }
+    size = std::accumulate(bundleStats.begin() + BUNDLE_STATS_CLEANABLE_BEGIN_INDEX, bundleStats.end(),
+        static_cast<int64_t>(0));
+    return true;
+}
+
+bool BundleManagerShellCommand::GetThirdPartyBundleNames(int32_t userId, std::vector<std::string> &bundleNames) const
+{
+    std::vector<BundleInfo> bundleInfos;
+    bool ret = TracedCall("IBundleMgr::GetBundleInfos", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetBundleInfos(
+            static_cast<int32_t>(BundleFlag::GET_BUNDLE_DEFAULT), bundleInfos, userId);
+    });
+    if (!ret) {
+        APP_LOGE("get bundle infos of user %{public}d failed", userId);
+        return false;
+    }
+    std::vector<std::string> thirdPartyNames;
+    for (const auto &bundleInfo : bundleInfos) {
+        if (!bundleInfo.applicationInfo.isSystemApp) {
+            thirdPartyNames.emplace_back(bundleInfo.name);
+        }
+    }
+    std::sort(thirdPartyNames.begin(), thirdPartyNames.end());
+    std::unordered_set<std::string> nameSet(bundleNames.begin(), bundleNames.end());
+    for (auto &name : thirdPartyNames) {
+        if (nameSet.insert(name).second) {
+            bundleNames.emplace_back(std::move(name));
+        }
+    }
+    APP_LOGI("clean %{public}zu bundles of user %{public}d", bundleNames.size(), userId);
+    return true;
+}
+
+int32_t BundleManagerShellCommand::ParallelCleanOperation(const std::vector<std::string> &bundleNames,
+    int32_t userId, int32_t appIndex, bool cleanCache, bool cleanData, int32_t parallelNum,
+    std::string &resultMsg) const
+{
+    auto beginTime = std::chrono::steady_clock::now();
+    userId = BundleCommandCommon::GetCurrentUserId(userId);
+    // the client connects to the app manager once, the bundles of a worker go through the app manager and the
+    // bundle manager one after another while the other workers keep both services busy
+    AppMgrClient appMgrClient;
+    std::vector<BundleCleanTask> tasks(bundleNames.size());
+    BundleCommandCommon::ParallelFor(tasks.size(), parallelNum,
+        [this, &bundleNames, &tasks, &appMgrClient, userId, appIndex, cleanCache, cleanData](size_t index) {
+            BundleCleanTask &task = tasks[index];
+            task.bundleName = bundleNames[index];
+            auto taskBeginTime = std::chrono::steady_clock::now();
+            int64_t sizeBefore = 0;
+            bool hasSizeBefore = GetBundleCleanableSize(task.bundleName, userId, appIndex, sizeBefore);
+            if (cleanCache) {
+                task.isCacheSuccess = CleanBundleCacheFilesOperation(task.bundleName, userId, appIndex);
+            }
+            if (cleanData) {
+                task.isDataSuccess = CleanBundleDataFilesOperation(task.bundleName, userId, appIndex, appMgrClient);
+            }
+            task.isSuccess = (!cleanCache || task.isCacheSuccess) && (!cleanData || task.isDataSuccess);
+            int64_t sizeAfter = 0;
+            if (hasSizeBefore && GetBundleCleanableSize(task.bundleName, userId, appIndex, sizeAfter)) {
+                task.hasStats = true;
+                task.reclaimedSize = std::max<int64_t>(sizeBefore - sizeAfter, 0);
+            }
+            task.costTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - taskBeginTime).count();
+        });
+
+    size_t failCount = 0;
+    int64_t totalReclaimedSize = 0;
+    for (const auto &task : tasks) {
+        resultMsg.append("bundleName: " + task.bundleName);
+        resultMsg.append(", result: " + std::string(task.isSuccess ? "success" : "failed"));
+        if (cleanCache && cleanData) {
+            resultMsg.append(", cache: " + std::string(task.isCacheSuccess ? "success" : "failed"));
+            resultMsg.append(", data: " + std::string(task.isDataSuccess ? "success" : "failed"));
+        }
+        resultMsg.append(", reclaimed: " + (task.hasStats ? std::to_string(task.reclaimedSize) + " bytes" :
+            std::string("unknown")));
+        resultMsg.append(", time: " + std::to_string(task.costTime) + "ms\n");
+        failCount += task.isSuccess ? 0 : 1;
+        totalReclaimedSize += task.reclaimedSize;
+    }
+    int64_t wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - beginTime).count();
+    resultMsg.append("bundle count: " + std::to_string(tasks.size()) + "\n");
+    resultMsg.append("success count: " + std::to_string(tasks.size() - failCount) + "\n");
+    resultMsg.append("fail count: " + std::to_string(failCount) + "\n");
+    resultMsg.append("reclaimed: " + std::to_string(totalReclaimedSize) + " bytes\n");
+    resultMsg.append("wall time: " + std::to_string(wallTime) + "ms\n");
+    return failCount == 0 ? OHOS::ERR_OK : OHOS::ERR_INVALID_VALUE;
+}
+
 bool BundleManagerShellCommand::SetApplicationEnabledOperation(const AbilityInfo &abilityInfo,
     bool isEnable, int32_t userId) const
 {
@@ -2561,9 +3887,13 @@ bool BundleManagerShellCommand::SetApplicationEnabledOperation(const AbilityInfo
     userId = BundleCommandCommon::GetCurrentUserId(userId);
     int32_t ret;
     if (abilityInfo.name.size() == 0) {
-        ret = bundleMgrProxy_->SetApplicationEnabled(abilityInfo.bundleName, isEnable, userId);
+        ret = TracedCall("IBundleMgr::SetApplicationEnabled", TraceCategory::IPC, [&]() {
+            return bundleMgrProxy_->SetApplicationEnabled(abilityInfo.bundleName, isEnable, userId);
+        });
     } else {
-        ret = bundleMgrProxy_->SetAbilityEnabled(abilityInfo, isEnable, userId);
+        ret = TracedCall("IBundleMgr::SetAbilityEnabled", TraceCategory::IPC, [&]() {
+            return bundleMgrProxy_->SetAbilityEnabled(abilityInfo, isEnable, userId);
+        });
     }
     if (ret != 0) {
         if (isEnable) {
@@ -2585,7 +3915,7 @@ std::string BundleManagerShellCommand::DumpOverlayInfo(const std::string &bundle
         return res;
     }
 
-    auto overlayManagerProxy = bundleMgrProxy_->GetOverlayManagerProxy();
+    auto overlayManagerProxy = GetOverlayManagerProxy();
     if (overlayManagerProxy == nullptr) {
         APP_LOGE("overlayManagerProxy is null");
         return res;
@@ -2595,15 +3925,21 @@ std::string BundleManagerShellCommand::DumpOverlayInfo(const std::string &bundle
     ErrCode ret = ERR_OK;
     userId = BundleCommandCommon::GetCurrentUserId(userId);
     if (moduleName.empty() && targetModuleName.empty()) {
-        ret = overlayManagerProxy->GetAllOverlayModuleInfo(bundleName, overlayModuleInfos, userId);
+        ret = TracedCall("IOverlayManager::GetAllOverlayModuleInfo", TraceCategory::IPC, [&]() {
+            return overlayManagerProxy->GetAllOverlayModuleInfo(bundleName, overlayModuleInfos, userId);
+        });
         if (overlayModuleInfos.empty()) {
             ret = ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NO_OVERLAY_MODULE_INFO;
         }
     } else if (!moduleName.empty()) {
-        ret = overlayManagerProxy->GetOverlayModuleInfo(bundleName, moduleName, overlayModuleInfo, userId);
+        ret = TracedCall("IOverlayManager::GetOverlayModuleInfo", TraceCategory::IPC, [&]() {
+            return overlayManagerProxy->GetOverlayModuleInfo(bundleName, moduleName, overlayModuleInfo, userId);
+        });
     } else {
-        ret = overlayManagerProxy->GetOverlayModuleInfoForTarget(bundleName, targetModuleName, overlayModuleInfos,
-            userId);
+        ret = TracedCall("IOverlayManager::GetOverlayModuleInfoForTarget", TraceCategory::IPC, [&]() {
+            return overlayManagerProxy->GetOverlayModuleInfoForTarget(bundleName, targetModuleName, overlayModuleInfos,
+                userId);
+        });
         if (overlayModuleInfos.empty()) {
             ret = ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NO_OVERLAY_MODULE_INFO;
         }
@@ -2619,7 +3955,9 @@ std::string BundleManagerShellCommand::DumpOverlayInfo(const std::string &bundle
     } else {
         overlayInfoJson = nlohmann::json {{OVERLAY_MODULE_INFO, overlayModuleInfo}};
     }
-    return overlayInfoJson.dump(Constants::DUMP_INDENT);
+    return TracedCall("nlohmann::json::dump", TraceCategory::SERIALIZE, [&]() {
+        return overlayInfoJson.dump(Constants::DUMP_INDENT);
+    });
 }
 
 std::string BundleManagerShellCommand::DumpTargetOverlayInfo(const std::string &bundleName,
@@ -2630,7 +3968,7 @@ std::string BundleManagerShellCommand::DumpTargetOverlayInfo(const std::string &
         APP_LOGE("error value of the dump-target-overlay command options");
         return res;
     }
-    auto overlayManagerProxy = bundleMgrProxy_->GetOverlayManagerProxy();
+    auto overlayManagerProxy = GetOverlayManagerProxy();
     if (overlayManagerProxy == nullptr) {
         APP_LOGE("overlayManagerProxy is null");
         return res;
@@ -2641,7 +3979,9 @@ std::string BundleManagerShellCommand::DumpTargetOverlayInfo(const std::string &
     nlohmann::json overlayInfoJson;
     if (moduleName.empty()) {
         std::vector<OverlayBundleInfo> overlayBundleInfos;
-        ret = overlayManagerProxy->GetOverlayBundleInfoForTarget(bundleName, overlayBundleInfos, userId);
+        ret = TracedCall("IOverlayManager::GetOverlayBundleInfoForTarget", TraceCategory::IPC, [&]() {
+            return overlayManagerProxy->GetOverlayBundleInfoForTarget(bundleName, overlayBundleInfos, userId);
+        });
         if (ret != ERR_OK || overlayBundleInfos.empty()) {
             APP_LOGE("dump-target-overlay failed due to errcode %{public}d", ret);
             return res;
@@ -2649,14 +3989,113 @@ std::string BundleManagerShellCommand::DumpTargetOverlayInfo(const std::string &
         overlayInfoJson = nlohmann::json {{OVERLAY_BUNDLE_INFOS, overlayBundleInfos}};
     } else {
         std::vector<OverlayModuleInfo> overlayModuleInfos;
-        ret = overlayManagerProxy->GetOverlayModuleInfoForTarget(bundleName, moduleName, overlayModuleInfos, userId);
+        ret = TracedCall("IOverlayManager::GetOverlayModuleInfoForTarget", TraceCategory::IPC, [&]() {
+            return overlayManagerProxy->GetOverlayModuleInfoForTarget(bundleName, moduleName, overlayModuleInfos,
+                userId);
+        });
         if (ret != ERR_OK || overlayModuleInfos.empty()) {
             APP_LOGE("dump-target-overlay failed due to errcode %{public}d", ret);
             return res;
         }
         overlayInfoJson = nlohmann::json {{OVERLAY_MODULE_INFOS, overlayModuleInfos}};
     }
-    return overlayInfoJson.dump(Constants::DUMP_INDENT);
+    return TracedCall("nlohmann::json::dump", TraceCategory::SERIALIZE, [&]() {
+        return overlayInfoJson.dump(Constants::DUMP_INDENT);
+    });
+}
+
+std::string BundleManagerShellCommand::DumpOverlayGraph(int32_t userId)
+{
+    std::string res = "";
+    auto overlayManagerProxy = GetOverlayManagerProxy();
+    if (overlayManagerProxy == nullptr) {
+        APP_LOGE("overlayManagerProxy is null");
+        return res;
+    }
+    userId = BundleCommandCommon::GetCurrentUserId(userId);
+    std::vector<std::string> bundleNames;
+    if (!GetSortedBundleNames(userId, bundleNames)) {
+        return res;
+    }
+
+    // every worker writes only its own slot, so the graph keeps the bundle order without any lock
+    std::vector<BundleOverlayEdges> edges(bundleNames.size());
+    BundleCommandCommon::ParallelFor(bundleNames.size(), DUMP_OVERLAY_PARALLEL_NUMBER,
+        [&overlayManagerProxy, &bundleNames, &edges, userId](size_t index) {
+            const std::string &bundleName = bundleNames[index];
+            BundleOverlayEdges &edge = edges[index];
+            ErrCode ret = TracedCall("IOverlayManager::GetAllOverlayModuleInfo", TraceCategory::IPC, [&]() {
+                return overlayManagerProxy->GetAllOverlayModuleInfo(bundleName, edge.overlayModuleInfos, userId);
+            });
+            if (ret != ERR_OK) {
+                edge.overlayModuleInfos.clear();
+                if (!IsNoOverlayEdge(ret)) {
+                    edge.errCode = ret;
+                    return;
+                }
+            }
+            ret = TracedCall("IOverlayManager::GetOverlayBundleInfoForTarget", TraceCategory::IPC, [&]() {
+                return overlayManagerProxy->GetOverlayBundleInfoForTarget(bundleName, edge.overlayBundleInfos,
+                    userId);
+            });
+            if (ret != ERR_OK) {
+                edge.overlayBundleInfos.clear();
+                if (!IsNoOverlayEdge(ret)) {
+                    edge.errCode = ret;
+                }
+            }
+        });
+
+    // a graph without the edges of a bundle which failed to be queried would be wrong, fail the whole dump then
+    bool isQueryFailed = false;
+    for (size_t index = 0; index < bundleNames.size(); ++index) {
+        if (edges[index].errCode != ERR_OK) {
+            APP_LOGE("query overlay of %{public}s failed due to errcode %{public}d", bundleNames[index].c_str(),
+                edges[index].errCode);
+            isQueryFailed = true;
+        }
+    }
+    if (isQueryFailed) {
+        return res;
+    }
+
+    nlohmann::json overlayModulesJson = nlohmann::json::object();
+    nlohmann::json overlayBundlesJson = nlohmann::json::object();
+    for (size_t index = 0; index < bundleNames.size(); ++index) {
+        const BundleOverlayEdges &edge = edges[index];
+        if (!edge.overlayModuleInfos.empty()) {
+            nlohmann::json &moduleEdges = overlayModulesJson[bundleNames[index]];
+            for (const auto &info : edge.overlayModuleInfos) {
+                moduleEdges.push_back(
+                    nlohmann::json::array({info.moduleName, info.targetModuleName, info.priority, info.state}));
+            }
+        }
+        if (!edge.overlayBundleInfos.empty()) {
+            nlohmann::json &bundleEdges = overlayBundlesJson[bundleNames[index]];
+            for (const auto &info : edge.overlayBundleInfos) {
+                bundleEdges.push_back(nlohmann::json::array({info.bundleName, info.priority, info.state}));
+            }
+        }
+    }
+    nlohmann::json overlayGraphJson = {
+        {OVERLAY_GRAPH_USER_ID, userId},
+        {OVERLAY_GRAPH_BUNDLE_COUNT, bundleNames.size()},
+        {OVERLAY_GRAPH_MODULES, std::move(overlayModulesJson)},
+        {OVERLAY_GRAPH_BUNDLES, std::move(overlayBundlesJson)},
+    };
+    return TracedCall("nlohmann::json::dump", TraceCategory::SERIALIZE, [&]() {
+        return overlayGraphJson.dump();
+    });
+}
+
+sptr<IOverlayManager> BundleManagerShellCommand::GetOverlayManagerProxy()
+{
+    if (overlayManagerProxy_ == nullptr) {
+        overlayManagerProxy_ = TracedCall("IBundleMgr::GetOverlayManagerProxy", TraceCategory::PROXY, [&]() {
+            return bundleMgrProxy_->GetOverlayManagerProxy();
+        });
+    }
+    return overlayManagerProxy_;
 }
 
 ErrCode BundleManagerShellCommand::RunAsDumpSharedDependenciesCommand()
@@ -2775,7 +4214,9 @@ std::string BundleManagerShellCommand::DumpSharedDependencies(const std::string
     APP_LOGD("DumpSharedDependencies bundleName: %{public}s, moduleName: %{public}s",
         bundleName.c_str(), moduleName.c_str());
     std::vector<Dependency> dependencies;
-    ErrCode ret = bundleMgrProxy_->GetSharedDependencies(bundleName, moduleName, dependencies);
+    ErrCode ret = TracedCall("IBundleMgr::GetSharedDependencies", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetSharedDependencies(bundleName, moduleName, dependencies);
+    });
     nlohmann::json dependenciesJson;
     if (ret != ERR_OK) {
         APP_LOGE("dump shared dependencies failed due to errcode %{public}d", ret);
@@ -2783,7 +4224,9 @@ std::string BundleManagerShellCommand::DumpSharedDependencies(const std::string
     } else {
         dependenciesJson = nlohmann::json {{DEPENDENCIES, dependencies}};
     }
-    return dependenciesJson.dump(Constants::DUMP_INDENT) + "\n";
+    return TracedCall("nlohmann::json::dump", TraceCategory::SERIALIZE, [&]() {
+        return dependenciesJson.dump(Constants::DUMP_INDENT) + "\n";
+    });
 }
 
 ErrCode BundleManagerShellCommand::RunAsDumpSharedCommand()
@@ -2894,7 +4337,9 @@ std::string BundleManagerShellCommand::DumpShared(const std::string &bundleName)
 {
     APP_LOGD("DumpShared bundleName: %{public}s", bundleName.c_str());
     SharedBundleInfo sharedBundleInfo;
-    ErrCode ret = bundleMgrProxy_->GetSharedBundleInfoBySelf(bundleName, sharedBundleInfo);
+    ErrCode ret = TracedCall("IBundleMgr::GetSharedBundleInfoBySelf", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetSharedBundleInfoBySelf(bundleName, sharedBundleInfo);
+    });
     nlohmann::json sharedBundleInfoJson;
     if (ret != ERR_OK) {
         APP_LOGE("dump-shared failed due to errcode %{public}d", ret);
@@ -2902,7 +4347,9 @@ std::string BundleManagerShellCommand::DumpShared(const std::string &bundleName)
     } else {
         sharedBundleInfoJson = nlohmann::json {{SHARED_BUNDLE_INFO, sharedBundleInfo}};
     }
-    return sharedBundleInfoJson.dump(Constants::DUMP_INDENT);
+    return TracedCall("nlohmann::json::dump", TraceCategory::SERIALIZE, [&]() {
+        return sharedBundleInfoJson.dump(Constants::DUMP_INDENT);
+    });
 }
 
 std::string BundleManagerShellCommand::DumpSharedAll() const
@@ -2910,7 +4357,9 @@ std::string BundleManagerShellCommand::DumpSharedAll() const
     APP_LOGD("DumpSharedAll");
     std::string dumpResults = "";
     std::vector<SharedBundleInfo> sharedBundleInfos;
-    ErrCode ret = bundleMgrProxy_->GetAllSharedBundleInfo(sharedBundleInfos);
+    ErrCode ret = TracedCall("IBundleMgr::GetAllSharedBundleInfo", TraceCategory::IPC, [&]() {
+        return bundleMgrProxy_->GetAllSharedBundleInfo(sharedBundleInfos);
+    });
     if (ret != ERR_OK) {
         APP_LOGE("dump-shared all failed due to errcode %{public}d", ret);
         return dumpResults;
@@ -2954,18 +4403,24 @@ ErrCode BundleManagerShellCommand::DeployQuickFixDisable(const std::vector<std::
         return ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
     }
     DeathRecipientGuard deathRecipientGuard(bundleMgrObject, recipient);
-    auto quickFixProxy = bundleMgrProxy_->GetQuickFixManagerProxy();
+    auto quickFixProxy = TracedCall("IBundleMgr::GetQuickFixManagerProxy", TraceCategory::PROXY, [&]() {
+        return bundleMgrProxy_->GetQuickFixManagerProxy();
+    });
     if (quickFixProxy == nullptr) {
         APP_LOGE("quickFixProxy is null");
         return ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
     }
     std::vector<std::string> destFiles;
-    auto res = quickFixProxy->CopyFiles(pathVec, destFiles);
+    auto res = TracedCall("IQuickFixManager::CopyFiles", TraceCategory::IPC, [&]() {
+        return quickFixProxy->CopyFiles(pathVec, destFiles);
+    });
     if (res != ERR_OK) {
         APP_LOGE("Copy files failed with %{public}d.", res);
         return res;
     }
-    res = quickFixProxy->DeployQuickFix(destFiles, callback, isDebug, targetPath);
+    res = TracedCall("IQuickFixManager::DeployQuickFix", TraceCategory::IPC, [&]() {
+        return quickFixProxy->DeployQuickFix(destFiles, callback, isDebug, targetPath);
+    });
     if (res != ERR_OK) {
         APP_LOGE("DeployQuickFix failed");
         return res;
@@ -2993,12 +4448,16 @@ ErrCode BundleManagerShellCommand::DeleteQuickFix(const std::string &bundleName,
         return ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
     }
     DeathRecipientGuard deathRecipientGuard(bundleMgrObject, recipient);
-    auto quickFixProxy = bundleMgrProxy_->GetQuickFixManagerProxy();
+    auto quickFixProxy = TracedCall("IBundleMgr::GetQuickFixManagerProxy", TraceCategory::PROXY, [&]() {
+        return bundleMgrProxy_->GetQuickFixManagerProxy();
+    });
     if (quickFixProxy == nullptr) {
         APP_LOGE("quickFixProxy is null");
         return ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
     }
-    auto res = quickFixProxy->DeleteQuickFix(bundleName, callback);
+    auto res = TracedCall("IQuickFixManager::DeleteQuickFix", TraceCategory::IPC, [&]() {
+        return quickFixProxy->DeleteQuickFix(bundleName, callback);
+    });
     if (res != ERR_OK) {
         APP_LOGE("DeleteQuickFix failed");
         return res;
@@ -3059,7 +4518,9 @@ ErrCode BundleManagerShellCommand::RunAsInstallPluginCommand()
         installPluginParam.userId = userId;
         std::vector<std::string> pathVec;
         GetAbsPaths(pluginPaths, pathVec);
-        int32_t installResult = bundleInstallerProxy_->InstallPlugin(hostBundleName, pathVec, installPluginParam);
+        int32_t installResult = TracedCall("IBundleInstaller::InstallPlugin", TraceCategory::IPC, [&]() {
+            return bundleInstallerProxy_->InstallPlugin(hostBundleName, pathVec, installPluginParam);
+        });
         if (installResult == OHOS::ERR_OK) {
             resultReceiver_ = STRING_INSTALL_BUNDLE_OK + "\n";
         } else {
@@ -3163,8 +4624,9 @@ ErrCode BundleManagerShellCommand::RunAsUninstallPluginCommand()
     } else {
         InstallPluginParam installPluginParam;
         installPluginParam.userId = userId;
-        int32_t installResult =
-            bundleInstallerProxy_->UninstallPlugin(hostBundleName, pluginBundleName, installPluginParam);
+        int32_t installResult = TracedCall("IBundleInstaller::UninstallPlugin", TraceCategory::IPC, [&]() {
+            return bundleInstallerProxy_->UninstallPlugin(hostBundleName, pluginBundleName, installPluginParam);
+        });
         if (installResult == OHOS::ERR_OK) {
             resultReceiver_ = STRING_UNINSTALL_BUNDLE_OK + "\n";
         } else {
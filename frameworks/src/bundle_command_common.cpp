@@ -14,22 +14,62 @@
  */
 #include "bundle_command_common.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "app_log_wrapper.h"
 #include "appexecfwk_errors.h"
 #include "bundle_mgr_proxy.h"
+#include "command_trace.h"
+#include "common_event_manager.h"
+#include "common_event_support.h"
+#include "completion.h"
 #ifdef ACCOUNT_ENABLE
 #include "os_account_info.h"
 #include "os_account_manager.h"
 #endif
 #include "if_system_ability_manager.h"
 #include "iservice_registry.h"
+#include "status_receiver_impl.h"
 #include "status_receiver_interface.h"
 #include "system_ability_definition.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+std::mutex g_userCacheMutex;
+bool g_hasForegroundUser = false;
+int32_t g_foregroundUserId = Constants::UNSPECIFIED_USERID;
+std::unordered_map<int32_t, bool> g_userForegroundStates;
+
+#ifdef ACCOUNT_ENABLE
+class UserSwitchMonitor : public EventFwk::CommonEventSubscriber {
+public:
+    explicit UserSwitchMonitor(const EventFwk::CommonEventSubscribeInfo &subscribeInfo)
+        : EventFwk::CommonEventSubscriber(subscribeInfo)
+    {}
+
+    virtual ~UserSwitchMonitor() = default;
+
+    void OnReceiveEvent(const EventFwk::CommonEventData &eventData) override
+    {
+        APP_LOGI("user switch event %{public}s", eventData.GetWant().GetAction().c_str());
+        BundleCommandCommon::InvalidateUserCache();
+    }
+};
+
+std::mutex g_userSwitchMutex;
+std::shared_ptr<UserSwitchMonitor> g_userSwitchMonitor;
+#endif
+}  // namespace
+
 sptr<IBundleMgr> BundleCommandCommon::GetBundleMgrProxy()
 {
+    CommandTraceSpan span("BundleCommandCommon::GetBundleMgrProxy", TraceCategory::PROXY);
     sptr<ISystemAbilityManager> systemAbilityManager =
         SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
     if (systemAbilityManager == nullptr) {
@@ -51,12 +91,20 @@ int32_t BundleCommandCommon::GetCurrentUserId(int32_t userId)
 {
     if (userId == Constants::UNSPECIFIED_USERID) {
 #ifdef ACCOUNT_ENABLE
+        std::lock_guard<std::mutex> lock(g_userCacheMutex);
+        if (g_hasForegroundUser) {
+            return g_foregroundUserId;
+        }
         std::int32_t localId;
-        int32_t ret = AccountSA::OsAccountManager::GetForegroundOsAccountLocalId(localId);
+        int32_t ret = TracedCall("OsAccountManager::GetForegroundOsAccountLocalId", TraceCategory::IPC,
+            [&localId]() { return AccountSA::OsAccountManager::GetForegroundOsAccountLocalId(localId); });
         if (ret != 0) {
+            // a failure is not cached, the next call queries again
             APP_LOGW("GetForegroundOsAccountLocalId failed! ret = %{public}d.", ret);
             return userId;
         }
+        g_hasForegroundUser = true;
+        g_foregroundUserId = localId;
         return localId;
 #endif
     }
@@ -66,18 +114,101 @@ int32_t BundleCommandCommon::GetCurrentUserId(int32_t userId)
 bool BundleCommandCommon::IsUserForeground(int32_t userId)
 {
 #ifdef ACCOUNT_ENABLE
+    std::lock_guard<std::mutex> lock(g_userCacheMutex);
+    auto iter = g_userForegroundStates.find(userId);
+    if (iter != g_userForegroundStates.end()) {
+        return iter->second;
+    }
     bool isForeground = false;
-    int32_t ret = AccountSA::OsAccountManager::IsOsAccountForeground(userId, isForeground);
+    int32_t ret = TracedCall("OsAccountManager::IsOsAccountForeground", TraceCategory::IPC,
+        [userId, &isForeground]() { return AccountSA::OsAccountManager::IsOsAccountForeground(userId, isForeground); });
     if (ret != 0) {
         APP_LOGW("IsOsAccountForeground failed! ret = %{public}d, userId = %{public}d.", ret, userId);
         return false;
     }
+    g_userForegroundStates[userId] = isForeground;
     return isForeground;
 #else
     return true;
 #endif
 }
 
+void BundleCommandCommon::InvalidateUserCache()
+{
+    std::lock_guard<std::mutex> lock(g_userCacheMutex);
+    g_hasForegroundUser = false;
+    g_foregroundUserId = Constants::UNSPECIFIED_USERID;
+    g_userForegroundStates.clear();
+}
+
+bool BundleCommandCommon::SubscribeUserSwitch()
+{
+#ifdef ACCOUNT_ENABLE
+    std::lock_guard<std::mutex> lock(g_userSwitchMutex);
+    if (g_userSwitchMonitor != nullptr) {
+        return true;
+    }
+    EventFwk::MatchingSkills matchingSkills;
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_SWITCHED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_FOREGROUND);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_BACKGROUND);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_REMOVED);
+    EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
+    auto monitor = std::make_shared<UserSwitchMonitor>(subscribeInfo);
+    if (!EventFwk::CommonEventManager::SubscribeCommonEvent(monitor)) {
+        APP_LOGW("subscribe user switch event failed");
+        return false;
+    }
+    g_userSwitchMonitor = monitor;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void BundleCommandCommon::UnsubscribeUserSwitch()
+{
+#ifdef ACCOUNT_ENABLE
+    std::lock_guard<std::mutex> lock(g_userSwitchMutex);
+    if (g_userSwitchMonitor == nullptr) {
+        return;
+    }
+    EventFwk::CommonEventManager::UnSubscribeCommonEvent(g_userSwitchMonitor);
+    g_userSwitchMonitor = nullptr;
+#endif
+}
+
+void BundleCommandCommon::ParallelFor(size_t taskCount, int32_t jobs, const std::function<void(size_t)> &task)
+{
+    if (taskCount == 0 || task == nullptr) {
+        return;
+    }
+    size_t workerNum = std::min(taskCount, static_cast<size_t>(std::max(jobs, 1)));
+    std::atomic<size_t> nextIndex(0);
+    // the tasks wait no longer than the caller would
+    Deadline deadline = Deadline::Current();
+    auto worker = [&nextIndex, taskCount, &task, &deadline]() {
+        ScopedDeadline scopedDeadline(deadline);
+        size_t index = nextIndex.fetch_add(1);
+        while (index < taskCount) {
+            task(index);
+            index = nextIndex.fetch_add(1);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(workerNum - 1);
+    for (size_t i = 1; i < workerNum; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : workers) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    APP_LOGD("parallel tasks finished, taskCount: %{public}zu, workerNum: %{public}zu", taskCount, workerNum);
+}
+
 std::map<int32_t, std::string> BundleCommandCommon::bundleMessageMap_ = {
     //  error + message
     {
@@ -460,6 +591,10 @@ std::map<int32_t, std::string> BundleCommandCommon::bundleMessageMap_ = {
         IStatusReceiver::ERR_OPERATION_TIME_OUT,
         "error: operation time out.",
     },
+    {
+        StatusReceiverImpl::ERR_OPERATION_CANCELED,
+        "error: operation canceled.",
+    },
     {
         IStatusReceiver::ERR_INSTALL_NOT_UNIQUE_DISTRO_MODULE_NAME,
         "error: moduleName is not unique.",
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_snapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <numeric>
+#include <string_view>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "app_log_wrapper.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const char *SNAPSHOT_PATH_ENV = "BM_SNAPSHOT";
+const char SNAPSHOT_MAGIC[8] = { 'B', 'M', 'S', 'N', 'A', 'P', '0', '1' };
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+const std::string WATCHER_LOCK_SUFFIX = ".lock";
+constexpr mode_t SNAPSHOT_FILE_MODE = S_IRUSR | S_IWUSR;
+
+/*
+ * layout: header | entries sorted by bundle name and app index | entry indexes sorted by uid | strings
+ * every field has a fixed width, so the file is read in place after mmap
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t userId;
+    uint32_t entryCount;
+    uint32_t isWatched;
+    int64_t createTime;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+};
+
+struct SnapshotEntry {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t deviceTypeOffset;
+    uint32_t deviceTypeLength;
+    int32_t uid;
+    int32_t appIndex;
+    int32_t apiTargetVersion;
+    int32_t reserved;
+};
+
+const SnapshotHeader *GetHeader(const uint8_t *data)
+{
+    return reinterpret_cast<const SnapshotHeader *>(data);
+}
+
+const SnapshotEntry *GetEntries(const uint8_t *data)
+{
+    return reinterpret_cast<const SnapshotEntry *>(data + sizeof(SnapshotHeader));
+}
+
+const uint32_t *GetUidIndexes(const uint8_t *data)
+{
+    return reinterpret_cast<const uint32_t *>(
+        data + sizeof(SnapshotHeader) + GetHeader(data)->entryCount * sizeof(SnapshotEntry));
+}
+
+std::string_view GetString(const uint8_t *data, uint32_t offset, uint32_t length)
+{
+    const char *stringTable = reinterpret_cast<const char *>(data + GetHeader(data)->stringTableOffset);
+    return std::string_view(stringTable + offset, length);
+}
+
+bool WriteAll(int fd, const void *buffer, size_t size)
+{
+    const char *begin = static_cast<const char *>(buffer);
+    while (size > 0) {
+        ssize_t written = write(fd, begin, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        begin += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// a shared lock is refused only while a watcher holds the exclusive one
+bool IsWatcherAlive(const std::string &path)
+{
+    int fd = open((path + WATCHER_LOCK_SUFFIX).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool isLocked = flock(fd, LOCK_SH | LOCK_NB) != 0 && errno == EWOULDBLOCK;
+    close(fd);
+    return isLocked;
+}
+}  // namespace
+
+BundleSnapshot::~BundleSnapshot()
+{
+    Close();
+}
+
+std::string BundleSnapshot::GetPathFromEnv()
+{
+    const char *path = getenv(SNAPSHOT_PATH_ENV);
+    return path == nullptr ? "" : path;
+}
+
+bool BundleSnapshot::Write(const std::string &path, int32_t userId, bool isWatched,
+    const std::vector<BundleSnapshotRecord> &records)
+{
+    std::vector<uint32_t> order(records.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&records](uint32_t left, uint32_t right) {
+        if (records[left].bundleName != records[right].bundleName) {
+            return records[left].bundleName < records[right].bundleName;
+        }
+        return records[left].appIndex < records[right].appIndex;
+    });
+
+    std::vector<SnapshotEntry> entries(records.size());
+    std::string stringTable;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const BundleSnapshotRecord &record = records[order[i]];
+        SnapshotEntry &entry = entries[i];
+        entry.nameOffset = static_cast<uint32_t>(stringTable.size());
+        entry.nameLength = static_cast<uint32_t>(record.bundleName.size());
+        stringTable.append(record.bundleName);
+        entry.deviceTypeOffset = static_cast<uint32_t>(stringTable.size());
+        entry.deviceTypeLength = static_cast<uint32_t>(record.deviceType.size());
+        stringTable.append(record.deviceType);
+        entry.uid = record.uid;
+        entry.appIndex = record.appIndex;
+        entry.apiTargetVersion = record.apiTargetVersion;
+        entry.reserved = 0;
+    }
+    std::vector<uint32_t> uidIndexes(entries.size());
+    std::iota(uidIndexes.begin(), uidIndexes.end(), 0);
+    std::stable_sort(uidIndexes.begin(), uidIndexes.end(), [&entries](uint32_t left, uint32_t right) {
+        return entries[left].uid < entries[right].uid;
+    });
+
+    SnapshotHeader header = {};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.userId = userId;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.isWatched = isWatched ? 1 : 0;
+    header.createTime = static_cast<int64_t>(time(nullptr));
+    header.stringTableOffset = sizeof(SnapshotHeader) + entries.size() * sizeof(SnapshotEntry) +
+        uidIndexes.size() * sizeof(uint32_t);
+    header.stringTableSize = stringTable.size();
+
+    std::string tempPath = path + ".tmp" + std::to_string(getpid());
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, SNAPSHOT_FILE_MODE);
+    if (fd < 0) {
+        APP_LOGE("open %{private}s failed, errno: %{public}d", tempPath.c_str(), errno);
+        return false;
+    }
+    bool ret = WriteAll(fd, &header, sizeof(header)) &&
+        WriteAll(fd, entries.data(), entries.size() * sizeof(SnapshotEntry)) &&
+        WriteAll(fd, uidIndexes.data(), uidIndexes.size() * sizeof(uint32_t)) &&
+        WriteAll(fd, stringTable.data(), stringTable.size());
+    close(fd);
+    if (!ret || rename(tempPath.c_str(), path.c_str()) != 0) {
+        APP_LOGE("write snapshot %{private}s failed, errno: %{public}d", path.c_str(), errno);
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void BundleSnapshot::Invalidate(const std::string &path)
+{
+    if (unlink(path.c_str()) != 0 && errno != ENOENT) {
+        APP_LOGW("remove snapshot %{private}s failed, errno: %{public}d", path.c_str(), errno);
+    }
+}
+
+int32_t BundleSnapshot::LockWatcher(const std::string &path)
+{
+    std::string lockPath = path + WATCHER_LOCK_SUFFIX;
+    int fd = open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, SNAPSHOT_FILE_MODE);
+    if (fd < 0) {
+        APP_LOGE("open %{private}s failed, errno: %{public}d", lockPath.c_str(), errno);
+        return -1;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        APP_LOGE("lock %{private}s failed, errno: %{public}d", lockPath.c_str(), errno);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void BundleSnapshot::UnlockWatcher(int32_t lockFd)
+{
+    if (lockFd >= 0) {
+        close(lockFd);
+    }
+}
+
+bool BundleSnapshot::Open(const std::string &path, bool isWatchRequired)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(SnapshotHeader)) {
+        close(fd);
+        return false;
+    }
+    void *data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        APP_LOGW("mmap snapshot %{private}s failed, errno: %{public}d", path.c_str(), errno);
+        return false;
+    }
+    data_ = static_cast<const uint8_t *>(data);
+    size_ = static_cast<size_t>(fileStat.st_size);
+    if (!CheckLayout()) {
+        APP_LOGW("snapshot %{private}s is broken", path.c_str());
+        Close();
+        return false;
+    }
+    // a snapshot built once may miss any later install, so it is never trusted by the queries
+    if (isWatchRequired && (GetHeader(data_)->isWatched == 0 || !IsWatcherAlive(path))) {
+        APP_LOGI("snapshot %{private}s is not watched", path.c_str());
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void BundleSnapshot::Close()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+bool BundleSnapshot::CheckLayout() const
+{
+    const SnapshotHeader *header = GetHeader(data_);
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 || header->version != SNAPSHOT_VERSION) {
+        return false;
+    }
+    uint64_t stringTableOffset = sizeof(SnapshotHeader) +
+        static_cast<uint64_t>(header->entryCount) * (sizeof(SnapshotEntry) + sizeof(uint32_t));
+    if (header->stringTableOffset != stringTableOffset ||
+        stringTableOffset + header->stringTableSize != static_cast<uint64_t>(size_)) {
+        return false;
+    }
+    const SnapshotEntry *entries = GetEntries(data_);
+    const uint32_t *uidIndexes = GetUidIndexes(data_);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const SnapshotEntry &entry = entries[i];
+        if (static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header->stringTableSize ||
+            static_cast<uint64_t>(entry.deviceTypeOffset) + entry.deviceTypeLength > header->stringTableSize ||
+            uidIndexes[i] >= header->entryCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t BundleSnapshot::GetUserId() const
+{
+    return data_ == nullptr ? -1 : GetHeader(data_)->userId;
+}
+
+size_t BundleSnapshot::GetRecordCount() const
+{
+    return data_ == nullptr ? 0 : GetHeader(data_)->entryCount;
+}
+
+void BundleSnapshot::GetRecord(uint32_t index, BundleSnapshotRecord &record) const
+{
+    const SnapshotEntry &entry = GetEntries(data_)[index];
+    record.bundleName = GetString(data_, entry.nameOffset, entry.nameLength);
+    record.deviceType = GetString(data_, entry.deviceTypeOffset, entry.deviceTypeLength);
+    record.uid = entry.uid;
+    record.appIndex = entry.appIndex;
+    record.apiTargetVersion = entry.apiTargetVersion;
+}
+
+bool BundleSnapshot::FindByBundleName(const std::string &bundleName, int32_t appIndex,
+    BundleSnapshotRecord &record) const
+{
+    if (data_ == nullptr) {
+        return false;
+    }
+    const SnapshotEntry *begin = GetEntries(data_);
+    const SnapshotEntry *end = begin + GetHeader(data_)->entryCount;
+    const uint8_t *data = data_;
+    auto iter = std::lower_bound(begin, end, std::make_pair(std::string_view(bundleName), appIndex),
+        [data](const SnapshotEntry &entry, const std::pair<std::string_view, int32_t> &key) {
+            std::string_view name = GetString(data, entry.nameOffset, entry.nameLength);
+            return name != key.first ? name < key.first : entry.appIndex < key.second;
+        });
+    if (iter == end || GetString(data_, iter->nameOffset, iter->nameLength) != bundleName ||
+        iter->appIndex != appIndex) {
+        return false;
+    }
+    GetRecord(static_cast<uint32_t>(iter - begin), record);
+    return true;
+}
+
+bool BundleSnapshot::FindByUid(int32_t uid, BundleSnapshotRecord &record) const
+{
+    if (data_ == nullptr) {
+        return false;
+    }
+    const SnapshotEntry *entries = GetEntries(data_);
+    const uint32_t *begin = GetUidIndexes(data_);
+    const uint32_t *end = begin + GetHeader(data_)->entryCount;
+    auto iter = std::lower_bound(begin, end, uid,
+        [entries](uint32_t index, int32_t key) { return entries[index].uid < key; });
+    if (iter == end || entries[*iter].uid != uid) {
+        return false;
+    }
+    GetRecord(*iter, record);
+    return true;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
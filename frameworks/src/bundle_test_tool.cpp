@@ -14,31 +14,44 @@
  */
 #include "bundle_test_tool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <dirent.h>
 #include <fcntl.h>
 #include <fstream>
 #include <future>
 #include <getopt.h>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <thread>
 #include <unistd.h>
+#include <unordered_map>
 #include <vector>
 
 #include "accesstoken_kit.h"
 #include "app_log_wrapper.h"
 #include "appexecfwk_errors.h"
+#include "batch_query_engine.h"
 #include "bundle_command_common.h"
+#include "completion.h"
 #include "bundle_death_recipient.h"
 #include "bundle_dir.h"
 #include "bundle_mgr_client.h"
 #include "bundle_mgr_ext_client.h"
 #include "bundle_mgr_proxy.h"
+#include "bundle_snapshot.h"
 #include "bundle_tool_callback_stub.h"
+#include "command_trace.h"
 #include "common_event_manager.h"
 #include "common_event_support.h"
 #include "permission_define.h"
@@ -46,6 +59,7 @@
 #include "data_group_info.h"
 #include "directory_ex.h"
 #include "get_largest_items_callback_host.h"
+#include "hap_verifier.h"
 #include "module_info.h"
 #include "parameter.h"
 #include "parameters.h"
@@ -60,6 +74,7 @@
 #include "status_receiver_impl.h"
 #include "string_ex.h"
 #include "json_util.h"
+#include "text_builder.h"
 #ifdef DISTRIBUTED_BUNDLE_FRAMEWORK
 #include "distributed_bundle_mgr_client.h"
 #endif
@@ -87,6 +102,27 @@ const int32_t MAX_WAITING_TIME = 600;
 const int32_t MAX_PARAMS_FOR_UNINSTALL = 4;
 constexpr size_t BUNDLE_STATS_CACHE_INDEX = 4;
 constexpr size_t BUNDLE_STATS_MIN_SIZE = 5;
+constexpr int32_t DEFAULT_CACHE_STAT_JOBS = 4;
+constexpr int32_t MAX_CACHE_STAT_JOBS = 32;
+constexpr int32_t MAX_CACHE_STAT_BATCH_SIZE = 500;
+constexpr int64_t INVALID_CACHE_SIZE = -1;
+constexpr size_t BUNDLE_CACHE_STAT_LINE_SIZE = 96;
+constexpr size_t BUNDLE_DIR_LINE_SIZE = 256;
+constexpr size_t JSON_PROFILE_LINE_SIZE = 1024;
+constexpr const char *LIST_ITEM_INDENT = "     ";
+constexpr int32_t DEFAULT_BUNDLE_INFO_CHUNK_SIZE = 32;
+constexpr int32_t MAX_BUNDLE_INFO_CHUNK_SIZE = 256;
+constexpr int32_t SNAPSHOT_BUILD_JOBS = 8;
+constexpr std::chrono::milliseconds SNAPSHOT_WATCH_INTERVAL(500);
+const std::string DEFAULT_SNAPSHOT_PATH = "/data/local/tmp/bm_bundle_snapshot";
+const std::string MODULE_JSON_FILE_NAME = "module.json";
+constexpr int32_t MAX_PARSE_SPM_MODULE_JOBS = 16;
+constexpr int32_t DEFAULT_BATCH_QUERY_JOBS = 4;
+constexpr int32_t MAX_BATCH_QUERY_JOBS = 32;
+constexpr int32_t MAX_BATCH_QUERY_CHUNK_SIZE = 1000;
+// module.json is a few kilobytes, a much larger file is not a module.json
+constexpr size_t MAX_MODULE_JSON_FILE_SIZE = 16 * 1024 * 1024;
+constexpr int32_t COMPACT_JSON_INDENT = -1;
 // system param
 constexpr const char* IS_ENTERPRISE_DEVICE = "const.edm.is_enterprise_device";
 // test param
@@ -228,6 +264,7 @@ static const std::string HELP_MSG =
     "  setDefaultApplicationForCustom   set default application for enterprise customization\n"
     "  getAllBundleCacheStat            obtain all bundle cache size \n"
     "  getEachBundleCacheStat           obtain each bundle cache size \n"
+    "  snapshot                         build the bundle snapshot read by the query commands\n"
     "  cleanAllBundleCache              clean all bundle cache \n"
     "  deleteDisposedRules              delete disposed rules \n"
     "  isBundleInstalled                determine whether the bundle is installed based on bundleName user "
@@ -484,7 +521,10 @@ const std::string HELP_MSG_DEPLOY_QUICK_FIX =
     "options list:\n"
     "  -h, --help                             list available commands\n"
     "  -p, --patch-path  <patch-path>         specify patch path of the patch\n"
-    "  -d, --debug  <debug>                   specify deploy mode, 0 represents release, 1 represents debug\n";
+    "  -d, --debug  <debug>                   specify deploy mode, 0 represents release, 1 represents debug\n"
+    "  --multi-bundle                         group the hqf files by the bundleName of their patch.json, a bundle\n"
+    "                                           is deployed while the next one is copied, eg:\n"
+    "                                           bundle_test_tool deployQuickFix --multi-bundle -p <dir1> <dir2>\n";
 
 const std::string HELP_MSG_SWITCH_QUICK_FIX =
     "usage: bundle_test_tool switch quick fix <options>\n"
@@ -527,14 +567,10 @@ const std::string HELP_MSG_BATCH_GET_BUNDLE_INFO =
     "  -h, --help                             list available commands\n"
     "  -n, --bundle-name <bundle-name>        specify bundle names separated by commas\n"
     "  -f, --flags <flags>                    specify bundle info flags (default: 1)\n"
-    "  -u, --user-id <user-id>                specify a user id\n";
-
-const std::string HELP_MSG_PARSE_SPM_MODULE =
-    "usage: bundle_test_tool parseSpmModule <options>\n"
-    "eg:bundle_test_tool parseSpmModule -p <module-json-path>\n"
-    "options list:\n"
-    "  -h, --help                             list available commands\n"
-    "  -p, --module-json-path <path>          specify module.json file path\n";
+    "  -u, --user-id <user-id>                specify a user id\n"
+    "  -s, --stream                           print one bundle info per line as soon as it is obtained\n"
+    "  -c, --chunk-size <chunk-size>          specify the bundle number of one query in stream mode,\n"
+    "                                           default is 32, the maximum is 256\n";
 
 const std::string HELP_MSG_QUERY_ABILITY_INFO =
     "usage: bundle_test_tool queryAbilityInfo <options>\n"
@@ -844,10 +880,14 @@ const std::string HELP_MSG_GET_ALL_BUNDLE_CACHE_STAT =
 
 const std::string HELP_MSG_GET_EACH_BUNDLE_CACHE_STAT =
     "usage: bundle_test_tool getEachBundleCacheStat <options>\n"
-    "eg:bundle_test_tool getEachBundleCacheStat -u <user-id>\n"
+    "eg:bundle_test_tool getEachBundleCacheStat -u <user-id> -j <jobs>\n"
     "options list:\n"
     "  -h, --help                             list available commands\n"
-    "  -u, --user-id <user-id>                specify a user id\n";
+    "  -u, --user-id <user-id>                specify a user id\n"
+    "  -j, --jobs <jobs>                      specify the number of concurrent queries, default is 4,\n"
+    "                                           the maximum is 32\n"
+    "  -b, --batch-size <batch-size>          query the main bundles by batchGetBundleStats in chunks of\n"
+    "                                           batch-size, the maximum is 500, the others are queried one by one\n";
 
 const std::string HELP_MSG_CLEAN_ALL_BUNDLE_CACHE =
     "usage: bundle_test_tool cleanAllBundleCache <options>\n"
@@ -897,13 +937,6 @@ const std::string HELP_MSG_GET_COMPATIBLE_DEVICE_TYPE =
     "  -h, --help                             list available commands\n"
     "  -n, --bundle-name <bundle-name>        specify bundle name of the application\n";
 
-const std::string HELP_MSG_BATCH_GET_COMPATIBLE_DEVICE_TYPE =
-    "usage: bundle_test_tool batchGetCompatibleDeviceType <option>\n"
-    "eg: bundle_test_tool batchGetCompatibleDeviceType -n <bundle-name>,<bundle-name>\n"
-    "options list:\n"
-    "  -h, --help                             list available commands\n"
-    "  -n, --bundle-name <bundle-name>        specify bundle name of the application\n";
-
 const std::string HELP_MSG_NO_QUERY_ABILITY_INFO_BY_CONTINUE_TYPE =
     "error: you must specify a bundle name with '-n' or '--bundle-name' \n"
     "and a continueType with '-c' or '--continue-type' \n"
@@ -960,12 +993,6 @@ const std::string HELP_MSG_GET_BUNDLENAMES_FOR_UID_EXT =
     "options list:\n"
     "  -u, --uid <uid>            specify a app uid\n";
 
-const std::string HELP_MSG_GET_SIMPLE_APP_INFO_FOR_UID =
-    "usage: bundle_test_tool GetSimpleAppInfoForUid <options>\n"
-    "eg:bundle_test_tool getSimpleAppInfoForUid -u <uid>,<uid>,<uid>...\n"
-    "options list:\n"
-    "  -u, --uid  <uid>         specify uid of the application\n";
-
 const std::string HELP_MSG_UNINSTALL_PREINSTALL_BUNDLE =
     "usage: bundle_test_tool uninstallPreInstallBundle <options>\n"
     "options list:\n"
@@ -1125,6 +1152,9 @@ const std::string STRING_BATCH_GET_COMPATIBLE_DEVICE_TYPE_NG = "batchGetCompatib
 const std::string STRING_BATCH_GET_BUNDLE_INFO_OK = "batchGetBundleInfo successfully\n";
 const std::string STRING_BATCH_GET_BUNDLE_INFO_NG = "batchGetBundleInfo failed\n";
 
+const std::string STRING_SNAPSHOT_OK = "snapshot successfully\n";
+const std::string STRING_SNAPSHOT_NG = "snapshot failed\n";
+
 const std::string STRING_PARSE_SPM_MODULE_OK = "parseSpmModule successfully\n";
 const std::string STRING_PARSE_SPM_MODULE_NG = "parseSpmModule failed\n";
 
@@ -1268,13 +1298,6 @@ const struct option LONG_OPTIONS_GET_BUNDLENAMES_FOR_UID_EXT[] = {
     {nullptr, 0, nullptr, 0},
 };
 
-const std::string SHORT_OPTIONS_GET_SIMPLE_APP_INFO_FOR_UID = "hu:";
-const struct option LONG_OPTIONS_GET_SIMPLE_APP_INFO_FOR_UID[] = {
-    {"help", no_argument, nullptr, 'h'},
-    {"uid", required_argument, nullptr, 'u'},
-    {nullptr, 0, nullptr, 0},
-};
-
 const std::string SHORT_OPTIONS_SANDBOX = "hn:d:u:a:";
 const struct option LONG_OPTIONS_SANDBOX[] = {
     {"help", no_argument, nullptr, 'h'},
@@ -1370,6 +1393,7 @@ const struct option LONG_OPTIONS_QUICK_FIX[] = {
     {"bundle-name", required_argument, nullptr, 'n'},
     {"enable", required_argument, nullptr, 'e'},
     {"debug", required_argument, nullptr, 'd'},
+    {"multi-bundle", no_argument, nullptr, 'M'},
     {nullptr, 0, nullptr, 0},
 };
 
@@ -1414,6 +1438,15 @@ const struct option LONG_OPTIONS_GET_ALL_BUNDLE_STATS[] = {
     {nullptr, 0, nullptr, 0},
 };
 
+const std::string SHORT_OPTIONS_GET_EACH_BUNDLE_CACHE_STAT = "hu:j:b:";
+const struct option LONG_OPTIONS_GET_EACH_BUNDLE_CACHE_STAT[] = {
+    {"help", no_argument, nullptr, 'h'},
+    {"user-id", required_argument, nullptr, 'u'},
+    {"jobs", required_argument, nullptr, 'j'},
+    {"batch-size", required_argument, nullptr, 'b'},
+    {nullptr, 0, nullptr, 0},
+};
+
 const std::string SHORT_OPTIONS_GET_DISTRIBUTED_BUNDLE_NAME = "hn:a:";
 const struct option LONG_OPTIONS_GET_DISTRIBUTED_BUNDLE_NAME[] = {
     {"help", no_argument, nullptr, 'h'},
@@ -1677,29 +1710,101 @@ const struct option LONG_OPTIONS_CLEAN_ALL_BUNDLE_CACHE[] = {
     {nullptr, 0, nullptr, 0},
 };
 
-const std::string SHORT_OPTIONS_BATCH_GET_COMPATIBLE_DEVICE_TYPE = "hn:";
-const struct option LONG_OPTIONS_BATCH_GET_COMPATIBLE_DEVICE_TYPE[] = {
-    {"help", no_argument, nullptr, 'h'},
-    {"bundle-name", required_argument, nullptr, 'n'},
-    {nullptr, 0, nullptr, 0},
-};
-
-const std::string SHORT_OPTIONS_BATCH_GET_BUNDLE_INFO = "hn:f:u:";
+const std::string SHORT_OPTIONS_BATCH_GET_BUNDLE_INFO = "hn:f:u:sc:";
 const struct option LONG_OPTIONS_BATCH_GET_BUNDLE_INFO[] = {
     {"help", no_argument, nullptr, 'h'},
     {"bundle-name", required_argument, nullptr, 'n'},
     {"flags", required_argument, nullptr, 'f'},
     {"user-id", required_argument, nullptr, 'u'},
+    {"stream", no_argument, nullptr, 's'},
+    {"chunk-size", required_argument, nullptr, 'c'},
     {nullptr, 0, nullptr, 0},
 };
 
-const std::string SHORT_OPTIONS_PARSE_SPM_MODULE = "hp:";
-const struct option LONG_OPTIONS_PARSE_SPM_MODULE[] = {
-    {"help", no_argument, nullptr, 'h'},
-    {"module-json-path", required_argument, nullptr, 'p'},
-    {nullptr, 0, nullptr, 0},
+constexpr OptionField<SnapshotOptions> SNAPSHOT_OPTION_FIELDS[] = {
+    Int32Option('u', "user-id", &SnapshotOptions::userId, "user-id", 0, std::numeric_limits<int32_t>::max(),
+        "specify a user id"),
+    StringOption('f', "file", &SnapshotOptions::path, "file-path",
+        "specify the snapshot path, default is $BM_SNAPSHOT\nor /data/local/tmp/bm_bundle_snapshot"),
+    FlagOption('w', "watch", &SnapshotOptions::isWatch,
+        "rebuild the snapshot on every bundle event until interrupted"),
+    FlagOption('d', "delete", &SnapshotOptions::isDelete, "delete the snapshot"),
+};
+
+constexpr OptionSchema<SnapshotOptions> SNAPSHOT_OPTION_SCHEMA(
+    "usage: bundle_test_tool snapshot <options>\n"
+    "eg:bundle_test_tool snapshot -u <user-id> -f <file-path> -w\n"
+    "getUidByBundleName, isBundleInstalled, getCompatibleDeviceType and getApiTargetVersionByUid\n"
+    "read the snapshot instead of the service when the environment variable BM_SNAPSHOT is its path,\n"
+    "the snapshot is trusted only while its watcher started with -w is running\n",
+    SNAPSHOT_OPTION_FIELDS);
+
+struct ParseSpmModuleOptions {
+    std::vector<std::string> paths;
+};
+
+constexpr OptionField<ParseSpmModuleOptions> PARSE_SPM_MODULE_OPTION_FIELDS[] = {
+    StringListOption('p', "module-json-path", &ParseSpmModuleOptions::paths, "path",
+        "specify module.json file path, or a directory to search\nfor module.json files, can be repeated", true),
+};
+
+constexpr OptionSchema<ParseSpmModuleOptions> PARSE_SPM_MODULE_OPTION_SCHEMA(
+    "usage: bundle_test_tool parseSpmModule <options>\n"
+    "eg:bundle_test_tool parseSpmModule -p <module-json-path> -p <module-json-dir>\n",
+    PARSE_SPM_MODULE_OPTION_FIELDS);
+
+struct BatchQueryOptions {
+    // every value is a comma separated list
+    std::vector<std::string> keys;
+    int32_t jobs = DEFAULT_BATCH_QUERY_JOBS;
+    // 0 queries all the keys in one chunk
+    int32_t chunkSize = 0;
+    bool isLatency = false;
+};
+
+constexpr OptionField<BatchQueryOptions> BATCH_GET_COMPATIBLE_DEVICE_TYPE_OPTION_FIELDS[] = {
+    StringListOption('n', "bundle-name", &BatchQueryOptions::keys, "bundle-name",
+        "specify bundle names of the applications, separated by\ncommas, can be repeated", true),
+    Int32Option('j', "jobs", &BatchQueryOptions::jobs, "jobs", 1, MAX_BATCH_QUERY_JOBS,
+        "specify the number of concurrent queries, default is 4"),
+    Int32Option('c', "chunk-size", &BatchQueryOptions::chunkSize, "chunk-size", 1, MAX_BATCH_QUERY_CHUNK_SIZE,
+        "specify the bundle number of one query, default is all\nthe bundles in one query"),
+    FlagOption('l', "latency", &BatchQueryOptions::isLatency, "print the latency percentiles of the chunks"),
 };
 
+constexpr OptionSchema<BatchQueryOptions> BATCH_GET_COMPATIBLE_DEVICE_TYPE_OPTION_SCHEMA(
+    "usage: bundle_test_tool batchGetCompatibleDeviceType <option>\n"
+    "eg: bundle_test_tool batchGetCompatibleDeviceType -n <bundle-name>,<bundle-name>\n",
+    BATCH_GET_COMPATIBLE_DEVICE_TYPE_OPTION_FIELDS);
+
+constexpr OptionField<BatchQueryOptions> GET_SIMPLE_APP_INFO_FOR_UID_OPTION_FIELDS[] = {
+    StringListOption('u', "uid", &BatchQueryOptions::keys, "uid",
+        "specify uids of the applications, separated by commas,\ncan be repeated", true),
+    Int32Option('j', "jobs", &BatchQueryOptions::jobs, "jobs", 1, MAX_BATCH_QUERY_JOBS,
+        "specify the number of concurrent queries, default is 4"),
+    Int32Option('c', "chunk-size", &BatchQueryOptions::chunkSize, "chunk-size", 1, MAX_BATCH_QUERY_CHUNK_SIZE,
+        "specify the uid number of one query, default is all the\nuids in one query"),
+    FlagOption('l', "latency", &BatchQueryOptions::isLatency, "print the latency percentiles of the chunks"),
+};
+
+constexpr OptionSchema<BatchQueryOptions> GET_SIMPLE_APP_INFO_FOR_UID_OPTION_SCHEMA(
+    "usage: bundle_test_tool getSimpleAppInfoForUid <options>\n"
+    "eg:bundle_test_tool getSimpleAppInfoForUid -u <uid>,<uid>,<uid>...\n",
+    GET_SIMPLE_APP_INFO_FOR_UID_OPTION_FIELDS);
+
+void SplitBatchQueryKeys(const std::vector<std::string> &values, std::vector<std::string> &keys)
+{
+    for (const auto &value : values) {
+        std::stringstream stream(value);
+        std::string key;
+        while (std::getline(stream, key, ',')) {
+            if (!key.empty()) {
+                keys.emplace_back(key);
+            }
+        }
+    }
+}
+
 const std::string SHORT_OPTIONS_GET_MAIN_AND_CLONE_BUNDLE_INFO = "hn:f:u:";
 const struct option LONG_OPTIONS_GET_MAIN_AND_CLONE_BUNDLE_INFO[] = {
     {"help", no_argument, nullptr, 'h'},
@@ -1778,6 +1883,104 @@ const struct option LONG_OPTIONS_INSTALL_ENTERPRISE_RESIGN_CERT[] = {
     {nullptr, 0, nullptr, 0},
 };
 
+const std::string QUICK_FIX_FILE_SUFFIX = ".hqf";
+
+// a patch path is an hqf file or a directory of them
+bool ListQuickFixFiles(const std::string &quickFixPath, std::vector<std::string> &hqfFiles, std::string &errorMsg)
+{
+    std::string realPath;
+    struct stat pathStat;
+    if (!PathToRealPath(quickFixPath, realPath) || stat(realPath.c_str(), &pathStat) != 0) {
+        APP_LOGW("quickFixPath %{public}s is invalid", quickFixPath.c_str());
+        errorMsg = "path is invalid";
+        return false;
+    }
+    if (!S_ISDIR(pathStat.st_mode)) {
+        hqfFiles.emplace_back(realPath);
+        return true;
+    }
+    DIR *dir = opendir(realPath.c_str());
+    if (dir == nullptr) {
+        APP_LOGW("open dir %{private}s failed", realPath.c_str());
+        errorMsg = "failed to open dir";
+        return false;
+    }
+    size_t fileCount = hqfFiles.size();
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string fileName = entry->d_name;
+        if ((entry->d_type == DT_REG || entry->d_type == DT_UNKNOWN) && EndsWith(fileName, QUICK_FIX_FILE_SUFFIX)) {
+            hqfFiles.emplace_back(realPath + "/" + fileName);
+        }
+    }
+    closedir(dir);
+    if (hqfFiles.size() == fileCount) {
+        errorMsg = "no hqf file is found";
+        return false;
+    }
+    return true;
+}
+
+#ifdef BUNDLE_FRAMEWORK_QUICK_FIX
+// the hqf files of one bundle, copied by the copy thread and deployed by the main thread
+struct QuickFixDeployGroup {
+    std::string bundleName;
+    std::vector<std::string> paths;
+    std::vector<std::string> destFiles;
+    Completion<ErrCode> copied;
+    std::shared_ptr<QuickFixResult> quickFixRes;
+    ErrCode result = ERR_OK;
+    int64_t copyTime = 0;
+    int64_t deployTime = 0;
+};
+
+int64_t GetElapsedMs(const std::chrono::steady_clock::time_point &beginTime)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - beginTime).count();
+}
+
+// waits for the copy of the group, then deploys it while the copy thread moves on to the next group
+void DeployCopiedQuickFix(const sptr<IBundleMgr> &bundleMgrProxy, const sptr<IQuickFixManager> &quickFixProxy,
+    bool isDebug, QuickFixDeployGroup &group)
+{
+    ErrCode copyResult = ERR_OK;
+    if (group.copied.Wait(Deadline::Never(), copyResult) != CompletionSignal::WaitResult::READY) {
+        APP_LOGW("wait copy of %{public}s canceled", group.bundleName.c_str());
+        group.result = ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
+        return;
+    }
+    if (copyResult != ERR_OK) {
+        APP_LOGE("copy files of %{public}s failed with %{public}d", group.bundleName.c_str(), copyResult);
+        group.result = copyResult;
+        return;
+    }
+    auto deployBeginTime = std::chrono::steady_clock::now();
+    sptr<QuickFixStatusCallbackHostlmpl> callback(new (std::nothrow) QuickFixStatusCallbackHostlmpl());
+    if (callback == nullptr) {
+        APP_LOGE("callback is null");
+        group.result = ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
+        return;
+    }
+    sptr<BundleDeathRecipient> recipient(new (std::nothrow) BundleDeathRecipient(nullptr, callback));
+    if (recipient == nullptr) {
+        APP_LOGE("recipient is null");
+        group.result = ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
+        return;
+    }
+    bundleMgrProxy->AsObject()->AddDeathRecipient(recipient);
+    group.result = TracedCall("IQuickFixManager::DeployQuickFix", TraceCategory::IPC,
+        [&quickFixProxy, &group, &callback, isDebug] {
+            return quickFixProxy->DeployQuickFix(group.destFiles, callback, isDebug);
+        });
+    if (group.result == ERR_OK) {
+        group.result = callback->GetResultCode(group.quickFixRes);
+    }
+    bundleMgrProxy->AsObject()->RemoveDeathRecipient(recipient);
+    group.deployTime = GetElapsedMs(deployBeginTime);
+}
+#endif
+
 }  // namespace
 
 class ProcessCacheCallbackImpl : public ProcessCacheCallbackHost {
@@ -1798,10 +2001,8 @@ private:
     bool complete_ = false;
     int32_t cleanRet_ = 0;
     uint64_t cacheSize_ = 0;
-    std::promise<void> clean_;
-    std::future<void> cleanFuture_ = clean_.get_future();
-    std::promise<void> stat_;
-    std::future<void> statFuture_ = stat_.get_future();
+    Completion<int32_t> clean_;
+    Completion<uint64_t> stat_;
     DISALLOW_COPY_AND_MOVE(ProcessCacheCallbackImpl);
 };
 
@@ -1809,14 +2010,14 @@ uint64_t ProcessCacheCallbackImpl::GetCacheStat()
 {
     return cacheSize_;
 }
- 
+
 void ProcessCacheCallbackImpl::OnGetAllBundleCacheFinished(uint64_t cacheStat)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!complete_) {
         complete_ = true;
         cacheSize_ = cacheStat;
-        stat_.set_value();
+        stat_.SetValue(cacheStat);
     }
 }
 
@@ -1826,24 +2027,20 @@ void ProcessCacheCallbackImpl::OnCleanAllBundleCacheFinished(int32_t result)
     if (!complete_) {
         complete_ = true;
         cleanRet_ = result;
-        clean_.set_value();
+        clean_.SetValue(result);
     }
 }
 
 bool ProcessCacheCallbackImpl::WaitForCleanCompletion()
 {
-    if (cleanFuture_.wait_for(std::chrono::seconds(MAX_WAITING_TIME)) == std::future_status::ready) {
-        return true;
-    }
-    return false;
+    return clean_.Wait(Deadline::After(std::chrono::seconds(MAX_WAITING_TIME))) ==
+        CompletionSignal::WaitResult::READY;
 }
 
 bool ProcessCacheCallbackImpl::WaitForStatCompletion()
 {
-    if (statFuture_.wait_for(std::chrono::seconds(MAX_WAITING_TIME)) == std::future_status::ready) {
-        return true;
-    }
-    return false;
+    return stat_.Wait(Deadline::After(std::chrono::seconds(MAX_WAITING_TIME))) ==
+        CompletionSignal::WaitResult::READY;
 }
 
 class GetLargestItemsCallbackImpl : public GetLargestItemsCallbackHost {
@@ -1860,8 +2057,7 @@ private:
     bool complete_ = false;
     ErrCode errCode_ = 0;
     std::string result_;
-    std::promise<void> get_;
-    std::future<void> getFuture_ = get_.get_future();
+    CompletionSignal get_;
     DISALLOW_COPY_AND_MOVE(GetLargestItemsCallbackImpl);
 };
 
@@ -1873,7 +2069,7 @@ void GetLargestItemsCallbackImpl::OnGetLargestItemsFinished(
         complete_ = true;
         errCode_ = errCode;
         result_ = largestItems;
-        get_.set_value();
+        get_.Signal();
     }
 }
 
@@ -1891,10 +2087,8 @@ std::string GetLargestItemsCallbackImpl::GetResultMsg()
 
 bool GetLargestItemsCallbackImpl::WaitForGetCompletion()
 {
-    if (getFuture_.wait_for(std::chrono::seconds(MAX_WAITING_TIME)) == std::future_status::ready) {
-        return true;
-    }
-    return false;
+    return get_.Wait(Deadline::After(std::chrono::seconds(MAX_WAITING_TIME))) ==
+        CompletionSignal::WaitResult::READY;
 }
 
 BundleEventCallbackImpl::BundleEventCallbackImpl()
@@ -1902,6 +2096,12 @@ BundleEventCallbackImpl::BundleEventCallbackImpl()
     APP_LOGI("create BundleEventCallbackImpl");
 }
 
+BundleEventCallbackImpl::BundleEventCallbackImpl(const std::function<void(const std::string &)> &eventHandler)
+    : eventHandler_(eventHandler)
+{
+    APP_LOGI("create BundleEventCallbackImpl with event handler");
+}
+
 BundleEventCallbackImpl::~BundleEventCallbackImpl()
 {
     APP_LOGI("destroy BundleEventCallbackImpl");
@@ -1914,6 +2114,9 @@ void BundleEventCallbackImpl::OnReceiveEvent(const EventFwk::CommonEventData eve
     std::string moduleName = want.GetElement().GetModuleName();
     std::cout << "OnReceiveEvent " << bundleName << ", " << moduleName << std::endl;
     APP_LOGI("OnReceiveEvent, bundleName:%{public}s, moduleName:%{public}s", bundleName.c_str(), moduleName.c_str());
+    if (eventHandler_ != nullptr) {
+        eventHandler_(bundleName);
+    }
 }
 
 BundleTestTool::BundleTestTool(int argc, char *argv[]) : ShellCommand(argc, argv, TOOL_NAME)
@@ -2028,6 +2231,7 @@ ErrCode BundleTestTool::CreateCommandMap()
         {"setBundleFirstLaunch", std::bind(&BundleTestTool::RunAsSetBundleFirstLaunch, this)},
         {"getTopNLargestItemsInAppDataDir", std::bind(&BundleTestTool::RunAsGetTopNLargestItemsInAppDataDir, this)},
         {"batchGetBundleInfo", std::bind(&BundleTestTool::RunAsBatchGetBundleInfo, this)},
+        {"snapshot", std::bind(&BundleTestTool::RunAsSnapshotCommand, this)},
         {"parseSpmModule", std::bind(&BundleTestTool::RunAsParseSpmModule, this)},
         {"implicitQueryInfos", std::bind(&BundleTestTool::RunAsImplicitQueryInfos, this)},
         {"queryAbilityInfo", std::bind(&BundleTestTool::RunAsQueryAbilityInfo, this)},
@@ -2059,10 +2263,14 @@ ErrCode BundleTestTool::Init()
         bundleMgrProxy_ = BundleCommandCommon::GetBundleMgrProxy();
         if (bundleMgrProxy_ != nullptr) {
             if (bundleInstallerProxy_ == nullptr) {
-                bundleInstallerProxy_ = bundleMgrProxy_->GetBundleInstaller();
+                bundleInstallerProxy_ = TracedCall("IBundleMgr::GetBundleInstaller", TraceCategory::PROXY, [&]() {
+                    return bundleMgrProxy_->GetBundleInstaller();
+                });
             }
             if (bundleResourceProxy_ == nullptr) {
-                bundleResourceProxy_ = bundleMgrProxy_->GetBundleResourceProxy();
+                bundleResourceProxy_ = TracedCall("IBundleMgr::GetBundleResourceProxy", TraceCategory::PROXY, [&]() {
+                    return bundleMgrProxy_->GetBundleResourceProxy();
+                });
             }
         }
     }
@@ -4539,6 +4747,7 @@ ErrCode BundleTestTool::RunAsDeployQuickFix()
     int32_t index = 0;
     std::vector<std::string> quickFixPaths;
     int32_t isDebug = 0;
+    bool isMultiBundle = false;
     while (true) {
         counter++;
         int32_t option = getopt_long(argc_, argv_, SHORT_OPTIONS_QUICK_FIX.c_str(), LONG_OPTIONS_QUICK_FIX, nullptr);
@@ -4573,6 +4782,10 @@ ErrCode BundleTestTool::RunAsDeployQuickFix()
             APP_LOGD("'bm deployQuickFix -d %{public}s'", argv_[optind - 1]);
             continue;
         }
+        if (option == 'M') {
+            isMultiBundle = true;
+            continue;
+        }
 
         result = OHOS::ERR_INVALID_VALUE;
         break;
@@ -4583,6 +4796,13 @@ ErrCode BundleTestTool::RunAsDeployQuickFix()
         return result;
     }
 
+    if (isMultiBundle) {
+        std::string resultMsg;
+        result = DeployQuickFixByBundle(quickFixPaths, isDebug != 0, resultMsg);
+        resultReceiver_ = (result == OHOS::ERR_OK) ? STRING_DEPLOY_QUICK_FIX_OK : STRING_DEPLOY_QUICK_FIX_NG;
+        resultReceiver_ += resultMsg;
+        return result;
+    }
     std::shared_ptr<QuickFixResult> deployRes = nullptr;
     result = DeployQuickFix(quickFixPaths, deployRes, isDebug != 0);
     resultReceiver_ = (result == OHOS::ERR_OK) ? STRING_DEPLOY_QUICK_FIX_OK : STRING_DEPLOY_QUICK_FIX_NG;
@@ -4763,6 +4983,102 @@ ErrCode BundleTestTool::DeployQuickFix(const std::vector<std::string> &quickFixP
 #endif
 }
 
+ErrCode BundleTestTool::DeployQuickFixByBundle(const std::vector<std::string> &quickFixPaths, bool isDebug,
+    std::string &resultMsg)
+{
+#ifdef BUNDLE_FRAMEWORK_QUICK_FIX
+    auto beginTime = std::chrono::steady_clock::now();
+    std::map<std::string, std::set<std::string>> groupedPaths;
+    std::string errorMsg;
+    if (!GroupQuickFixPathsByBundle(quickFixPaths, groupedPaths, errorMsg) || groupedPaths.empty()) {
+        resultMsg = GetResMsg(ERR_BUNDLEMANAGER_QUICK_FIX_PARAM_ERROR) + errorMsg;
+        return ERR_BUNDLEMANAGER_QUICK_FIX_PARAM_ERROR;
+    }
+    if (bundleMgrProxy_ == nullptr) {
+        APP_LOGE("bundleMgrProxy is null");
+        resultMsg = GetResMsg(ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR);
+        return ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
+    }
+    auto quickFixProxy = TracedCall("IBundleMgr::GetQuickFixManagerProxy", TraceCategory::PROXY,
+        [this] { return bundleMgrProxy_->GetQuickFixManagerProxy(); });
+    if (quickFixProxy == nullptr) {
+        APP_LOGE("quickFixProxy is null");
+        resultMsg = GetResMsg(ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR);
+        return ERR_BUNDLEMANAGER_QUICK_FIX_INTERNAL_ERROR;
+    }
+    std::vector<QuickFixDeployGroup> groups(groupedPaths.size());
+    size_t index = 0;
+    for (const auto &item : groupedPaths) {
+        groups[index].bundleName = item.first;
+        groups[index].paths.assign(item.second.begin(), item.second.end());
+        ++index;
+    }
+    // the copies stream in group order, so the deploy of a group overlaps the copies of the following ones
+    std::thread copyThread([&groups, &quickFixProxy] {
+        for (auto &group : groups) {
+            auto copyBeginTime = std::chrono::steady_clock::now();
+            ErrCode ret = TracedCall("IQuickFixManager::CopyFiles", TraceCategory::IPC,
+                [&quickFixProxy, &group] { return quickFixProxy->CopyFiles(group.paths, group.destFiles); });
+            group.copyTime = GetElapsedMs(copyBeginTime);
+            group.copied.SetValue(ret);
+        }
+    });
+    for (auto &group : groups) {
+        DeployCopiedQuickFix(bundleMgrProxy_, quickFixProxy, isDebug, group);
+    }
+    copyThread.join();
+
+    ErrCode result = ERR_OK;
+    size_t failCount = 0;
+    for (const auto &group : groups) {
+        resultMsg.append("bundle name: " + group.bundleName + ", hqf count: " + std::to_string(group.paths.size()));
+        resultMsg.append(", result: " + std::string(group.result == ERR_OK ? "success" : "failed"));
+        resultMsg.append(", copy: " + std::to_string(group.copyTime) + "ms, deploy: " +
+            std::to_string(group.deployTime) + "ms\n");
+        if (group.result == ERR_OK) {
+            continue;
+        }
+        ++failCount;
+        result = (result == ERR_OK) ? group.result : result;
+        resultMsg.append(GetResMsg(group.result, group.quickFixRes));
+    }
+    resultMsg.append("bundle count: " + std::to_string(groups.size()) + "\n");
+    resultMsg.append("success count: " + std::to_string(groups.size() - failCount) + "\n");
+    resultMsg.append("fail count: " + std::to_string(failCount) + "\n");
+    resultMsg.append("wall time: " + std::to_string(GetElapsedMs(beginTime)) + "ms\n");
+    return result;
+#else
+    resultMsg = GetResMsg(ERR_BUNDLEMANAGER_FEATURE_IS_NOT_SUPPORTED);
+    return ERR_BUNDLEMANAGER_FEATURE_IS_NOT_SUPPORTED;
+#endif
+}
+
+bool BundleTestTool::GroupQuickFixPathsByBundle(const std::vector<std::string> &quickFixPaths,
+    std::map<std::string, std::set<std::string>> &groupedPaths, std::string &errorMsg)
+{
+    // a directory may hold the patches of many bundles and the patches of a bundle may come from many directories
+    bool isValid = true;
+    for (const auto &quickFixPath : quickFixPaths) {
+        std::vector<std::string> hqfFiles;
+        std::string pathErrorMsg;
+        if (!ListQuickFixFiles(quickFixPath, hqfFiles, pathErrorMsg)) {
+            errorMsg.append(quickFixPath + ": " + pathErrorMsg + "\n");
+            isValid = false;
+            continue;
+        }
+        for (const auto &hqfFile : hqfFiles) {
+            std::string bundleName;
+            if (!HapVerifier::GetQuickFixBundleName(hqfFile, bundleName, pathErrorMsg)) {
+                errorMsg.append(hqfFile + ": " + pathErrorMsg + "\n");
+                isValid = false;
+                continue;
+            }
+            groupedPaths[bundleName].insert(hqfFile);
+        }
+    }
+    return isValid;
+}
+
 ErrCode BundleTestTool::SwitchQuickFix(const std::string &bundleName, int32_t enable,
     std::shared_ptr<QuickFixResult> &quickFixRes)
 {
@@ -5101,75 +5417,6 @@ ErrCode BundleTestTool::BatchBundleNameAndUserIdCommonFunc(std::vector<std::stri
     return result;
 }
 
-ErrCode BundleTestTool::BatchBundleNameCommonFunc(
-    std::string short_option, const struct option *long_options,
-    std::vector<std::string> &bundleNames)
-{
-    int32_t result = OHOS::ERR_OK;
-    int32_t counter = 0;
-    while (true) {
-        counter++;
-        int32_t option = getopt_long(argc_, argv_, short_option.c_str(),
-            long_options, nullptr);
-        APP_LOGD("option: %{public}d, optopt: %{public}d, optind: %{public}d", option, optopt, optind);
-        if (optind < 0 || optind > argc_) {
-            return OHOS::ERR_INVALID_VALUE;
-        }
-        if (option == -1) {
-            if (counter == 1) {
-                if (strcmp(argv_[optind], cmd_.c_str()) == 0) {
-                    resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
-                    result = OHOS::ERR_INVALID_VALUE;
-                }
-            }
-            break;
-        }
-        if (option == '?') {
-            switch (optopt) {
-                case 'n': {
-                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
-                    result = OHOS::ERR_INVALID_VALUE;
-                    break;
-                }
-                default: {
-                    std::string unknownOption = "";
-                    std::string unknownOptionMsg = GetUnknownOptionMsg(unknownOption);
-                    resultReceiver_.append(unknownOptionMsg);
-                    result = OHOS::ERR_INVALID_VALUE;
-                    break;
-                }
-            }
-            break;
-        }
-
-        switch (option) {
-            case 'n': {
-                std::string names = optarg;
-                std::stringstream ss(names);
-                std::string name;
-                while (std::getline(ss, name, ',')) {
-                    if (!name.empty()) {
-                        APP_LOGD("bundleName: %{public}s", name.c_str());
-                        bundleNames.emplace_back(name);
-                    }
-                }
-                break;
-            }
-            default: {
-                result = OHOS::ERR_INVALID_VALUE;
-                break;
-            }
-        }
-    }
-    if (result == OHOS::ERR_OK) {
-        if (bundleNames.empty()) {
-            resultReceiver_.append(HELP_MSG_NO_BUNDLE_NAME_OPTION + "\n");
-            return OHOS::ERR_INVALID_VALUE;
-        }
-    }
-    return result;
-}
-
 ErrCode BundleTestTool::RunAsGetBundleStats()
 {
     std::string bundleName;
@@ -5368,64 +5615,194 @@ bool BundleTestTool::GetAllBundleStats(int32_t userId, std::string &msg)
     return ret;
 }
 
-bool BundleTestTool::GetEachBundleCacheStat(int32_t userId, std::string &msg)
+ErrCode BundleTestTool::EachBundleCacheStatCommonFunc(int32_t &userId, int32_t &jobs, int32_t &batchSize)
 {
-    if (bundleMgrProxy_ == nullptr) {
-        APP_LOGE("bundleMgrProxy_ is nullptr");
-        return false;
-    }
-    userId = BundleCommandCommon::GetCurrentUserId(userId);
-    std::vector<BundleInfo> bundleInfos;
-    bool ret = bundleMgrProxy_->GetBundleInfos(
-        static_cast<int32_t>(GetBundleInfoFlag::GET_BUNDLE_INFO_WITH_DISABLE), bundleInfos, userId);
-    if (!ret) {
-        msg += "error: get bundle infos failed\n";
-        return false;
-    }
-
-    uint32_t statFlag = Constants::NoGetBundleStatsFlag::GET_BUNDLE_WITHOUT_INSTALL_SIZE |
-        Constants::NoGetBundleStatsFlag::GET_BUNDLE_WITHOUT_DATA_SIZE;
-    bool allSucceeded = true;
-    int64_t totalCacheSize = 0;
-    size_t successCount = 0;
-    size_t failCount = 0;
-    for (const auto &bundleInfo : bundleInfos) {
-        std::vector<int64_t> bundleStats;
-        bool statRet = bundleMgrProxy_->GetBundleStats(
-            bundleInfo.name, userId, bundleStats, bundleInfo.appIndex, statFlag);
-        if (!statRet || bundleStats.size() < BUNDLE_STATS_MIN_SIZE) {
-            allSucceeded = false;
-            ++failCount;
-            msg += "bundleName: " + bundleInfo.name + ", appIndex: " + std::to_string(bundleInfo.appIndex) +
-                ", error: get bundle stats failed\n";
-            APP_LOGW("get bundle cache stat failed, bundleName: %{public}s, appIndex: %{public}d",
-                bundleInfo.name.c_str(), bundleInfo.appIndex);
-            continue;
+    int32_t result = OHOS::ERR_OK;
+    int32_t counter = 0;
+    userId = Constants::UNSPECIFIED_USERID;
+    jobs = DEFAULT_CACHE_STAT_JOBS;
+    batchSize = 0;
+    while (true) {
+        counter++;
+        int32_t option = getopt_long(argc_, argv_, SHORT_OPTIONS_GET_EACH_BUNDLE_CACHE_STAT.c_str(),
+            LONG_OPTIONS_GET_EACH_BUNDLE_CACHE_STAT, nullptr);
+        APP_LOGD("option: %{public}d, optopt: %{public}d, optind: %{public}d", option, optopt, optind);
+        if (optind < 0 || optind > argc_) {
+            return OHOS::ERR_INVALID_VALUE;
+        }
+        if (option == -1) {
+            if (counter == 1) {
+                if (strcmp(argv_[optind], cmd_.c_str()) == 0) {
+                    resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
+                    result = OHOS::ERR_INVALID_VALUE;
+                }
+            }
+            break;
         }
-        int64_t cacheSize = bundleStats[BUNDLE_STATS_CACHE_INDEX];
-        totalCacheSize += cacheSize;
-        ++successCount;
-        msg += "bundleName: " + bundleInfo.name + ", appIndex: " + std::to_string(bundleInfo.appIndex) +
-            ", cache size: " + std::to_string(cacheSize) + "\n";
-        APP_LOGD("bundle cache stat, bundleName: %{public}s, appIndex: %{public}d, cacheSize: %{public}lld",
-            bundleInfo.name.c_str(), bundleInfo.appIndex, static_cast<long long>(cacheSize));
-    }
-    msg += "success count: " + std::to_string(successCount) + "\n";
-    msg += "fail count: " + std::to_string(failCount) + "\n";
-    msg += "total cache size: " + std::to_string(totalCacheSize) + "\n";
-    return allSucceeded;
-}
 
-ErrCode BundleTestTool::RunAsGetAllBundleStats()
-{
-    int32_t userId = 0;
-    int32_t result = UserIdCommonFunc(userId);
-    if (result != OHOS::ERR_OK) {
-        resultReceiver_.append(HELP_MSG_GET_ALL_BUNDLE_STATS);
-    } else {
-        std::string msg;
-        bool ret = GetAllBundleStats(userId, msg);
-        if (ret) {
+        if (option == '?') {
+            switch (optopt) {
+                case 'u':
+                case 'j':
+                case 'b': {
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
+                default: {
+                    std::string unknownOption = "";
+                    std::string unknownOptionMsg = GetUnknownOptionMsg(unknownOption);
+                    resultReceiver_.append(unknownOptionMsg);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
+            }
+            break;
+        }
+
+        switch (option) {
+            case 'u': {
+                if (!OHOS::StrToInt(optarg, userId) || userId < 0) {
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                break;
+            }
+            case 'j': {
+                if (!OHOS::StrToInt(optarg, jobs) || jobs < 1 || jobs > MAX_CACHE_STAT_JOBS) {
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                break;
+            }
+            case 'b': {
+                if (!OHOS::StrToInt(optarg, batchSize) || batchSize < 1 || batchSize > MAX_CACHE_STAT_BATCH_SIZE) {
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                break;
+            }
+            default: {
+                result = OHOS::ERR_INVALID_VALUE;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+void BundleTestTool::GetBundleCacheStatsByBatch(const std::vector<BundleInfo> &bundleInfos, int32_t userId,
+    int32_t batchSize, std::vector<int64_t> &cacheSizes)
+{
+    // batchGetBundleStats has no appIndex, only the main bundles are queried by it
+    std::vector<size_t> mainIndexes;
+    for (size_t index = 0; index < bundleInfos.size(); ++index) {
+        if (bundleInfos[index].appIndex == 0) {
+            mainIndexes.emplace_back(index);
+        }
+    }
+    for (size_t begin = 0; begin < mainIndexes.size(); begin += static_cast<size_t>(batchSize)) {
+        size_t end = std::min(mainIndexes.size(), begin + static_cast<size_t>(batchSize));
+        std::vector<std::string> bundleNames;
+        bundleNames.reserve(end - begin);
+        std::unordered_map<std::string, size_t> nameIndexes;
+        for (size_t i = begin; i < end; ++i) {
+            const std::string &bundleName = bundleInfos[mainIndexes[i]].name;
+            bundleNames.emplace_back(bundleName);
+            nameIndexes.emplace(bundleName, mainIndexes[i]);
+        }
+        std::vector<BundleStorageStats> bundleStats;
+        ErrCode ret = bundleMgrProxy_->BatchGetBundleStats(bundleNames, userId, bundleStats);
+        if (ret != ERR_OK) {
+            // the bundles of the failed chunk are retried one by one by the worker pool, the next chunks are still
+            // queried in batch
+            APP_LOGW("batch get bundle stats failed %{public}d", ret);
+            for (size_t i = begin; i < end; ++i) {
+                cacheSizes[mainIndexes[i]] = INVALID_CACHE_SIZE;
+            }
+            continue;
+        }
+        for (const auto &stats : bundleStats) {
+            auto iter = nameIndexes.find(stats.bundleName);
+            if (iter == nameIndexes.end() || stats.errCode != ERR_OK ||
+                stats.bundleStats.size() < BUNDLE_STATS_MIN_SIZE) {
+                continue;
+            }
+            cacheSizes[iter->second] = stats.bundleStats[BUNDLE_STATS_CACHE_INDEX];
+        }
+    }
+}
+
+bool BundleTestTool::GetEachBundleCacheStat(int32_t userId, std::string &msg, int32_t jobs, int32_t batchSize)
+{
+    if (bundleMgrProxy_ == nullptr) {
+        APP_LOGE("bundleMgrProxy_ is nullptr");
+        return false;
+    }
+    userId = BundleCommandCommon::GetCurrentUserId(userId);
+    std::vector<BundleInfo> bundleInfos;
+    bool ret = bundleMgrProxy_->GetBundleInfos(
+        static_cast<int32_t>(GetBundleInfoFlag::GET_BUNDLE_INFO_WITH_DISABLE), bundleInfos, userId);
+    if (!ret) {
+        msg += "error: get bundle infos failed\n";
+        return false;
+    }
+
+    // every worker writes only its own slot, so the result keeps the bundle order without any lock
+    std::vector<int64_t> cacheSizes(bundleInfos.size(), INVALID_CACHE_SIZE);
+    if (batchSize > 0) {
+        GetBundleCacheStatsByBatch(bundleInfos, userId, batchSize, cacheSizes);
+    }
+    uint32_t statFlag = Constants::NoGetBundleStatsFlag::GET_BUNDLE_WITHOUT_INSTALL_SIZE |
+        Constants::NoGetBundleStatsFlag::GET_BUNDLE_WITHOUT_DATA_SIZE;
+    BundleCommandCommon::ParallelFor(bundleInfos.size(), jobs,
+        [this, &bundleInfos, &cacheSizes, userId, statFlag](size_t index) {
+            if (cacheSizes[index] != INVALID_CACHE_SIZE) {
+                return;
+            }
+            const BundleInfo &bundleInfo = bundleInfos[index];
+            std::vector<int64_t> bundleStats;
+            bool statRet = bundleMgrProxy_->GetBundleStats(
+                bundleInfo.name, userId, bundleStats, bundleInfo.appIndex, statFlag);
+            if (!statRet || bundleStats.size() < BUNDLE_STATS_MIN_SIZE) {
+                APP_LOGW("get bundle cache stat failed, bundleName: %{public}s, appIndex: %{public}d",
+                    bundleInfo.name.c_str(), bundleInfo.appIndex);
+                return;
+            }
+            cacheSizes[index] = bundleStats[BUNDLE_STATS_CACHE_INDEX];
+        });
+
+    int64_t totalCacheSize = 0;
+    size_t successCount = 0;
+    TextBuilder builder(msg, bundleInfos.size() * BUNDLE_CACHE_STAT_LINE_SIZE);
+    for (size_t index = 0; index < bundleInfos.size(); ++index) {
+        const BundleInfo &bundleInfo = bundleInfos[index];
+        builder.Append("bundleName: ", bundleInfo.name, ", appIndex: ", bundleInfo.appIndex);
+        if (cacheSizes[index] == INVALID_CACHE_SIZE) {
+            builder.AppendLine(", error: get bundle stats failed");
+            continue;
+        }
+        totalCacheSize += cacheSizes[index];
+        ++successCount;
+        builder.AppendLine(", cache size: ", cacheSizes[index]);
+    }
+    size_t failCount = bundleInfos.size() - successCount;
+    builder.AppendLine("success count: ", successCount);
+    builder.AppendLine("fail count: ", failCount);
+    builder.AppendLine("total cache size: ", totalCacheSize);
+    return failCount == 0;
+}
+
+ErrCode BundleTestTool::RunAsGetAllBundleStats()
+{
+    int32_t userId = 0;
+    int32_t result = UserIdCommonFunc(userId);
+    if (result != OHOS::ERR_OK) {
+        resultReceiver_.append(HELP_MSG_GET_ALL_BUNDLE_STATS);
+    } else {
+        std::string msg;
+        bool ret = GetAllBundleStats(userId, msg);
+        if (ret) {
             resultReceiver_ = STRING_GET_ALL_BUNDLE_STATS_OK + msg;
         } else {
             resultReceiver_ = STRING_GET_ALL_BUNDLE_STATS_NG + "\n";
@@ -5437,12 +5814,14 @@ ErrCode BundleTestTool::RunAsGetAllBundleStats()
 ErrCode BundleTestTool::RunAsGetEachBundleCacheStat()
 {
     int32_t userId = 0;
-    int32_t result = UserIdCommonFunc(userId);
+    int32_t jobs = DEFAULT_CACHE_STAT_JOBS;
+    int32_t batchSize = 0;
+    int32_t result = EachBundleCacheStatCommonFunc(userId, jobs, batchSize);
     if (result != OHOS::ERR_OK) {
         resultReceiver_.append(HELP_MSG_GET_EACH_BUNDLE_CACHE_STAT);
     } else {
         std::string msg;
-        bool ret = GetEachBundleCacheStat(userId, msg);
+        bool ret = GetEachBundleCacheStat(userId, msg, jobs, batchSize);
         if (ret) {
             resultReceiver_ = STRING_GET_EACH_BUNDLE_CACHE_STAT_OK + msg;
         } else {
@@ -6353,6 +6732,12 @@ ErrCode BundleTestTool::RunGetUidByBundleName()
     if (result != OHOS::ERR_OK) {
         resultReceiver_.append(HELP_MSG_NO_GET_UID_BY_BUNDLENAME);
     } else {
+        BundleSnapshotRecord record;
+        if (FindInBundleSnapshot(bundleName, userId, appIndex, record)) {
+            resultReceiver_.append(std::to_string(record.uid));
+            resultReceiver_.append("\n");
+            return result;
+        }
         int32_t res = bundleMgrProxy_->GetUidByBundleName(bundleName, userId, appIndex);
         if (res == -1) {
             resultReceiver_.append(STRING_GET_UID_BY_BUNDLENAME_NG);
@@ -6404,6 +6789,13 @@ ErrCode BundleTestTool::RunGetApiTargetVersionByUid()
         if (withPermission) {
             ReloadNativeTokenInfo();
         }
+        BundleSnapshot snapshot;
+        BundleSnapshotRecord record;
+        std::string snapshotPath = BundleSnapshot::GetPathFromEnv();
+        if (!snapshotPath.empty() && snapshot.Open(snapshotPath) && snapshot.FindByUid(uid, record)) {
+            resultReceiver_.append("Api target version: " + std::to_string(record.apiTargetVersion) + "\n");
+            return result;
+        }
         int32_t apiTargetVersion = 0;
         ErrCode ret = bundleMgrProxy_->GetApiTargetVersionByUid(uid, apiTargetVersion);
         if (ret != ERR_OK) {
@@ -7656,13 +8048,14 @@ ErrCode BundleTestTool::GetAllBundleDirs(int32_t userId, std::string& msg)
     std::vector<BundleDir> bundleDirs;
     auto ret = client.GetAllBundleDirs(userId, bundleDirs);
     if (ret == ERR_OK) {
-        msg = "bundleDirs:\n{\n";
+        msg.clear();
+        TextBuilder builder(msg, bundleDirs.size() * BUNDLE_DIR_LINE_SIZE);
+        builder.AppendLine("bundleDirs:");
+        builder.AppendLine("{");
         for (const auto &bundleDir: bundleDirs) {
-            msg +="     ";
-            msg += bundleDir.ToString();
-            msg += "\n";
+            builder.AppendLine(LIST_ITEM_INDENT, bundleDir.ToString());
         }
-        msg += "}\n";
+        builder.AppendLine("}");
     }
     return ret;
 }
@@ -7705,7 +8098,8 @@ ErrCode BundleTestTool::RunAsGetAllJsonProfile()
         std::string msg;
         result = GetAllJsonProfile(static_cast<ProfileType>(profileType), userId, msg);
         if (result == ERR_OK) {
-            resultReceiver_.append(STRING_GET_ALL_JSON_PROFILE_OK + msg);
+            WriteOutput(std::string(STRING_GET_ALL_JSON_PROFILE_OK));
+            WriteOutput(std::move(msg));
         } else {
             resultReceiver_.append(STRING_GET_ALL_JSON_PROFILE_NG + "errCode is "+ std::to_string(result) + "\n");
         }
@@ -7723,13 +8117,14 @@ ErrCode BundleTestTool::GetAllJsonProfile(ProfileType profileType, int32_t userI
     std::vector<JsonProfileInfo> profileInfos;
     auto ret = bundleMgrProxy_->GetAllJsonProfile(profileType, userId, profileInfos);
     if (ret == ERR_OK) {
-        msg = "JsonProfileInfos:\n{\n";
+        msg.clear();
+        TextBuilder builder(msg, profileInfos.size() * JSON_PROFILE_LINE_SIZE);
+        builder.AppendLine("JsonProfileInfos:");
+        builder.AppendLine("{");
         for (const auto &info: profileInfos) {
-            msg +="     ";
-            msg += info.ToString();
-            msg += "\n";
+            builder.AppendLine(LIST_ITEM_INDENT, info.ToString());
         }
-        msg += "}\n";
+        builder.AppendLine("}");
     }
     return ret;
 }
@@ -8283,6 +8678,12 @@ ErrCode BundleTestTool::RunAsIsBundleInstalled()
         resultReceiver_.append(HELP_MSG_IS_BUNDLE_INSTALLED);
     } else {
         bool isBundleInstalled = false;
+        BundleSnapshotRecord record;
+        if (FindInBundleSnapshot(bundleName, userId, appIndex, record)) {
+            resultReceiver_.append(STRING_IS_BUNDLE_INSTALLED_OK);
+            resultReceiver_.append("isBundleInstalled: true\n");
+            return result;
+        }
         result = bundleMgrProxy_->IsBundleInstalled(bundleName, userId, appIndex, isBundleInstalled);
         if (result == ERR_OK) {
             resultReceiver_.append(STRING_IS_BUNDLE_INSTALLED_OK);
@@ -8330,6 +8731,14 @@ ErrCode BundleTestTool::RunAsGetCompatibleDeviceType()
         resultReceiver_.append(HELP_MSG_GET_COMPATIBLE_DEVICE_TYPE);
     } else {
         std::string deviceType;
+        BundleSnapshotRecord record;
+        int32_t userId = BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID);
+        if (FindInBundleSnapshot(bundleName, userId, 0, record) && !record.deviceType.empty()) {
+            resultReceiver_.append(STRING_GET_COMPATIBLE_DEVICE_TYPE_OK);
+            resultReceiver_.append("deviceType: ");
+            resultReceiver_.append(record.deviceType + "\n");
+            return result;
+        }
         result = bundleMgrProxy_->GetCompatibleDeviceType(bundleName, deviceType);
         if (result == ERR_OK) {
             resultReceiver_.append(STRING_GET_COMPATIBLE_DEVICE_TYPE_OK);
@@ -8346,108 +8755,173 @@ ErrCode BundleTestTool::RunAsBatchGetCompatibleDeviceType()
 {
     APP_LOGI("RunAsBatchGetCompatibleDeviceType start");
     ReloadNativeTokenInfo();
+    BatchQueryOptions options;
+    std::string errorOption;
+    OptionParseResult parseResult = BATCH_GET_COMPATIBLE_DEVICE_TYPE_OPTION_SCHEMA.Parse(argc_, argv_, INDEX_OFFSET,
+        options, errorOption);
+    bool isValid = CheckOptionParseResult(parseResult, errorOption);
     std::vector<std::string> bundleNames;
-    int32_t result = BatchBundleNameCommonFunc(
-        SHORT_OPTIONS_BATCH_GET_COMPATIBLE_DEVICE_TYPE,
-        LONG_OPTIONS_BATCH_GET_COMPATIBLE_DEVICE_TYPE,
-        bundleNames);
-    if (result != OHOS::ERR_OK) {
-        resultReceiver_.append(HELP_MSG_BATCH_GET_COMPATIBLE_DEVICE_TYPE);
-    } else {
-        std::string msg;
-        std::vector<BundleCompatibleDeviceType> compatibleDeviceTypes;
-        result = bundleMgrProxy_->BatchGetCompatibleDeviceType(bundleNames, compatibleDeviceTypes);
-        if (result == ERR_OK) {
-            nlohmann::json jsonResult = nlohmann::json::array();
-            for (const auto &compatibleDeviceType : compatibleDeviceTypes) {
-                nlohmann::json rowData;
-                rowData["bundleName"] = compatibleDeviceType.bundleName;
-                if (compatibleDeviceType.errCode == ERR_OK) {
-                    rowData["compatibleDeviceType"] = compatibleDeviceType.compatibleDeviceType;
-                } else {
-                    rowData["errCode"] = compatibleDeviceType.errCode;
-                }
-                jsonResult.push_back(rowData);
-            }
-            msg = jsonResult.dump() + "\n";
-            resultReceiver_.append(msg);
-        }   else {
-            resultReceiver_.append(STRING_BATCH_GET_COMPATIBLE_DEVICE_TYPE_NG +
-                                   "errCode is " + std::to_string(result) +
-                                   "\n");
-        }
+    SplitBatchQueryKeys(options.keys, bundleNames);
+    if (isValid && bundleNames.empty()) {
+        resultReceiver_.append(HELP_MSG_NO_BUNDLE_NAME_OPTION + "\n");
+        isValid = false;
+    }
+    if (!isValid) {
+        resultReceiver_.append(BATCH_GET_COMPATIBLE_DEVICE_TYPE_OPTION_SCHEMA.GetHelp());
+        return OHOS::ERR_INVALID_VALUE;
     }
-    return result;
-}
 
-ErrCode BundleTestTool::InnerGetSimpleAppInfoForUid(const int32_t &option, std::vector<std::int32_t> &uids)
-{
-    std::string commandName = "getSimpleAppInfoForUid";
-    int32_t uid = Constants::FOUNDATION_UID;
-    switch (option) {
-        case 'u': {
-            std::string arrayUId = optarg;
-            std::stringstream array(arrayUId);
-            std::string object;
-            bool ret = true;
-            while (getline(array, object, ',')) {
-                StringToInt(object, commandName, uid, ret);
-                if (!ret) {
-                    resultReceiver_.append(HELP_MSG_GET_SIMPLE_APP_INFO_FOR_UID);
-                    return OHOS::ERR_INVALID_VALUE;
-                }
-                uids.emplace_back(uid);
+    std::vector<std::string> uniqueNames;
+    std::vector<size_t> uniqueIndexes = BatchQueryEngine::Deduplicate(bundleNames, uniqueNames);
+    std::unordered_map<std::string, size_t> nameIndexes;
+    std::vector<BundleCompatibleDeviceType> deviceTypes(uniqueNames.size());
+    for (size_t i = 0; i < uniqueNames.size(); ++i) {
+        nameIndexes.emplace(uniqueNames[i], i);
+        deviceTypes[i].bundleName = uniqueNames[i];
+        // a bundle left out of the reply keeps this error
+        deviceTypes[i].errCode = OHOS::ERR_INVALID_VALUE;
+    }
+    // every chunk writes only the slots of its own bundles
+    std::vector<ErrCode> queryResults(uniqueNames.size(), ERR_OK);
+    BatchQueryEngine engine(options.jobs, static_cast<size_t>(options.chunkSize));
+    engine.Run(uniqueNames.size(), [this, &uniqueNames, &nameIndexes, &deviceTypes, &queryResults](
+        size_t begin, size_t end) {
+        std::vector<std::string> chunkNames(uniqueNames.begin() + begin, uniqueNames.begin() + end);
+        std::vector<BundleCompatibleDeviceType> chunkDeviceTypes;
+        ErrCode ret = TracedCall("IBundleMgr::BatchGetCompatibleDeviceType", TraceCategory::IPC, [&]() {
+            return bundleMgrProxy_->BatchGetCompatibleDeviceType(chunkNames, chunkDeviceTypes);
+        });
+        if (ret != ERR_OK) {
+            APP_LOGW("batch get compatible device type failed %{public}d", ret);
+            std::fill(queryResults.begin() + begin, queryResults.begin() + end, ret);
+            return;
+        }
+        for (const auto &deviceType : chunkDeviceTypes) {
+            auto iter = nameIndexes.find(deviceType.bundleName);
+            if (iter != nameIndexes.end() && iter->second >= begin && iter->second < end) {
+                deviceTypes[iter->second] = deviceType;
             }
-            APP_LOGD("bundle_test_tool %{public}s -u %{public}s", commandName.c_str(), argv_[optind - 1]);
-            break;
         }
-        default: {
-            resultReceiver_.append(HELP_MSG_GET_SIMPLE_APP_INFO_FOR_UID);
-            return OHOS::ERR_INVALID_VALUE;
+    });
+    auto failedIter = std::find_if(queryResults.begin(), queryResults.end(),
+        [](ErrCode ret) { return ret != ERR_OK; });
+    if (std::all_of(queryResults.begin(), queryResults.end(), [](ErrCode ret) { return ret != ERR_OK; })) {
+        resultReceiver_.append(STRING_BATCH_GET_COMPATIBLE_DEVICE_TYPE_NG + "errCode is " +
+            std::to_string(*failedIter) + "\n");
+        return *failedIter;
+    }
+
+    // one row per input in input order, a repeated bundle name is queried once
+    nlohmann::json jsonResult = nlohmann::json::array();
+    for (size_t uniqueIndex : uniqueIndexes) {
+        const BundleCompatibleDeviceType &deviceType = deviceTypes[uniqueIndex];
+        nlohmann::json rowData;
+        rowData["bundleName"] = deviceType.bundleName;
+        if (queryResults[uniqueIndex] != ERR_OK) {
+            rowData["errCode"] = queryResults[uniqueIndex];
+        } else if (deviceType.errCode == ERR_OK) {
+            rowData["compatibleDeviceType"] = deviceType.compatibleDeviceType;
+        } else {
+            rowData["errCode"] = deviceType.errCode;
         }
+        jsonResult.push_back(rowData);
     }
+    resultReceiver_.append(TracedCall("nlohmann::json::dump", TraceCategory::SERIALIZE, [&]() {
+        return jsonResult.dump();
+    }) + "\n");
+    if (options.isLatency) {
+        resultReceiver_.append("input count: " + std::to_string(bundleNames.size()) + ", unique count: " +
+            std::to_string(uniqueNames.size()) + "\n");
+        resultReceiver_.append(BatchQueryEngine::FormatLatencyStats(engine.GetLatencyStats()));
+    }
+    APP_LOGI("RunAsBatchGetCompatibleDeviceType end");
     return OHOS::ERR_OK;
 }
 
 ErrCode BundleTestTool::RunAsGetSimpleAppInfoForUid()
 {
     APP_LOGI("RunAsGetSimpleAppInfoForUid start");
-    std::vector<std::int32_t> uids;
-    int32_t counter = 0;
-    while (counter <= 1) {
-        counter++;
-        int32_t option = getopt_long(argc_, argv_, SHORT_OPTIONS_GET_SIMPLE_APP_INFO_FOR_UID.c_str(),
-            LONG_OPTIONS_GET_SIMPLE_APP_INFO_FOR_UID, nullptr);
-        APP_LOGD("option: %{public}d, optopt: %{public}d, optind: %{public}d", option, optopt, optind);
-        if (optind < 0 || optind > argc_) {
-            return OHOS::ERR_INVALID_VALUE;
+    BatchQueryOptions options;
+    std::string errorOption;
+    OptionParseResult parseResult = GET_SIMPLE_APP_INFO_FOR_UID_OPTION_SCHEMA.Parse(argc_, argv_, INDEX_OFFSET,
+        options, errorOption);
+    bool isValid = CheckOptionParseResult(parseResult, errorOption);
+    std::vector<std::string> uidTexts;
+    SplitBatchQueryKeys(options.keys, uidTexts);
+    std::vector<int32_t> uids;
+    for (const auto &uidText : uidTexts) {
+        int32_t uid = 0;
+        if (isValid && !OHOS::StrToInt(uidText, uid)) {
+            APP_LOGD("invalid uid %{public}s", uidText.c_str());
+            resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+            isValid = false;
         }
-        if (option == -1) {
-            // When scanning the first argument
-            if ((counter == 1) && (strcmp(argv_[optind], cmd_.c_str()) == 0)) {
-                APP_LOGD("bundle_test_tool getSimpleAppInfoForUid with no option.");
-                resultReceiver_.append(HELP_MSG_GET_SIMPLE_APP_INFO_FOR_UID);
-                return OHOS::ERR_INVALID_VALUE;
-            }
-            break;
+        uids.emplace_back(uid);
+    }
+    if (isValid && uids.empty()) {
+        resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
+        isValid = false;
+    }
+    if (!isValid) {
+        resultReceiver_.append(GET_SIMPLE_APP_INFO_FOR_UID_OPTION_SCHEMA.GetHelp());
+        return OHOS::ERR_INVALID_VALUE;
+    }
+
+    std::vector<int32_t> uniqueUids;
+    std::vector<size_t> uniqueIndexes = BatchQueryEngine::Deduplicate(uids, uniqueUids);
+    std::unordered_map<int32_t, size_t> uidIndexes;
+    std::vector<SimpleAppInfo> simpleAppInfos(uniqueUids.size());
+    for (size_t i = 0; i < uniqueUids.size(); ++i) {
+        uidIndexes.emplace(uniqueUids[i], i);
+        simpleAppInfos[i].uid = uniqueUids[i];
+    }
+    // every chunk writes only the slots of its own uids
+    std::vector<ErrCode> queryResults(uniqueUids.size(), ERR_OK);
+    BatchQueryEngine engine(options.jobs, static_cast<size_t>(options.chunkSize));
+    engine.Run(uniqueUids.size(), [this, &uniqueUids, &uidIndexes, &simpleAppInfos, &queryResults](
+        size_t begin, size_t end) {
+        std::vector<int32_t> chunkUids(uniqueUids.begin() + begin, uniqueUids.begin() + end);
+        std::vector<SimpleAppInfo> chunkInfos;
+        ErrCode ret = TracedCall("IBundleMgr::GetSimpleAppInfoForUid", TraceCategory::IPC, [&]() {
+            return bundleMgrProxy_->GetSimpleAppInfoForUid(chunkUids, chunkInfos);
+        });
+        if (ret != ERR_OK) {
+            APP_LOGW("get simple app info for uid failed %{public}d", ret);
+            std::fill(queryResults.begin() + begin, queryResults.begin() + end, ret);
+            return;
         }
-        auto ret = InnerGetSimpleAppInfoForUid(option, uids);
-        if (ret != OHOS::ERR_OK) {
-            return ret;
+        for (const auto &info : chunkInfos) {
+            auto iter = uidIndexes.find(info.uid);
+            if (iter != uidIndexes.end() && iter->second >= begin && iter->second < end) {
+                simpleAppInfos[iter->second] = info;
+            }
         }
+    });
+    auto failedIter = std::find_if(queryResults.begin(), queryResults.end(),
+        [](ErrCode ret) { return ret != ERR_OK; });
+    if (std::all_of(queryResults.begin(), queryResults.end(), [](ErrCode ret) { return ret != ERR_OK; })) {
+        resultReceiver_.append(STRING_GET_SIMPLE_APP_INFO_FOR_UID_NG + "errCode is " +
+            std::to_string(*failedIter) + "\n");
+        APP_LOGI("RunAsGetSimpleAppInfoForUid end");
+        return *failedIter;
     }
-    std::vector<SimpleAppInfo> simpleAppInfo;
-    auto result = bundleMgrProxy_->GetSimpleAppInfoForUid(uids, simpleAppInfo);
-    if (result == ERR_OK) {
-        resultReceiver_.append(STRING_GET_SIMPLE_APP_INFO_FOR_UID_OK);
-        for (size_t i = 0; i < simpleAppInfo.size(); i++) {
-            resultReceiver_.append(simpleAppInfo[i].ToString() + "\n");
+
+    // one line per input in input order, a repeated uid is queried once
+    resultReceiver_.append(STRING_GET_SIMPLE_APP_INFO_FOR_UID_OK);
+    for (size_t uniqueIndex : uniqueIndexes) {
+        SimpleAppInfo &info = simpleAppInfos[uniqueIndex];
+        if (queryResults[uniqueIndex] != ERR_OK) {
+            info.ret = queryResults[uniqueIndex];
         }
-    } else {
-        resultReceiver_.append(STRING_GET_SIMPLE_APP_INFO_FOR_UID_NG + "errCode is "+ std::to_string(result) + "\n");
+        resultReceiver_.append(info.ToString() + "\n");
+    }
+    if (options.isLatency) {
+        resultReceiver_.append("input count: " + std::to_string(uids.size()) + ", unique count: " +
+            std::to_string(uniqueUids.size()) + "\n");
+        resultReceiver_.append(BatchQueryEngine::FormatLatencyStats(engine.GetLatencyStats()));
     }
     APP_LOGI("RunAsGetSimpleAppInfoForUid end");
-    return result;
+    return OHOS::ERR_OK;
 }
 
 ErrCode BundleTestTool::RunAsGetBundleNameByAppId()
@@ -9010,6 +9484,8 @@ ErrCode BundleTestTool::RunAsBatchGetBundleInfo()
     std::vector<std::string> bundleNames;
     int32_t flags = static_cast<int32_t>(GetBundleInfoFlag::GET_BUNDLE_INFO_DEFAULT);
     int32_t userId = Constants::UNSPECIFIED_USERID;
+    bool isStream = false;
+    int32_t chunkSize = DEFAULT_BUNDLE_INFO_CHUNK_SIZE;
     int32_t result = OHOS::ERR_OK;
     int32_t counter = 0;
 
@@ -9043,7 +9519,8 @@ ErrCode BundleTestTool::RunAsBatchGetBundleInfo()
                     result = OHOS::ERR_INVALID_VALUE;
                     break;
                 }
-                case 'u': {
+                case 'u':
+                case 'c': {
                     resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
                     result = OHOS::ERR_INVALID_VALUE;
                     break;
@@ -9090,6 +9567,17 @@ ErrCode BundleTestTool::RunAsBatchGetBundleInfo()
                 }
                 break;
             }
+            case 's': {
+                isStream = true;
+                break;
+            }
+            case 'c': {
+                if (!OHOS::StrToInt(optarg, chunkSize) || chunkSize < 1 || chunkSize > MAX_BUNDLE_INFO_CHUNK_SIZE) {
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                break;
+            }
             default: {
                 result = OHOS::ERR_INVALID_VALUE;
                 break;
@@ -9106,6 +9594,18 @@ ErrCode BundleTestTool::RunAsBatchGetBundleInfo()
 
     if (result != OHOS::ERR_OK) {
         resultReceiver_.append(HELP_MSG_BATCH_GET_BUNDLE_INFO);
+    } else if (isStream) {
+        userId = BundleCommandCommon::GetCurrentUserId(userId);
+        size_t bundleCount = 0;
+        ErrCode ret = StreamBatchGetBundleInfo(bundleNames, flags, userId, chunkSize, std::cout, bundleCount);
+        if (ret == ERR_OK) {
+            resultReceiver_.append(STRING_BATCH_GET_BUNDLE_INFO_OK);
+        } else {
+            resultReceiver_.append(STRING_BATCH_GET_BUNDLE_INFO_NG +
+                                   "errCode is " + std::to_string(ret) + "\n");
+        }
+        resultReceiver_.append("bundle count: " + std::to_string(bundleCount) + "\n");
+        result = ret;
     } else {
         std::vector<BundleInfo> bundleInfos;
         userId = BundleCommandCommon::GetCurrentUserId(userId);
@@ -9131,127 +9631,398 @@ ErrCode BundleTestTool::RunAsBatchGetBundleInfo()
     return result;
 }
 
-ErrCode BundleTestTool::RunAsParseSpmModule()
+ErrCode BundleTestTool::StreamBatchGetBundleInfo(const std::vector<std::string> &bundleNames, int32_t flags,
+    int32_t userId, int32_t chunkSize, std::ostream &output, size_t &bundleCount)
 {
-    APP_LOGI("RunAsParseSpmModule start");
-    std::string moduleJsonPath;
-    int32_t result = OHOS::ERR_OK;
-    int32_t counter = 0;
-
-    while (true) {
-        counter++;
-        int32_t option = getopt_long(argc_, argv_, SHORT_OPTIONS_PARSE_SPM_MODULE.c_str(),
-            LONG_OPTIONS_PARSE_SPM_MODULE, nullptr);
-        APP_LOGD("option: %{public}d, optopt: %{public}d, optind: %{public}d", option, optopt, optind);
-        if (optind < 0 || optind > argc_) {
-            return OHOS::ERR_INVALID_VALUE;
+    ErrCode result = ERR_OK;
+    bundleCount = 0;
+    // only one chunk of bundle infos is alive at a time, so the memory does not grow with the bundle number
+    for (size_t begin = 0; begin < bundleNames.size(); begin += static_cast<size_t>(chunkSize)) {
+        size_t end = std::min(bundleNames.size(), begin + static_cast<size_t>(chunkSize));
+        std::vector<std::string> chunkNames(bundleNames.begin() + begin, bundleNames.begin() + end);
+        std::vector<BundleInfo> bundleInfos;
+        ErrCode ret = bundleMgrProxy_->BatchGetBundleInfo(chunkNames, flags, bundleInfos, userId);
+        if (ret != ERR_OK) {
+            APP_LOGE("batch get bundle info failed %{public}d", ret);
+            nlohmann::json errorObject;
+            errorObject["bundleNames"] = chunkNames;
+            errorObject["errCode"] = ret;
+            output << errorObject.dump() << "\n";
+            result = (result == ERR_OK) ? ret : result;
+            continue;
         }
-        if (option == -1) {
-            if (counter == 1 && strcmp(argv_[optind], cmd_.c_str()) == 0) {
-                resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
-                result = OHOS::ERR_INVALID_VALUE;
-            }
-            break;
+        for (const auto &bundleInfo : bundleInfos) {
+            nlohmann::json jsonObject = bundleInfo;
+            jsonObject["applicationInfo"] = bundleInfo.applicationInfo;
+            output << jsonObject.dump() << "\n";
         }
+        bundleCount += bundleInfos.size();
+        output.flush();
+    }
+    return result;
+}
 
-        if (option == '?') {
-            switch (optopt) {
-                case 'p': {
-                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
-                    result = OHOS::ERR_INVALID_VALUE;
-                    break;
-                }
-                default: {
-                    std::string unknownOption = "";
-                    std::string unknownOptionMsg = GetUnknownOptionMsg(unknownOption);
-                    resultReceiver_.append(unknownOptionMsg);
-                    result = OHOS::ERR_INVALID_VALUE;
-                    break;
-                }
-            }
-            break;
-        }
+const OptionSchema<SnapshotOptions> &BundleTestTool::GetSnapshotOptionSchema()
+{
+    return SNAPSHOT_OPTION_SCHEMA;
+}
 
-        switch (option) {
-            case 'h': {
-                result = OHOS::ERR_INVALID_VALUE;
-                break;
-            }
-            case 'p': {
-                moduleJsonPath = optarg;
-                break;
-            }
-            default: {
-                result = OHOS::ERR_INVALID_VALUE;
-                break;
-            }
+bool BundleTestTool::CheckOptionParseResult(OptionParseResult parseResult, std::string &errorOption)
+{
+    switch (parseResult) {
+        case OptionParseResult::OK:
+            return true;
+        case OptionParseResult::HELP:
+            return false;
+        case OptionParseResult::MISSING_VALUE:
+        case OptionParseResult::INVALID_VALUE:
+            APP_LOGD("invalid value of option %{public}s", errorOption.c_str());
+            resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+            return false;
+        case OptionParseResult::MISSING_REQUIRED:
+            APP_LOGD("option %{public}s is required", errorOption.c_str());
+            resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
+            return false;
+        default:
+            APP_LOGD("unknown option %{public}s", errorOption.c_str());
+            resultReceiver_.append(GetUnknownOptionMsg(errorOption));
+            return false;
+    }
+}
+
+ErrCode BundleTestTool::RunAsSnapshotCommand()
+{
+    APP_LOGI("RunAsSnapshotCommand start");
+    SnapshotOptions options;
+    options.path = BundleSnapshot::GetPathFromEnv();
+    std::string errorOption;
+    OptionParseResult parseResult = SNAPSHOT_OPTION_SCHEMA.Parse(argc_, argv_, INDEX_OFFSET, options, errorOption);
+    if (!CheckOptionParseResult(parseResult, errorOption) || (options.isWatch && options.isDelete)) {
+        resultReceiver_.append(SNAPSHOT_OPTION_SCHEMA.GetHelp());
+        return OHOS::ERR_INVALID_VALUE;
+    }
+    if (options.path.empty()) {
+        options.path = DEFAULT_SNAPSHOT_PATH;
+    }
+    if (options.isDelete) {
+        BundleSnapshot::Invalidate(options.path);
+        resultReceiver_.append(STRING_SNAPSHOT_OK);
+        return OHOS::ERR_OK;
+    }
+
+    // the lock is held until the watcher exits, so a reader never trusts the snapshot of a dead watcher
+    int32_t lockFd = -1;
+    if (options.isWatch) {
+        lockFd = BundleSnapshot::LockWatcher(options.path);
+        if (lockFd < 0) {
+            resultReceiver_.append(STRING_SNAPSHOT_NG + "the snapshot is watched by another process\n");
+            return OHOS::ERR_INVALID_VALUE;
         }
     }
+    int32_t userId = BundleCommandCommon::GetCurrentUserId(options.userId);
+    size_t bundleCount = 0;
+    ErrCode ret = BuildBundleSnapshot(userId, options.path, options.isWatch, bundleCount);
+    if (ret != OHOS::ERR_OK) {
+        BundleSnapshot::UnlockWatcher(lockFd);
+        resultReceiver_.append(STRING_SNAPSHOT_NG + "errCode is " + std::to_string(ret) + "\n");
+        return ret;
+    }
+    resultReceiver_.append(STRING_SNAPSHOT_OK);
+    resultReceiver_.append("bundle count: " + std::to_string(bundleCount) + "\n");
+    if (options.isWatch) {
+        ret = WatchBundleSnapshot(userId, options.path);
+    }
+    BundleSnapshot::UnlockWatcher(lockFd);
+    APP_LOGI("RunAsSnapshotCommand end");
+    return ret;
+}
 
-    if (result == OHOS::ERR_OK) {
-        if (moduleJsonPath.empty()) {
-            resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
-            result = OHOS::ERR_INVALID_VALUE;
+ErrCode BundleTestTool::BuildBundleSnapshot(int32_t userId, const std::string &path, bool isWatched,
+    size_t &bundleCount)
+{
+    if (bundleMgrProxy_ == nullptr) {
+        APP_LOGE("bundleMgrProxy_ is nullptr");
+        return OHOS::ERR_INVALID_VALUE;
+    }
+    std::vector<BundleInfo> bundleInfos;
+    if (!bundleMgrProxy_->GetBundleInfos(
+        static_cast<int32_t>(GetBundleInfoFlag::GET_BUNDLE_INFO_WITH_DISABLE), bundleInfos, userId)) {
+        APP_LOGE("get bundle infos of user %{public}d failed", userId);
+        return OHOS::ERR_INVALID_VALUE;
+    }
+
+    std::vector<BundleSnapshotRecord> records(bundleInfos.size());
+    BundleCommandCommon::ParallelFor(bundleInfos.size(), SNAPSHOT_BUILD_JOBS,
+        [this, &bundleInfos, &records](size_t index) {
+            const BundleInfo &bundleInfo = bundleInfos[index];
+            BundleSnapshotRecord &record = records[index];
+            record.bundleName = bundleInfo.name;
+            record.uid = bundleInfo.uid;
+            record.appIndex = bundleInfo.appIndex;
+            record.apiTargetVersion = static_cast<int32_t>(bundleInfo.targetVersion);
+            // an empty device type makes getCompatibleDeviceType ask the service
+            if (bundleInfo.appIndex == 0 &&
+                bundleMgrProxy_->GetCompatibleDeviceType(bundleInfo.name, record.deviceType) != ERR_OK) {
+                record.deviceType.clear();
+            }
+        });
+    if (!BundleSnapshot::Write(path, userId, isWatched, records)) {
+        return OHOS::ERR_INVALID_VALUE;
+    }
+    bundleCount = records.size();
+    return OHOS::ERR_OK;
+}
+
+ErrCode BundleTestTool::WatchBundleSnapshot(int32_t userId, const std::string &path)
+{
+    // the callback only drops the snapshot, the rebuild runs here so that the ipc thread is never blocked
+    auto isChanged = std::make_shared<std::atomic<bool>>(false);
+    sptr<BundleEventCallbackImpl> bundleEventCallback = new (std::nothrow) BundleEventCallbackImpl(
+        [path, isChanged](const std::string &bundleName) {
+            BundleSnapshot::Invalidate(path);
+            isChanged->store(true);
+        });
+    if (bundleEventCallback == nullptr) {
+        return OHOS::ERR_INVALID_VALUE;
+    }
+    uid_t originalUid = geteuid();
+    seteuid(Constants::FOUNDATION_UID);
+    ErrCode ret = CallRegisterBundleEventCallback(bundleEventCallback);
+    seteuid(originalUid);
+    if (ret != OHOS::ERR_OK) {
+        BundleSnapshot::Invalidate(path);
+        return ret;
+    }
+    WriteOutput(std::move(resultReceiver_));
+    resultReceiver_.clear();
+
+    // the watch waits on a signal nobody sets, so that the first SIGINT stops it instead of terminating the tool
+    CompletionSignal watchStopped;
+    while (watchStopped.Wait(Deadline::After(SNAPSHOT_WATCH_INTERVAL)) != CompletionSignal::WaitResult::CANCELED) {
+        if (!isChanged->exchange(false)) {
+            continue;
         }
+        size_t bundleCount = 0;
+        if (BuildBundleSnapshot(userId, path, true, bundleCount) != OHOS::ERR_OK || isChanged->load()) {
+            // an event during the rebuild may not be in the new snapshot, the next round builds it again
+            BundleSnapshot::Invalidate(path);
+            continue;
+        }
+        WriteOutput("snapshot rebuilt, bundle count: " + std::to_string(bundleCount) + "\n");
     }
 
-    if (result != OHOS::ERR_OK) {
-        resultReceiver_.append(HELP_MSG_PARSE_SPM_MODULE);
-    } else {
-        std::ifstream ifs(moduleJsonPath);
-        if (!ifs.is_open()) {
-            resultReceiver_.append(STRING_PARSE_SPM_MODULE_NG +
-                "failed to open file: " + moduleJsonPath + "\n");
+    // nobody keeps the snapshot up to date any more
+    BundleSnapshot::Invalidate(path);
+    seteuid(Constants::FOUNDATION_UID);
+    ret = CallUnRegisterBundleEventCallback(bundleEventCallback);
+    seteuid(originalUid);
+    return ret;
+}
+
+bool BundleTestTool::FindInBundleSnapshot(const std::string &bundleName, int32_t userId, int32_t appIndex,
+    BundleSnapshotRecord &record) const
+{
+    std::string path = BundleSnapshot::GetPathFromEnv();
+    if (path.empty()) {
+        return false;
+    }
+    BundleSnapshot snapshot;
+    if (!snapshot.Open(path) || snapshot.GetUserId() != userId) {
+        return false;
+    }
+    return snapshot.FindByBundleName(bundleName, appIndex, record);
+}
+
+ErrCode BundleTestTool::RunAsParseSpmModule()
+{
+    APP_LOGI("RunAsParseSpmModule start");
+    ParseSpmModuleOptions options;
+    std::string errorOption;
+    OptionParseResult parseResult = PARSE_SPM_MODULE_OPTION_SCHEMA.Parse(argc_, argv_, INDEX_OFFSET, options,
+        errorOption);
+    bool isValid = CheckOptionParseResult(parseResult, errorOption);
+    if (isValid && std::any_of(options.paths.begin(), options.paths.end(),
+        [](const std::string &path) { return path.empty(); })) {
+        resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
+        isValid = false;
+    }
+    if (!isValid) {
+        resultReceiver_.append(PARSE_SPM_MODULE_OPTION_SCHEMA.GetHelp());
+        APP_LOGI("RunAsParseSpmModule end");
+        return OHOS::ERR_INVALID_VALUE;
+    }
+    const std::vector<std::string> &inputPaths = options.paths;
+
+    std::vector<std::string> moduleJsonPaths;
+    for (const auto &path : inputPaths) {
+        CollectModuleJsonPaths(path, moduleJsonPaths);
+    }
+    if (inputPaths.size() == 1 && moduleJsonPaths.size() == 1 && moduleJsonPaths.front() == inputPaths.front()) {
+        // one file keeps the readable output and the messages of a single parse
+        std::string moduleJson;
+        std::string resultMsg;
+        if (!ReadModuleJsonFile(moduleJsonPaths.front(), moduleJson, resultMsg)) {
+            resultReceiver_.append(STRING_PARSE_SPM_MODULE_NG + "failed to open file: " + moduleJsonPaths.front() +
+                "\n");
             APP_LOGI("RunAsParseSpmModule end");
             return OHOS::ERR_INVALID_VALUE;
         }
-        std::string moduleJson((std::istreambuf_iterator<char>(ifs)),
-            std::istreambuf_iterator<char>());
-        ifs.close();
-
-        Spm::InnerModuleInfoForSpm moduleInfo;
-        bool ret = Spm::ParseSpmModule(moduleJson, moduleInfo);
-        if (ret) {
-            nlohmann::json jsonResult;
-            jsonResult["bundleName"] = moduleInfo.bundleName;
-            jsonResult["moduleName"] = moduleInfo.moduleName;
-            jsonResult["bundleType"] = static_cast<int32_t>(moduleInfo.bundleType);
-            jsonResult["apiTargetVersion"] = moduleInfo.apiTargetVersion;
-            jsonResult["skillName"] = moduleInfo.skillName;
-
-            nlohmann::json definePerms = nlohmann::json::array();
-            for (const auto &perm : moduleInfo.definePermission) {
-                nlohmann::json p;
-                p["name"] = perm.name;
-                p["grantMode"] = perm.grantMode;
-                p["availableLevel"] = perm.availableLevel;
-                p["availableType"] = perm.availableType;
-                p["provisionEnable"] = perm.provisionEnable;
-                p["distributedSceneEnable"] = perm.distributedSceneEnable;
-                definePerms.push_back(p);
-            }
-            jsonResult["definePermission"] = definePerms;
-
-            nlohmann::json requestPerms = nlohmann::json::array();
-            for (const auto &perm : moduleInfo.requestPermission) {
-                nlohmann::json p;
-                p["name"] = perm.name;
-                p["moduleName"] = perm.moduleName;
-                p["reason"] = perm.reason;
-                requestPerms.push_back(p);
-            }
-            jsonResult["requestPermission"] = requestPerms;
-
-            resultReceiver_.append(STRING_PARSE_SPM_MODULE_OK);
-            resultReceiver_.append(jsonResult.dump(Constants::DUMP_INDENT));
-            resultReceiver_.append("\n");
-        } else {
+        if (!ParseSpmModuleJson(moduleJson, Constants::DUMP_INDENT, resultMsg)) {
             resultReceiver_.append(STRING_PARSE_SPM_MODULE_NG);
-            result = OHOS::ERR_INVALID_VALUE;
+            APP_LOGI("RunAsParseSpmModule end");
+            return OHOS::ERR_INVALID_VALUE;
         }
+        resultReceiver_.append(STRING_PARSE_SPM_MODULE_OK);
+        resultReceiver_.append(resultMsg);
+        APP_LOGI("RunAsParseSpmModule end");
+        return OHOS::ERR_OK;
     }
+
+    // one compact line per module, written as soon as it is parsed
+    std::mutex outputMutex;
+    std::atomic<size_t> failCount(0);
+    int32_t jobs = static_cast<int32_t>(std::min<uint32_t>(std::thread::hardware_concurrency(),
+        static_cast<uint32_t>(MAX_PARSE_SPM_MODULE_JOBS)));
+    BundleCommandCommon::ParallelFor(moduleJsonPaths.size(), jobs,
+        [this, &moduleJsonPaths, &outputMutex, &failCount](size_t index) {
+            std::string resultMsg;
+            if (!ParseSpmModuleFile(moduleJsonPaths[index], COMPACT_JSON_INDENT, resultMsg)) {
+                failCount.fetch_add(1);
+            }
+            std::lock_guard<std::mutex> lock(outputMutex);
+            WriteOutput(moduleJsonPaths[index] + ": " + resultMsg);
+        });
+    resultReceiver_.append("module count: " + std::to_string(moduleJsonPaths.size()) + "\n");
+    resultReceiver_.append("fail count: " + std::to_string(failCount.load()) + "\n");
     APP_LOGI("RunAsParseSpmModule end");
-    return result;
+    return (moduleJsonPaths.empty() || failCount.load() > 0) ? OHOS::ERR_INVALID_VALUE : OHOS::ERR_OK;
+}
+
+void BundleTestTool::CollectModuleJsonPaths(const std::string &path,
+    std::vector<std::string> &moduleJsonPaths) const
+{
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        // not a directory, the parse reports whether the file can be read
+        moduleJsonPaths.emplace_back(path);
+        return;
+    }
+    std::string dirPath = path.back() == '/' ? path : path + "/";
+    std::vector<std::string> subDirs;
+    size_t firstIndex = moduleJsonPaths.size();
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN) {
+            struct stat entryStat;
+            if (lstat((dirPath + name).c_str(), &entryStat) != 0) {
+                continue;
+            }
+            type = S_ISDIR(entryStat.st_mode) ? DT_DIR : (S_ISREG(entryStat.st_mode) ? DT_REG : DT_UNKNOWN);
+        }
+        if (type == DT_DIR) {
+            subDirs.emplace_back(dirPath + name);
+        } else if (type == DT_REG && name == MODULE_JSON_FILE_NAME) {
+            moduleJsonPaths.emplace_back(dirPath + name);
+        }
+    }
+    closedir(dir);
+    std::sort(subDirs.begin(), subDirs.end());
+    for (const auto &subDir : subDirs) {
+        CollectModuleJsonPaths(subDir, moduleJsonPaths);
+    }
+    std::sort(moduleJsonPaths.begin() + firstIndex, moduleJsonPaths.end());
+}
+
+bool BundleTestTool::ParseSpmModuleFile(const std::string &moduleJsonPath, int32_t indent,
+    std::string &resultMsg) const
+{
+    std::string moduleJson;
+    if (!ReadModuleJsonFile(moduleJsonPath, moduleJson, resultMsg)) {
+        return false;
+    }
+    if (!ParseSpmModuleJson(moduleJson, indent, resultMsg)) {
+        resultMsg = "failed to parse file\n";
+        return false;
+    }
+    return true;
+}
+
+bool BundleTestTool::ReadModuleJsonFile(const std::string &moduleJsonPath, std::string &moduleJson,
+    std::string &errorMsg) const
+{
+    int fd = open(moduleJsonPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        errorMsg = "failed to open file\n";
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) ||
+        static_cast<size_t>(fileStat.st_size) > MAX_MODULE_JSON_FILE_SIZE) {
+        close(fd);
+        errorMsg = "not a module.json file\n";
+        return false;
+    }
+    // one copy of exactly the file size, the parser takes a string
+    moduleJson.clear();
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    if (fileSize > 0) {
+        void *data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            errorMsg = "failed to map file\n";
+            return false;
+        }
+        moduleJson.assign(static_cast<const char *>(data), fileSize);
+        munmap(data, fileSize);
+    }
+    close(fd);
+    return true;
+}
+
+bool BundleTestTool::ParseSpmModuleJson(const std::string &moduleJson, int32_t indent, std::string &resultMsg) const
+{
+    Spm::InnerModuleInfoForSpm moduleInfo;
+    if (!Spm::ParseSpmModule(moduleJson, moduleInfo)) {
+        return false;
+    }
+    nlohmann::json jsonResult;
+    jsonResult["bundleName"] = moduleInfo.bundleName;
+    jsonResult["moduleName"] = moduleInfo.moduleName;
+    jsonResult["bundleType"] = static_cast<int32_t>(moduleInfo.bundleType);
+    jsonResult["apiTargetVersion"] = moduleInfo.apiTargetVersion;
+    jsonResult["skillName"] = moduleInfo.skillName;
+
+    nlohmann::json definePerms = nlohmann::json::array();
+    for (const auto &perm : moduleInfo.definePermission) {
+        nlohmann::json p;
+        p["name"] = perm.name;
+        p["grantMode"] = perm.grantMode;
+        p["availableLevel"] = perm.availableLevel;
+        p["availableType"] = perm.availableType;
+        p["provisionEnable"] = perm.provisionEnable;
+        p["distributedSceneEnable"] = perm.distributedSceneEnable;
+        definePerms.push_back(p);
+    }
+    jsonResult["definePermission"] = definePerms;
+
+    nlohmann::json requestPerms = nlohmann::json::array();
+    for (const auto &perm : moduleInfo.requestPermission) {
+        nlohmann::json p;
+        p["name"] = perm.name;
+        p["moduleName"] = perm.moduleName;
+        p["reason"] = perm.reason;
+        requestPerms.push_back(p);
+    }
+    jsonResult["requestPermission"] = requestPerms;
+    // the workers must not throw on a string that is not utf-8
+    resultMsg = jsonResult.dump(indent, ' ', false, nlohmann::json::error_handler_t::replace);
+    resultMsg.append("\n");
+    return true;
 }
 
 ErrCode BundleTestTool::RunAsGetTopNLargestItemsInAppDataDir()
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command_trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <unistd.h>
+
+#include "app_log_wrapper.h"
+#include "text_builder.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+constexpr const char *SUMMARY_TARGET = "summary";
+constexpr const char *SUMMARY_TARGET_SHORT = "1";
+constexpr int64_t NANOSECONDS_PER_MICROSECOND = 1000;
+constexpr int64_t MICROSECONDS_PER_SECOND = 1000000;
+constexpr size_t CATEGORY_COUNT = static_cast<size_t>(TraceCategory::OUTPUT) + 1;
+constexpr size_t CHROME_TRACE_EVENT_SIZE = 160;
+const char *const CATEGORY_NAMES[CATEGORY_COUNT] = { "command", "parse", "proxy", "ipc", "serialize", "output" };
+
+std::atomic<bool> g_isEnabled(false);
+std::mutex g_traceMutex;
+std::string g_target;
+std::vector<TraceEvent> g_events;
+const std::chrono::steady_clock::time_point g_startTime = std::chrono::steady_clock::now();
+
+const char *GetCategoryName(TraceCategory category)
+{
+    size_t index = static_cast<size_t>(category);
+    return index < CATEGORY_COUNT ? CATEGORY_NAMES[index] : "unknown";
+}
+
+void AppendJsonName(const char *name, std::string &output)
+{
+    output.push_back('"');
+    for (const char *ch = name; *ch != '\0'; ++ch) {
+        if (*ch == '"' || *ch == '\\') {
+            output.push_back('\\');
+        }
+        output.push_back(*ch);
+    }
+    output.push_back('"');
+}
+}  // namespace
+
+void CommandTrace::Start(const std::string &target)
+{
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+    g_target = target;
+    g_events.clear();
+    g_isEnabled.store(!target.empty(), std::memory_order_release);
+}
+
+bool CommandTrace::IsEnabled()
+{
+    return g_isEnabled.load(std::memory_order_acquire);
+}
+
+void CommandTrace::Record(const TraceEvent &event)
+{
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+    if (IsEnabled()) {
+        g_events.emplace_back(event);
+    }
+}
+
+void CommandTrace::Finish()
+{
+    std::vector<TraceEvent> events;
+    std::string target;
+    {
+        std::lock_guard<std::mutex> lock(g_traceMutex);
+        if (!IsEnabled()) {
+            return;
+        }
+        events.swap(g_events);
+        target.swap(g_target);
+        g_isEnabled.store(false, std::memory_order_release);
+    }
+    if (target == SUMMARY_TARGET || target == SUMMARY_TARGET_SHORT) {
+        std::cerr << FormatSummary(events);
+        return;
+    }
+    std::ofstream file(target, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        APP_LOGE("failed to open trace file %{public}s", target.c_str());
+        std::cerr << "error: failed to write trace to " << target << "\n" << FormatSummary(events);
+        return;
+    }
+    file << FormatChromeTrace(events);
+    APP_LOGI("trace written to %{public}s, event count: %{public}zu", target.c_str(), events.size());
+}
+
+int64_t CommandTrace::GetElapsedUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_startTime).count();
+}
+
+int64_t CommandTrace::GetThreadCpuUs()
+{
+    struct timespec cpuTime = {0, 0};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(cpuTime.tv_sec) * MICROSECONDS_PER_SECOND +
+        static_cast<int64_t>(cpuTime.tv_nsec) / NANOSECONDS_PER_MICROSECOND;
+}
+
+std::string CommandTrace::FormatSummary(const std::vector<TraceEvent> &events)
+{
+    size_t counts[CATEGORY_COUNT] = {0};
+    int64_t wallUs[CATEGORY_COUNT] = {0};
+    int64_t cpuUs[CATEGORY_COUNT] = {0};
+    for (const auto &event : events) {
+        size_t index = static_cast<size_t>(event.category);
+        if (index >= CATEGORY_COUNT) {
+            continue;
+        }
+        ++counts[index];
+        wallUs[index] += event.wallUs;
+        cpuUs[index] += event.cpuUs;
+    }
+    // eg: trace: command 1 x 5210us cpu 830us, proxy 2 x 1630us cpu 120us, ipc 3 x 3020us cpu 90us
+    std::string summary;
+    TextBuilder builder(summary);
+    builder.Append("trace:");
+    bool isFirst = true;
+    for (size_t index = 0; index < CATEGORY_COUNT; ++index) {
+        if (counts[index] == 0) {
+            continue;
+        }
+        builder.Append(isFirst ? " " : ", ", CATEGORY_NAMES[index], " ", counts[index], " x ", wallUs[index],
+            "us cpu ", cpuUs[index], "us");
+        isFirst = false;
+    }
+    builder.Append('\n');
+    return summary;
+}
+
+std::string CommandTrace::FormatChromeTrace(const std::vector<TraceEvent> &events)
+{
+    std::string trace;
+    TextBuilder builder(trace, events.size() * CHROME_TRACE_EVENT_SIZE);
+    builder.Append("{\"traceEvents\":[");
+    int64_t processId = static_cast<int64_t>(getpid());
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent &event = events[i];
+        builder.Append(i == 0 ? "{\"name\":" : ",{\"name\":");
+        AppendJsonName(event.name, trace);
+        builder.Append(",\"cat\":\"", GetCategoryName(event.category), "\",\"ph\":\"X\"");
+        builder.Append(",\"ts\":", event.beginUs, ",\"dur\":", event.wallUs);
+        builder.Append(",\"pid\":", processId, ",\"tid\":", event.threadId);
+        builder.Append(",\"args\":{\"cpuUs\":", event.cpuUs, "}}");
+    }
+    builder.Append("],\"displayTimeUnit\":\"ms\"}\n");
+    return trace;
+}
+
+CommandTraceSpan::CommandTraceSpan(const char *name, TraceCategory category)
+    : isEnabled_(CommandTrace::IsEnabled())
+{
+    if (!isEnabled_) {
+        return;
+    }
+    event_.name = name;
+    event_.category = category;
+    event_.threadId = static_cast<int64_t>(gettid());
+    event_.cpuUs = CommandTrace::GetThreadCpuUs();
+    event_.beginUs = CommandTrace::GetElapsedUs();
+}
+
+CommandTraceSpan::~CommandTraceSpan()
+{
+    End();
+}
+
+void CommandTraceSpan::End()
+{
+    if (!isEnabled_) {
+        return;
+    }
+    isEnabled_ = false;
+    event_.wallUs = CommandTrace::GetElapsedUs() - event_.beginUs;
+    event_.cpuUs = CommandTrace::GetThreadCpuUs() - event_.cpuUs;
+    CommandTrace::Record(event_);
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
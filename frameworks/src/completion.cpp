@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "completion.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+
+#include "app_log_wrapper.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// a signal handler can not notify a condition variable, so the waits wake up to check the cancellation
+constexpr std::chrono::milliseconds CANCEL_CHECK_INTERVAL(100);
+
+// all the signals share one condition variable, so that one thread can wait for any of them
+std::mutex g_completionMutex;
+std::condition_variable g_completionCondition;
+std::atomic<bool> g_cancelRequested(false);
+// the waits in progress, a SIGINT out of them finds the thread blocked in an ipc call which it can not cancel
+std::atomic<int32_t> g_waitCount(0);
+thread_local std::chrono::steady_clock::time_point g_currentDeadline = std::chrono::steady_clock::time_point::max();
+
+void HandleInterrupt(int signalNumber)
+{
+    if (g_waitCount.load() == 0 || g_cancelRequested.exchange(true)) {
+        signal(signalNumber, SIG_DFL);
+        raise(signalNumber);
+    }
+}
+
+class WaitCountGuard {
+public:
+    WaitCountGuard()
+    {
+        g_waitCount.fetch_add(1);
+    }
+
+    ~WaitCountGuard()
+    {
+        g_waitCount.fetch_sub(1);
+    }
+};
+
+template<typename Predicate>
+CompletionSignal::WaitResult WaitUntil(const Deadline &deadline, Predicate predicate)
+{
+    WaitCountGuard waitCountGuard;
+    std::unique_lock<std::mutex> lock(g_completionMutex);
+    while (true) {
+        if (predicate()) {
+            return CompletionSignal::WaitResult::READY;
+        }
+        if (g_cancelRequested.load()) {
+            return CompletionSignal::WaitResult::CANCELED;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline.GetTimePoint()) {
+            return CompletionSignal::WaitResult::TIMEOUT;
+        }
+        auto wakeTime = deadline.GetTimePoint() - now > CANCEL_CHECK_INTERVAL ?
+            now + CANCEL_CHECK_INTERVAL : deadline.GetTimePoint();
+        g_completionCondition.wait_until(lock, wakeTime);
+    }
+}
+}  // namespace
+
+Deadline::Deadline(std::chrono::steady_clock::time_point timePoint) : timePoint_(timePoint)
+{}
+
+Deadline Deadline::After(std::chrono::milliseconds timeout)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto timePoint = g_currentDeadline - now > timeout ? now + timeout : g_currentDeadline;
+    return Deadline(timePoint);
+}
+
+Deadline Deadline::Never()
+{
+    return Deadline(std::chrono::steady_clock::time_point::max());
+}
+
+Deadline Deadline::Current()
+{
+    return Deadline(g_currentDeadline);
+}
+
+Deadline Deadline::Min(const Deadline &other) const
+{
+    return Deadline(std::min(timePoint_, other.timePoint_));
+}
+
+bool Deadline::IsExpired() const
+{
+    return std::chrono::steady_clock::now() >= timePoint_;
+}
+
+std::chrono::steady_clock::time_point Deadline::GetTimePoint() const
+{
+    return timePoint_;
+}
+
+ScopedDeadline::ScopedDeadline(const Deadline &deadline) : previous_(Deadline::Current())
+{
+    g_currentDeadline = previous_.Min(deadline).GetTimePoint();
+}
+
+ScopedDeadline::~ScopedDeadline()
+{
+    g_currentDeadline = previous_.GetTimePoint();
+}
+
+bool CompletionSignal::Signal()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_completionMutex);
+        if (signaled_) {
+            return false;
+        }
+        signaled_ = true;
+    }
+    g_completionCondition.notify_all();
+    return true;
+}
+
+bool CompletionSignal::IsSignaled() const
+{
+    std::lock_guard<std::mutex> lock(g_completionMutex);
+    return signaled_;
+}
+
+CompletionSignal::WaitResult CompletionSignal::Wait(const Deadline &deadline) const
+{
+    return WaitUntil(deadline, [this]() { return signaled_; });
+}
+
+CompletionSignal::WaitResult CompletionSignal::WaitAll(
+    const std::vector<const CompletionSignal *> &signals, const Deadline &deadline)
+{
+    return WaitUntil(deadline, [&signals]() {
+        return std::all_of(signals.begin(), signals.end(),
+            [](const CompletionSignal *signal) { return signal == nullptr || signal->signaled_; });
+    });
+}
+
+CompletionSignal::WaitResult CompletionSignal::WaitAny(
+    const std::vector<const CompletionSignal *> &signals, const Deadline &deadline, size_t &index)
+{
+    return WaitUntil(deadline, [&signals, &index]() {
+        for (size_t i = 0; i < signals.size(); ++i) {
+            if (signals[i] != nullptr && signals[i]->signaled_) {
+                index = i;
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+void CompletionSignal::InstallInterruptHandler()
+{
+    struct sigaction action = {};
+    action.sa_handler = HandleInterrupt;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGINT, &action, nullptr) != 0) {
+        APP_LOGW("install interrupt handler failed");
+    }
+}
+
+void CompletionSignal::RequestCancel()
+{
+    g_cancelRequested.store(true);
+    g_completionCondition.notify_all();
+}
+
+bool CompletionSignal::IsCancelRequested()
+{
+    return g_cancelRequested.load();
+}
+
+void CompletionSignal::ResetCancel()
+{
+    g_cancelRequested.store(false);
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
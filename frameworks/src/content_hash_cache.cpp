@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "content_hash_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "app_log_wrapper.h"
+#include "nlohmann/json.hpp"
+#include "zlib.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const std::string ENTRIES_KEY = "entries";
+const std::string HASH_KEY = "hash";
+const std::string SIZE_KEY = "size";
+const std::string BUNDLE_NAME_KEY = "bundleName";
+const std::string MODULE_NAME_KEY = "moduleName";
+const std::string VERSION_CODE_KEY = "versionCode";
+const std::string BUILD_ID_KEY = "buildId";
+const std::string TEMP_FILE_SUFFIX = ".tmp";
+constexpr size_t HASH_CHUNK_SIZE = 1024 * 1024;
+constexpr size_t HASH_TEXT_SIZE = 17;
+constexpr mode_t CACHE_FILE_MODE = S_IRUSR | S_IWUSR;
+
+bool FormatHash(uLong crc, uLong adler, std::string &hash)
+{
+    char text[HASH_TEXT_SIZE] = {0};
+    if (snprintf(text, sizeof(text), "%08" PRIx32 "%08" PRIx32, static_cast<uint32_t>(crc),
+        static_cast<uint32_t>(adler)) < 0) {
+        return false;
+    }
+    hash = text;
+    return true;
+}
+
+// the cache decides whether a file is pushed at all, so only a file of the current user that nobody else can
+// write is trusted
+bool ReadTrustedFile(const std::string &path, std::string &content)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_uid != geteuid() ||
+        (fileStat.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+        APP_LOGW("content hash cache %{public}s is not trusted", path.c_str());
+        close(fd);
+        return false;
+    }
+    std::vector<char> buffer(HASH_CHUNK_SIZE);
+    ssize_t readSize = 0;
+    while ((readSize = read(fd, buffer.data(), buffer.size())) > 0) {
+        content.append(buffer.data(), static_cast<size_t>(readSize));
+    }
+    close(fd);
+    return readSize == 0;
+}
+
+bool WriteFile(const std::string &path, const std::string &content)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, CACHE_FILE_MODE);
+    if (fd < 0) {
+        APP_LOGW("open %{public}s failed", path.c_str());
+        return false;
+    }
+    size_t offset = 0;
+    while (offset < content.size()) {
+        ssize_t writeSize = write(fd, content.data() + offset, content.size() - offset);
+        if (writeSize <= 0) {
+            close(fd);
+            return false;
+        }
+        offset += static_cast<size_t>(writeSize);
+    }
+    return close(fd) == 0;
+}
+}  // namespace
+
+bool ContentHashCache::IsSkipUnchangedEnabled()
+{
+    const char *value = getenv(SKIP_UNCHANGED_ENV);
+    return value != nullptr && std::string(value) == "1";
+}
+
+bool ContentHashCache::ComputeHash(const std::string &path, std::string &hash, int64_t &size)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        APP_LOGW("open %{private}s failed", path.c_str());
+        return false;
+    }
+    std::vector<Bytef> buffer(HASH_CHUNK_SIZE);
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uLong adler = adler32(0L, Z_NULL, 0);
+    size = 0;
+    ssize_t readSize = 0;
+    while ((readSize = read(fd, buffer.data(), buffer.size())) > 0) {
+        crc = crc32(crc, buffer.data(), static_cast<uInt>(readSize));
+        adler = adler32(adler, buffer.data(), static_cast<uInt>(readSize));
+        size += readSize;
+    }
+    close(fd);
+    if (readSize < 0) {
+        APP_LOGW("read %{private}s failed", path.c_str());
+        return false;
+    }
+    return FormatHash(crc, adler, hash);
+}
+
+std::string ContentHashCache::ComputeTextHash(const std::string &text)
+{
+    const Bytef *data = reinterpret_cast<const Bytef *>(text.data());
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uLong adler = adler32(0L, Z_NULL, 0);
+    size_t offset = 0;
+    while (offset < text.size()) {
+        uInt chunkSize = static_cast<uInt>(std::min(text.size() - offset, HASH_CHUNK_SIZE));
+        crc = crc32(crc, data + offset, chunkSize);
+        adler = adler32(adler, data + offset, chunkSize);
+        offset += chunkSize;
+    }
+    std::string hash;
+    FormatHash(crc, adler, hash);
+    return hash;
+}
+
+std::string ContentHashCache::FormatAvoidedSize(size_t fileCount, int64_t avoidedSize)
+{
+    return "skip " + std::to_string(fileCount) + " unchanged files, " + std::to_string(avoidedSize) +
+        " bytes avoided, use " + FORCE_OPTION + " to push them anyway\n";
+}
+
+ContentHashCache::ContentHashCache(const std::string &cachePath) : cachePath_(cachePath)
+{}
+
+void ContentHashCache::Load()
+{
+    entries_.clear();
+    std::string content;
+    if (!ReadTrustedFile(cachePath_, content)) {
+        return;
+    }
+    nlohmann::json cacheJson = nlohmann::json::parse(content, nullptr, false);
+    if (cacheJson.is_discarded() || !cacheJson.is_object() || !cacheJson.contains(ENTRIES_KEY) ||
+        !cacheJson[ENTRIES_KEY].is_object()) {
+        APP_LOGW("content hash cache %{public}s is broken", cachePath_.c_str());
+        return;
+    }
+    for (const auto &item : cacheJson[ENTRIES_KEY].items()) {
+        const nlohmann::json &entryJson = item.value();
+        if (!entryJson.is_object() || !entryJson.contains(HASH_KEY) || !entryJson[HASH_KEY].is_string() ||
+            !entryJson.contains(SIZE_KEY) || !entryJson[SIZE_KEY].is_number_integer()) {
+            continue;
+        }
+        ContentHashEntry entry;
+        entry.hash = entryJson[HASH_KEY].get<std::string>();
+        entry.size = entryJson[SIZE_KEY].get<int64_t>();
+        entry.bundleName = entryJson.value(BUNDLE_NAME_KEY, "");
+        entry.moduleName = entryJson.value(MODULE_NAME_KEY, "");
+        entry.versionCode = entryJson.value(VERSION_CODE_KEY, static_cast<int64_t>(-1));
+        entry.buildId = entryJson.value(BUILD_ID_KEY, "");
+        entries_.emplace(item.key(), entry);
+    }
+    APP_LOGD("load %{public}zu content hash entries", entries_.size());
+}
+
+bool ContentHashCache::Save() const
+{
+    nlohmann::json entriesJson = nlohmann::json::object();
+    for (const auto &item : entries_) {
+        entriesJson[item.first] = {
+            {HASH_KEY, item.second.hash},
+            {SIZE_KEY, item.second.size},
+            {BUNDLE_NAME_KEY, item.second.bundleName},
+            {MODULE_NAME_KEY, item.second.moduleName},
+            {VERSION_CODE_KEY, item.second.versionCode},
+            {BUILD_ID_KEY, item.second.buildId},
+        };
+    }
+    nlohmann::json cacheJson = { {ENTRIES_KEY, entriesJson} };
+    std::string tempPath = cachePath_ + TEMP_FILE_SUFFIX + std::to_string(getpid());
+    // a stale temporary file of a crashed bm with the same pid is replaced rather than reused
+    unlink(tempPath.c_str());
+    if (!WriteFile(tempPath, cacheJson.dump())) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    if (rename(tempPath.c_str(), cachePath_.c_str()) != 0) {
+        APP_LOGW("rename %{public}s failed", tempPath.c_str());
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ContentHashCache::Lookup(const std::string &path, const std::string &hash, int64_t size,
+    ContentHashEntry &entry) const
+{
+    auto iter = entries_.find(path);
+    if (iter == entries_.end() || iter->second.hash != hash || iter->second.size != size) {
+        return false;
+    }
+    entry = iter->second;
+    return true;
+}
+
+void ContentHashCache::Update(const std::string &path, const ContentHashEntry &entry)
+{
+    entries_[path] = entry;
+}
+
+bool ContentHashCache::Erase(const std::string &bundleName)
+{
+    bool isErased = false;
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+        if (iter->second.bundleName == bundleName) {
+            iter = entries_.erase(iter);
+            isErased = true;
+        } else {
+            ++iter;
+        }
+    }
+    return isErased;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hap_verifier.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "app_log_wrapper.h"
+#include "bundle_command_common.h"
+#include "nlohmann/json.hpp"
+#include "spm_module_parser.h"
+#include "zlib.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const std::string MODULE_JSON_NAME = "module.json";
+const std::string CONFIG_JSON_NAME = "config.json";
+const std::string FA_MODEL_NOT_SUPPORTED = "FA model not supported by --verify";
+const std::string PATCH_JSON_NAME = "patch.json";
+const std::string BUNDLE_NAME_KEY = "bundleName";
+const std::string APP_KEY = "app";
+const std::string VERSION_CODE_KEY = "versionCode";
+constexpr uint32_t EOCD_SIGNATURE = 0x06054b50;
+constexpr uint32_t CENTRAL_DIR_SIGNATURE = 0x02014b50;
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr size_t EOCD_SIZE = 22;
+constexpr size_t MAX_ZIP_COMMENT_SIZE = 0xFFFF;
+constexpr size_t CENTRAL_DIR_HEADER_SIZE = 46;
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr uint32_t ZIP64_MARK = 0xFFFFFFFF;
+constexpr uint16_t METHOD_STORED = 0;
+constexpr uint16_t METHOD_DEFLATED = 8;
+constexpr uint16_t FLAG_ENCRYPTED = 0x1;
+// module.json and patch.json are a few kilobytes, a much larger one is not a profile
+constexpr uint32_t MAX_PROFILE_SIZE = 16 * 1024 * 1024;
+
+struct ZipEntry {
+    std::string_view name;
+    uint16_t flags = 0;
+    uint16_t method = 0;
+    uint32_t crc = 0;
+    uint32_t compressedSize = 0;
+    uint32_t size = 0;
+    uint32_t localHeaderOffset = 0;
+};
+
+uint16_t ReadUint16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t ReadUint32(const uint8_t *data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+        (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+class MappedFile {
+public:
+    ~MappedFile()
+    {
+        if (data_ != nullptr) {
+            munmap(const_cast<uint8_t *>(data_), size_);
+        }
+    }
+
+    bool Map(const std::string &path, std::string &errorMsg)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            errorMsg = "can not open the file";
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) ||
+            static_cast<size_t>(fileStat.st_size) < EOCD_SIZE) {
+            close(fd);
+            errorMsg = "not a zip archive";
+            return false;
+        }
+        void *data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            errorMsg = "can not map the file";
+            return false;
+        }
+        data_ = static_cast<const uint8_t *>(data);
+        size_ = static_cast<size_t>(fileStat.st_size);
+        return true;
+    }
+
+    const uint8_t *GetData() const
+    {
+        return data_;
+    }
+
+    size_t GetSize() const
+    {
+        return size_;
+    }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// walk the whole central directory, so that a truncated or corrupted archive is found before the install
+bool FindEntry(const MappedFile &file, const std::string &entryName, ZipEntry &foundEntry, std::string &errorMsg)
+{
+    const uint8_t *data = file.GetData();
+    size_t size = file.GetSize();
+    size_t searchEnd = size > EOCD_SIZE + MAX_ZIP_COMMENT_SIZE ? size - EOCD_SIZE - MAX_ZIP_COMMENT_SIZE : 0;
+    size_t eocd = size - EOCD_SIZE;
+    while (ReadUint32(data + eocd) != EOCD_SIGNATURE) {
+        if (eocd == searchEnd) {
+            errorMsg = "end of central directory is not found";
+            return false;
+        }
+        --eocd;
+    }
+    uint16_t entryCount = ReadUint16(data + eocd + 10);
+    uint32_t centralDirSize = ReadUint32(data + eocd + 12);
+    uint32_t centralDirOffset = ReadUint32(data + eocd + 16);
+    if (centralDirSize == ZIP64_MARK || centralDirOffset == ZIP64_MARK) {
+        errorMsg = "zip64 archive is not supported";
+        return false;
+    }
+    if (static_cast<size_t>(centralDirOffset) + centralDirSize > eocd) {
+        errorMsg = "central directory is out of the file";
+        return false;
+    }
+
+    bool isFound = false;
+    size_t offset = centralDirOffset;
+    size_t centralDirEnd = static_cast<size_t>(centralDirOffset) + centralDirSize;
+    for (uint16_t i = 0; i < entryCount; ++i) {
+        if (offset + CENTRAL_DIR_HEADER_SIZE > centralDirEnd ||
+            ReadUint32(data + offset) != CENTRAL_DIR_SIGNATURE) {
+            errorMsg = "central directory entry " + std::to_string(i) + " is broken";
+            return false;
+        }
+        const uint8_t *header = data + offset;
+        ZipEntry entry;
+        entry.flags = ReadUint16(header + 8);
+        entry.method = ReadUint16(header + 10);
+        entry.crc = ReadUint32(header + 16);
+        entry.compressedSize = ReadUint32(header + 20);
+        entry.size = ReadUint32(header + 24);
+        size_t nameLength = ReadUint16(header + 28);
+        size_t extraLength = ReadUint16(header + 30);
+        size_t commentLength = ReadUint16(header + 32);
+        entry.localHeaderOffset = ReadUint32(header + 42);
+        size_t entrySize = CENTRAL_DIR_HEADER_SIZE + nameLength + extraLength + commentLength;
+        if (offset + entrySize > centralDirEnd ||
+            static_cast<size_t>(entry.localHeaderOffset) + LOCAL_HEADER_SIZE > centralDirOffset ||
+            ReadUint32(data + entry.localHeaderOffset) != LOCAL_HEADER_SIGNATURE) {
+            errorMsg = "central directory entry " + std::to_string(i) + " is broken";
+            return false;
+        }
+        entry.name = std::string_view(reinterpret_cast<const char *>(header + CENTRAL_DIR_HEADER_SIZE), nameLength);
+        if (entry.name == entryName) {
+            foundEntry = entry;
+            isFound = true;
+        }
+        offset += entrySize;
+    }
+    if (!isFound) {
+        errorMsg = entryName + " is not found";
+        return false;
+    }
+    return true;
+}
+
+bool ExtractEntry(const MappedFile &file, const ZipEntry &entry, std::string &content, std::string &errorMsg)
+{
+    std::string entryName(entry.name);
+    const uint8_t *data = file.GetData();
+    const uint8_t *localHeader = data + entry.localHeaderOffset;
+    size_t dataOffset = entry.localHeaderOffset + LOCAL_HEADER_SIZE + ReadUint16(localHeader + 26) +
+        ReadUint16(localHeader + 28);
+    if ((entry.flags & FLAG_ENCRYPTED) != 0 || entry.size == 0 || entry.size > MAX_PROFILE_SIZE ||
+        dataOffset + entry.compressedSize > file.GetSize()) {
+        errorMsg = entryName + " is broken";
+        return false;
+    }
+    content.resize(entry.size);
+    if (entry.method == METHOD_STORED) {
+        if (entry.compressedSize != entry.size) {
+            errorMsg = entryName + " is broken";
+            return false;
+        }
+        std::copy(data + dataOffset, data + dataOffset + entry.size, content.begin());
+    } else if (entry.method == METHOD_DEFLATED) {
+        z_stream stream = {};
+        stream.next_in = const_cast<Bytef *>(data + dataOffset);
+        stream.avail_in = entry.compressedSize;
+        stream.next_out = reinterpret_cast<Bytef *>(&content[0]);
+        stream.avail_out = entry.size;
+        // a raw deflate stream without the zlib header
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            errorMsg = "inflate " + entryName + " failed";
+            return false;
+        }
+        int ret = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        if (ret != Z_STREAM_END || stream.total_out != entry.size) {
+            errorMsg = "inflate " + entryName + " failed";
+            return false;
+        }
+    } else {
+        errorMsg = "unsupported compression method " + std::to_string(entry.method);
+        return false;
+    }
+    uLong crc = crc32(0L, reinterpret_cast<const Bytef *>(content.data()), static_cast<uInt>(content.size()));
+    if (crc != entry.crc) {
+        errorMsg = entryName + " crc mismatch";
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+bool HapVerifier::VerifyArchive(const std::string &path, HapVerifyResult &result)
+{
+    result.path = path;
+    result.isValid = false;
+    result.errorMsg.clear();
+    MappedFile file;
+    ZipEntry entry;
+    std::string moduleJson;
+    if (!file.Map(path, result.errorMsg)) {
+        return false;
+    }
+    if (!FindEntry(file, MODULE_JSON_NAME, entry, result.errorMsg)) {
+        // an FA model archive has config.json instead of module.json, which is not checked here
+        ZipEntry configEntry;
+        std::string configErrorMsg;
+        if (FindEntry(file, CONFIG_JSON_NAME, configEntry, configErrorMsg)) {
+            result.errorMsg = FA_MODEL_NOT_SUPPORTED;
+        }
+        return false;
+    }
+    if (!ExtractEntry(file, entry, moduleJson, result.errorMsg)) {
+        return false;
+    }
+
+    Spm::InnerModuleInfoForSpm moduleInfo;
+    if (!Spm::ParseSpmModule(moduleJson, moduleInfo)) {
+        result.errorMsg = "parse " + MODULE_JSON_NAME + " failed";
+        return false;
+    }
+    nlohmann::json jsonObject = nlohmann::json::parse(moduleJson, nullptr, false);
+    if (jsonObject.is_discarded() || !jsonObject.contains(APP_KEY) ||
+        !jsonObject[APP_KEY].contains(VERSION_CODE_KEY) || !jsonObject[APP_KEY][VERSION_CODE_KEY].is_number()) {
+        result.errorMsg = "versionCode is not found in " + MODULE_JSON_NAME;
+        return false;
+    }
+    result.bundleName = moduleInfo.bundleName;
+    result.moduleName = moduleInfo.moduleName;
+    result.versionCode = jsonObject[APP_KEY][VERSION_CODE_KEY].get<int64_t>();
+    result.isValid = true;
+    return true;
+}
+
+bool HapVerifier::VerifyArchives(const std::vector<std::string> &paths, int32_t jobs, bool allowManyBundles,
+    std::vector<HapVerifyResult> &results, std::string &errorMsg)
+{
+    results.assign(paths.size(), HapVerifyResult());
+    BundleCommandCommon::ParallelFor(paths.size(), jobs, [&paths, &results](size_t index) {
+        VerifyArchive(paths[index], results[index]);
+    });
+
+    bool isValid = true;
+    for (const auto &result : results) {
+        if (!result.isValid) {
+            errorMsg.append(result.path + ": " + result.errorMsg + "\n");
+            isValid = false;
+        }
+    }
+    if (!isValid) {
+        return false;
+    }
+
+    // the first archive of a bundle decides the version, the others must agree with it
+    std::unordered_map<std::string, const HapVerifyResult *> firstArchives;
+    std::unordered_set<std::string> modules;
+    for (const auto &result : results) {
+        if (!allowManyBundles && result.bundleName != results.front().bundleName) {
+            errorMsg.append(result.path + ": bundleName " + result.bundleName + " is not the same as " +
+                results.front().bundleName + " of " + results.front().path + "\n");
+            isValid = false;
+            continue;
+        }
+        const HapVerifyResult &first = *firstArchives.emplace(result.bundleName, &result).first->second;
+        if (result.versionCode != first.versionCode) {
+            errorMsg.append(result.path + ": versionCode " + std::to_string(result.versionCode) +
+                " is not the same as " + std::to_string(first.versionCode) + " of " + first.path + "\n");
+            isValid = false;
+        }
+        if (!modules.insert(result.bundleName + "/" + result.moduleName).second) {
+            errorMsg.append(result.path + ": module " + result.moduleName + " is repeated\n");
+            isValid = false;
+        }
+    }
+    return isValid;
+}
+
+bool HapVerifier::GetQuickFixBundleName(const std::string &path, std::string &bundleName, std::string &errorMsg)
+{
+    MappedFile file;
+    ZipEntry entry;
+    std::string patchJson;
+    if (!file.Map(path, errorMsg) || !FindEntry(file, PATCH_JSON_NAME, entry, errorMsg) ||
+        !ExtractEntry(file, entry, patchJson, errorMsg)) {
+        return false;
+    }
+    nlohmann::json jsonObject = nlohmann::json::parse(patchJson, nullptr, false);
+    if (jsonObject.is_discarded() || !jsonObject.contains(APP_KEY) ||
+        !jsonObject[APP_KEY].contains(BUNDLE_NAME_KEY) || !jsonObject[APP_KEY][BUNDLE_NAME_KEY].is_string() ||
+        jsonObject[APP_KEY][BUNDLE_NAME_KEY].get<std::string>().empty()) {
+        errorMsg = "bundleName is not found in " + PATCH_JSON_NAME;
+        return false;
+    }
+    bundleName = jsonObject[APP_KEY][BUNDLE_NAME_KEY].get<std::string>();
+    return true;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
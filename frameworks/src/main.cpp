@@ -15,11 +15,15 @@
 
 #include "app_log_wrapper.h"
 #include "bundle_command.h"
+#include "completion.h"
+#include "output_sink.h"
 
 int main(int argc, char *argv[])
 {
     APP_LOGI("bm exec start");
+    OHOS::AppExecFwk::CompletionSignal::InstallInterruptHandler();
     OHOS::AppExecFwk::BundleManagerShellCommand cmd(argc, argv);
+    cmd.SetOutputSink(std::make_shared<OHOS::AppExecFwk::StdoutSink>());
     std::cout << cmd.ExecCommand();
     APP_LOGI("bm exec end");
     quick_exit(0);
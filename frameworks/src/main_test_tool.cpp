@@ -14,10 +14,14 @@
  */
 
 #include "bundle_test_tool.h"
+#include "completion.h"
+#include "output_sink.h"
 
 int main(int argc, char *argv[])
 {
+    OHOS::AppExecFwk::CompletionSignal::InstallInterruptHandler();
     OHOS::AppExecFwk::BundleTestTool cmd(argc, argv);
+    cmd.SetOutputSink(std::make_shared<OHOS::AppExecFwk::StdoutSink>());
     std::cout << cmd.ExecCommand();
     return 0;
 }
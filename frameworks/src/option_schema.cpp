@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "option_schema.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// the descriptions line up with the hand written help messages of the tools
+constexpr size_t HELP_DESCRIPTION_COLUMN = 41;
+constexpr size_t HELP_CONTINUATION_COLUMN = 43;
+constexpr size_t HELP_MIN_GAP = 2;
+constexpr size_t JSON_UNICODE_ESCAPE_SIZE = 6;
+}  // namespace
+
+bool OptionSchemaHelper::ParseInt32(const char *text, int32_t minValue, int32_t maxValue, int32_t &value)
+{
+    if (text == nullptr) {
+        return false;
+    }
+    const char *end = text + std::strlen(text);
+    int32_t parsed = 0;
+    auto [ptr, ec] = std::from_chars(text, end, parsed);
+    if (ec != std::errc() || ptr != end || ptr == text || parsed < minValue || parsed > maxValue) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+void OptionSchemaHelper::AppendHelpLine(const OptionSpec &spec, std::string &help)
+{
+    size_t lineBegin = help.size();
+    help.append("  ");
+    if (spec.shortName != '\0') {
+        help.push_back('-');
+        help.push_back(spec.shortName);
+        help.append(", ");
+    }
+    help.append("--").append(spec.longName);
+    if (spec.type != OptionType::FLAG) {
+        help.append(" <").append(spec.valueName).append(">");
+    }
+    size_t width = help.size() - lineBegin;
+    help.append(width + HELP_MIN_GAP > HELP_DESCRIPTION_COLUMN ? HELP_MIN_GAP : HELP_DESCRIPTION_COLUMN - width, ' ');
+    for (const char *ch = spec.description; *ch != '\0'; ++ch) {
+        help.push_back(*ch);
+        if (*ch == '\n') {
+            help.append(HELP_CONTINUATION_COLUMN, ' ');
+        }
+    }
+    help.push_back('\n');
+}
+
+void OptionSchemaHelper::AppendSchemaProperty(const OptionSpec &spec, std::string &schema)
+{
+    AppendSchemaString(ToCamelCase(spec.longName), schema);
+    switch (spec.type) {
+        case OptionType::FLAG:
+            schema.append(":{\"type\":\"boolean\",\"default\":false}");
+            return;
+        case OptionType::STRING:
+            schema.append(":{\"type\":\"string\",\"description\":");
+            AppendSchemaString(spec.description, schema);
+            schema.append(",\"default\":\"\"}");
+            return;
+        case OptionType::STRING_LIST:
+            schema.append(":{\"type\":\"array\",\"items\":{\"type\":\"string\"},\"description\":");
+            AppendSchemaString(spec.description, schema);
+            schema.push_back('}');
+            return;
+        case OptionType::INT32:
+            schema.append(":{\"type\":\"integer\",\"description\":");
+            AppendSchemaString(spec.description, schema);
+            schema.append(",\"minimum\":").append(std::to_string(spec.minValue));
+            schema.append(",\"maximum\":").append(std::to_string(spec.maxValue)).push_back('}');
+            return;
+        default:
+            schema.append(":{}");
+            return;
+    }
+}
+
+void OptionSchemaHelper::AppendSchemaString(std::string_view text, std::string &schema)
+{
+    schema.push_back('"');
+    bool isLineBreak = false;
+    for (char ch : text) {
+        // the help text breaks long descriptions, the schema keeps them on one line
+        if (ch == '\n') {
+            isLineBreak = true;
+            continue;
+        }
+        if (isLineBreak) {
+            isLineBreak = false;
+            schema.push_back(' ');
+        }
+        if (ch == '"' || ch == '\\') {
+            schema.push_back('\\');
+            schema.push_back(ch);
+        } else if (static_cast<unsigned char>(ch) < ' ') {
+            char escaped[JSON_UNICODE_ESCAPE_SIZE + 1] = {0};
+            (void)snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(ch));
+            schema.append(escaped);
+        } else {
+            schema.push_back(ch);
+        }
+    }
+    schema.push_back('"');
+}
+
+std::string OptionSchemaHelper::ToCamelCase(std::string_view longName)
+{
+    std::string name;
+    name.reserve(longName.size());
+    bool isUpper = false;
+    for (char ch : longName) {
+        if (ch == '-') {
+            isUpper = true;
+            continue;
+        }
+        name.push_back(isUpper ? static_cast<char>(std::toupper(static_cast<unsigned char>(ch))) : ch);
+        isUpper = false;
+    }
+    return name;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -15,16 +15,146 @@
 
 #include "quick_fix_command.h"
 
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+
 #include "app_log_wrapper.h"
+#include "appexecfwk_errors.h"
+#include "bundle_command_common.h"
 #include "common_event_data.h"
 #include "common_event_manager.h"
 #include "common_event_support.h"
+#include "completion.h"
+#include "content_hash_cache.h"
+#include "directory_ex.h"
+#include "hap_verifier.h"
 #include "quick_fix_manager_client.h"
 #include "status_receiver_impl.h"
+#include "string_ex.h"
+#include "text_builder.h"
 #include "want.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+constexpr int32_t QUICK_FIX_APPLY_PARALLEL_NUMBER = 4;
+constexpr int32_t QUICK_FIX_APPLY_WAITTING_TIME = 180; // Same with the waitting time of StatusReceiverImpl.
+const std::string QUICK_FIX_FILE_SUFFIX = ".hqf";
+// the reserved text of GetQuickFixInfoString, typical paths fit without a reallocation
+constexpr size_t QUICK_FIX_INFO_SIZE = 512;
+constexpr size_t MODULE_QUICK_FIX_INFO_SIZE = 256;
+
+struct QuickFixApplyResult {
+    std::string bundleName;
+    int32_t applyResult = ERR_OK;
+    std::string resultInfo;
+};
+
+void RecordAppliedQuickFix(const std::vector<std::string> &realPaths, const std::string &bundleName,
+    std::vector<ContentHashEntry> &fileEntries, ContentHashCache &hashCache)
+{
+    AAFwk::ApplicationQuickFixInfo quickFixInfo;
+    if (bundleName.empty() ||
+        AAFwk::QuickFixManagerClient::GetInstance()->GetApplyedQuickFixInfo(bundleName, quickFixInfo) != ERR_OK) {
+        APP_LOGW("get applied quick fix of %{public}s failed", bundleName.c_str());
+        return;
+    }
+    std::string buildId = ContentHashCache::ComputeTextHash(QuickFixCommand::GetQuickFixInfoString(quickFixInfo));
+    for (size_t index = 0; index < realPaths.size() && index < fileEntries.size(); ++index) {
+        if (fileEntries[index].hash.empty()) {
+            continue;
+        }
+        fileEntries[index].bundleName = bundleName;
+        fileEntries[index].versionCode = static_cast<int64_t>(quickFixInfo.appqfInfo.versionCode);
+        fileEntries[index].buildId = buildId;
+        hashCache.Update(realPaths[index], fileEntries[index]);
+    }
+    if (!hashCache.Save()) {
+        APP_LOGW("save content hash cache failed");
+    }
+}
+
+// an apply which is not recorded replaces the patch of its bundle, so the entries of the bundle are outdated
+void ForgetAppliedQuickFix(const std::vector<std::string> &bundleNames)
+{
+    if (bundleNames.empty()) {
+        return;
+    }
+    ContentHashCache hashCache;
+    hashCache.Load();
+    bool isErased = false;
+    for (const auto &bundleName : bundleNames) {
+        isErased = hashCache.Erase(bundleName) || isErased;
+    }
+    if (isErased && !hashCache.Save()) {
+        APP_LOGW("save content hash cache failed");
+    }
+}
+
+// the hqf files of a patch set, a directory stands for the hqf files directly under it
+bool ListQuickFixFiles(const std::string &path, std::vector<std::string> &hqfFiles, std::string &errorMsg)
+{
+    struct stat pathStat;
+    if (stat(path.c_str(), &pathStat) != 0) {
+        errorMsg = path + ": can not open the file";
+        return false;
+    }
+    if (!S_ISDIR(pathStat.st_mode)) {
+        hqfFiles.emplace_back(path);
+        return true;
+    }
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        errorMsg = path + ": can not open the directory";
+        return false;
+    }
+    std::string prefix = path.back() == '/' ? path : path + "/";
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string fileName = entry->d_name;
+        if (EndsWith(fileName, QUICK_FIX_FILE_SUFFIX)) {
+            hqfFiles.emplace_back(prefix + fileName);
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
+// the bundle of a patch set is read from the patch.json of its hqf files, all of them must belong to one bundle
+bool GetPatchSetBundleName(const std::vector<std::string> &quickFixFiles, std::string &bundleName,
+    std::string &errorMsg)
+{
+    std::vector<std::string> hqfFiles;
+    for (const auto &quickFixFile : quickFixFiles) {
+        if (!ListQuickFixFiles(quickFixFile, hqfFiles, errorMsg)) {
+            return false;
+        }
+    }
+    if (hqfFiles.empty()) {
+        errorMsg = "no hqf file is found";
+        return false;
+    }
+    bundleName.clear();
+    for (const auto &hqfFile : hqfFiles) {
+        std::string fileBundleName;
+        if (!HapVerifier::GetQuickFixBundleName(hqfFile, fileBundleName, errorMsg)) {
+            errorMsg = hqfFile + ": " + errorMsg;
+            return false;
+        }
+        if (!bundleName.empty() && fileBundleName != bundleName) {
+            errorMsg = hqfFile + ": bundleName " + fileBundleName + " is not the same as " + bundleName;
+            return false;
+        }
+        bundleName = fileBundleName;
+    }
+    return true;
+}
+} // namespace
+
 class ApplyQuickFixMonitor : public EventFwk::CommonEventSubscriber,
                              public std::enable_shared_from_this<ApplyQuickFixMonitor> {
 public:
@@ -44,6 +174,7 @@ public:
         APP_LOGD("bundleName: %{public}s, applyResult: %{public}d, resultInfo: %{public}s.",
             bundleName.c_str(), applyResult, resultInfo.c_str());
         resultInfo_ = resultInfo;
+        bundleName_ = bundleName;
         statusReceiver_->OnFinished(applyResult, resultInfo);
     }
 
@@ -52,13 +183,78 @@ public:
         return resultInfo_;
     }
 
+    std::string GetBundleName()
+    {
+        return bundleName_;
+    }
+
 private:
     sptr<StatusReceiverImpl> statusReceiver_ = nullptr;
     std::string resultInfo_;
+    std::string bundleName_;
+};
+
+// one subscriber shared by the patch sets of many bundles, each patch set owns a slot keyed by its bundle, a result
+// fills the first open slot of its bundle and the result of a bundle outside the patch sets is ignored
+class ApplyQuickFixesMonitor : public EventFwk::CommonEventSubscriber {
+public:
+    ApplyQuickFixesMonitor(const EventFwk::CommonEventSubscribeInfo &subscribeInfo,
+        const std::vector<std::string> &slotBundleNames)
+        : EventFwk::CommonEventSubscriber(subscribeInfo), slotBundleNames_(slotBundleNames),
+        isFilled_(slotBundleNames.size(), false), results_(slotBundleNames.size())
+    {}
+
+    virtual ~ApplyQuickFixesMonitor() = default;
+
+    void OnReceiveEvent(const EventFwk::CommonEventData &eventData) override
+    {
+        AAFwk::Want want = eventData.GetWant();
+        QuickFixApplyResult result;
+        result.bundleName = want.GetStringParam("bundleName");
+        result.applyResult = want.GetIntParam("applyResult", -1);
+        result.resultInfo = want.GetStringParam("applyResultInfo");
+        APP_LOGD("bundleName: %{public}s, applyResult: %{public}d, resultInfo: %{public}s.",
+            result.bundleName.c_str(), result.applyResult, result.resultInfo.c_str());
+        std::lock_guard<std::mutex> lock(slotMutex_);
+        for (size_t slot = 0; slot < slotBundleNames_.size(); ++slot) {
+            if (!isFilled_[slot] && !result.bundleName.empty() && slotBundleNames_[slot] == result.bundleName) {
+                isFilled_[slot] = true;
+                results_[slot].SetValue(result);
+                return;
+            }
+        }
+        APP_LOGW("ignore apply result of %{public}s", result.bundleName.c_str());
+    }
+
+    // waits for the given slots, isReady tells which of them got a result before the timeout
+    void WaitForResults(const std::vector<size_t> &slots, std::vector<QuickFixApplyResult> &results,
+        std::vector<bool> &isReady) const
+    {
+        std::vector<const CompletionSignal *> signals;
+        for (size_t slot : slots) {
+            signals.emplace_back(&results_[slot]);
+        }
+        if (CompletionSignal::WaitAll(signals, Deadline::After(std::chrono::seconds(QUICK_FIX_APPLY_WAITTING_TIME))) !=
+            CompletionSignal::WaitResult::READY) {
+            APP_LOGW("wait for apply results of %{public}zu patch sets failed", signals.size());
+        }
+        results.assign(slots.size(), QuickFixApplyResult());
+        isReady.assign(slots.size(), false);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            isReady[i] = results_[slots[i]].Wait(Deadline::After(std::chrono::milliseconds(0)), results[i]) ==
+                CompletionSignal::WaitResult::READY;
+        }
+    }
+
+private:
+    std::mutex slotMutex_;
+    const std::vector<std::string> slotBundleNames_;
+    std::vector<bool> isFilled_;
+    std::vector<Completion<QuickFixApplyResult>> results_;
 };
 
 int32_t QuickFixCommand::ApplyQuickFix(const std::vector<std::string> &quickFixFiles, std::string &resultInfo,
-    bool isDebug, bool isReplace)
+    bool isDebug, bool isReplace, bool isForce)
 {
     if (quickFixFiles.empty()) {
         resultInfo.append("quick fix file is empty.\n");
@@ -71,6 +267,27 @@ int32_t QuickFixCommand::ApplyQuickFix(const std::vector<std::string> &quickFixF
 
     APP_LOGI("IsDEBUG is %{public}d isReplace is %{public}d", isDebug, isReplace);
 
+    bool isSkipUnchanged = !isForce && ContentHashCache::IsSkipUnchangedEnabled();
+    ContentHashCache hashCache;
+    std::vector<std::string> realPaths;
+    std::vector<ContentHashEntry> fileEntries;
+    if (isSkipUnchanged) {
+        hashCache.Load();
+        ContentHashEntry record;
+        AAFwk::ApplicationQuickFixInfo quickFixInfo;
+        if (IsQuickFixUnchanged(quickFixFiles, hashCache, realPaths, fileEntries, record) &&
+            AAFwk::QuickFixManagerClient::GetInstance()->GetApplyedQuickFixInfo(record.bundleName,
+            quickFixInfo) == ERR_OK && IsQuickFixStillApplied(record, quickFixInfo)) {
+            int64_t avoidedSize = 0;
+            for (const auto &entry : fileEntries) {
+                avoidedSize += entry.size;
+            }
+            resultInfo.append("apply quickfix succeed.\n");
+            resultInfo.append(ContentHashCache::FormatAvoidedSize(fileEntries.size(), avoidedSize));
+            return ERR_OK;
+        }
+    }
+
     sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl());
     if (statusReceiver == nullptr) {
         resultInfo.append("Create status receiver failed.\n");
@@ -89,6 +306,12 @@ int32_t QuickFixCommand::ApplyQuickFix(const std::vector<std::string> &quickFixF
         APP_LOGD("Waiting apply finished.");
         result = statusReceiver->GetResultCode();
     }
+    EventFwk::CommonEventManager::UnsubscribeCommonEvent(applyMonitor);
+    if (isSkipUnchanged && result == ERR_OK) {
+        RecordAppliedQuickFix(realPaths, applyMonitor->GetBundleName(), fileEntries, hashCache);
+    } else if (result == ERR_OK && !applyMonitor->GetBundleName().empty()) {
+        ForgetAppliedQuickFix({ applyMonitor->GetBundleName() });
+    }
 
     if (result == ERR_OK) {
         resultInfo.append("apply quickfix succeed.\n");
@@ -103,6 +326,144 @@ int32_t QuickFixCommand::ApplyQuickFix(const std::vector<std::string> &quickFixF
     return result;
 }
 
+int32_t QuickFixCommand::ApplyQuickFixes(const std::vector<std::vector<std::string>> &patchSets,
+    std::string &resultInfo, bool isDebug, bool isReplace, bool isForce)
+{
+    if (patchSets.size() <= 1) {
+        return ApplyQuickFix(patchSets.empty() ? std::vector<std::string>() : patchSets.front(), resultInfo,
+            isDebug, isReplace, isForce);
+    }
+    APP_LOGI("apply %{public}zu patch sets, IsDEBUG is %{public}d isReplace is %{public}d",
+        patchSets.size(), isDebug, isReplace);
+
+    // a set whose bundle is unknown is not applied, its result could not be told from the results of other sets
+    std::vector<std::string> bundleNames(patchSets.size());
+    std::vector<std::string> resolveErrors(patchSets.size());
+    std::vector<int32_t> applyResults(patchSets.size(), ERR_OK);
+    for (size_t index = 0; index < patchSets.size(); ++index) {
+        if (!GetPatchSetBundleName(patchSets[index], bundleNames[index], resolveErrors[index])) {
+            bundleNames[index].clear();
+            applyResults[index] = ERR_INVALID_VALUE;
+        }
+    }
+
+    EventFwk::MatchingSkills matchingSkills;
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_QUICK_FIX_APPLY_RESULT);
+    EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
+    auto applyMonitor = std::make_shared<ApplyQuickFixesMonitor>(subscribeInfo, bundleNames);
+    // subscribe before the first apply, a result is never published before its apply is accepted
+    if (!EventFwk::CommonEventManager::SubscribeCommonEvent(applyMonitor)) {
+        resultInfo.append("subscribe quickfix apply result failed.\n");
+        return ERR_INVALID_VALUE;
+    }
+    BundleCommandCommon::ParallelFor(patchSets.size(), QUICK_FIX_APPLY_PARALLEL_NUMBER,
+        [&patchSets, &bundleNames, &applyResults, isDebug, isReplace](size_t index) {
+            if (!bundleNames[index].empty()) {
+                applyResults[index] =
+                    AAFwk::QuickFixManagerClient::GetInstance()->ApplyQuickFix(patchSets[index], isDebug, isReplace);
+            }
+        });
+    // the results of one bundle are not told apart, so its accepted sets take the first slots of the bundle in order
+    std::map<std::string, std::vector<size_t>> bundleSlots;
+    for (size_t index = 0; index < patchSets.size(); ++index) {
+        if (!bundleNames[index].empty()) {
+            bundleSlots[bundleNames[index]].emplace_back(index);
+        }
+    }
+    std::vector<size_t> waitSlots;
+    std::vector<size_t> waitSets;
+    for (const auto &item : bundleSlots) {
+        size_t slot = 0;
+        for (size_t index : item.second) {
+            if (applyResults[index] == ERR_OK) {
+                waitSlots.emplace_back(item.second[slot++]);
+                waitSets.emplace_back(index);
+            }
+        }
+    }
+    std::vector<QuickFixApplyResult> waitResults;
+    std::vector<bool> isReady;
+    applyMonitor->WaitForResults(waitSlots, waitResults, isReady);
+    EventFwk::CommonEventManager::UnsubscribeCommonEvent(applyMonitor);
+    std::vector<const QuickFixApplyResult *> setResults(patchSets.size(), nullptr);
+    for (size_t i = 0; i < waitSets.size(); ++i) {
+        setResults[waitSets[i]] = isReady[i] ? &waitResults[i] : nullptr;
+    }
+
+    int32_t result = ERR_OK;
+    size_t failCount = 0;
+    std::vector<std::string> appliedBundleNames;
+    for (size_t index = 0; index < patchSets.size(); ++index) {
+        int32_t setResult = applyResults[index];
+        resultInfo.append("patch set " + std::to_string(index + 1) + ": ");
+        if (!bundleNames[index].empty()) {
+            resultInfo.append("bundleName: " + bundleNames[index] + ", ");
+        }
+        if (!resolveErrors[index].empty()) {
+            resultInfo.append("apply quickfix failed with error: " + resolveErrors[index] + ".\n");
+        } else if (setResult != ERR_OK) {
+            resultInfo.append("apply quickfix failed with errno: " + std::to_string(setResult) + ".\n");
+        } else if (setResults[index] == nullptr) {
+            resultInfo.append("apply quickfix timed out.\n");
+            setResult = ERR_OPERATION_TIME_OUT;
+        } else if (setResults[index]->applyResult == ERR_OK) {
+            resultInfo.append("apply quickfix succeed.\n");
+            appliedBundleNames.emplace_back(bundleNames[index]);
+        } else {
+            setResult = setResults[index]->applyResult;
+            resultInfo.append(setResults[index]->resultInfo.empty() ?
+                "apply quickfix failed with errno: " + std::to_string(setResult) + ".\n" :
+                "apply quickfix failed with error: " + setResults[index]->resultInfo + ".\n");
+        }
+        if (setResult != ERR_OK) {
+            ++failCount;
+            result = (result == ERR_OK) ? setResult : result;
+        }
+    }
+    ForgetAppliedQuickFix(appliedBundleNames);
+    resultInfo.append("patch set count: " + std::to_string(patchSets.size()) + ", success count: " +
+        std::to_string(patchSets.size() - failCount) + ", fail count: " + std::to_string(failCount) + "\n");
+    return result;
+}
+
+bool QuickFixCommand::IsQuickFixUnchanged(const std::vector<std::string> &quickFixFiles,
+    const ContentHashCache &hashCache, std::vector<std::string> &realPaths, std::vector<ContentHashEntry> &fileEntries,
+    ContentHashEntry &record)
+{
+    realPaths.assign(quickFixFiles.size(), "");
+    fileEntries.assign(quickFixFiles.size(), ContentHashEntry());
+    bool isUnchanged = !quickFixFiles.empty();
+    for (size_t index = 0; index < quickFixFiles.size(); ++index) {
+        // a directory is not hashed, so it is always applied
+        if (!PathToRealPath(quickFixFiles[index], realPaths[index]) ||
+            !ContentHashCache::ComputeHash(realPaths[index], fileEntries[index].hash, fileEntries[index].size)) {
+            fileEntries[index].hash.clear();
+            isUnchanged = false;
+            continue;
+        }
+        ContentHashEntry cachedEntry;
+        if (!isUnchanged ||
+            !hashCache.Lookup(realPaths[index], fileEntries[index].hash, fileEntries[index].size, cachedEntry) ||
+            (index > 0 && (cachedEntry.bundleName != record.bundleName ||
+            cachedEntry.versionCode != record.versionCode || cachedEntry.buildId != record.buildId))) {
+            isUnchanged = false;
+            continue;
+        }
+        if (index == 0) {
+            record = cachedEntry;
+        }
+    }
+    return isUnchanged;
+}
+
+bool QuickFixCommand::IsQuickFixStillApplied(const ContentHashEntry &record,
+    const AAFwk::ApplicationQuickFixInfo &quickFixInfo)
+{
+    // a patch of the same version applied in between has other module hashes or paths in the applied info
+    return static_cast<int64_t>(quickFixInfo.appqfInfo.versionCode) == record.versionCode &&
+        ContentHashCache::ComputeTextHash(GetQuickFixInfoString(quickFixInfo)) == record.buildId;
+}
+
 int32_t QuickFixCommand::GetApplyedQuickFixInfo(const std::string &bundleName, std::string &resultInfo)
 {
     if (bundleName.empty()) {
@@ -124,27 +485,29 @@ int32_t QuickFixCommand::GetApplyedQuickFixInfo(const std::string &bundleName, s
 
 std::string QuickFixCommand::GetQuickFixInfoString(const AAFwk::ApplicationQuickFixInfo &quickFixInfo)
 {
-    std::string info = "ApplicationQuickFixInfo:\n";
-    info.append("  bundle name: " + quickFixInfo.bundleName + "\n");
-    info.append("  bundle version code: " + std::to_string(quickFixInfo.bundleVersionCode) + "\n");
-    info.append("  bundle version name: " + quickFixInfo.bundleVersionName + "\n");
-    AppqfInfo appqfInfo = quickFixInfo.appqfInfo;
-    info.append("  patch version code: " + std::to_string(appqfInfo.versionCode) + "\n");
-    info.append("  patch version name: " + appqfInfo.versionName + "\n");
-    info.append("  cpu abi: " + appqfInfo.cpuAbi + "\n");
-    info.append("  native library path: " + appqfInfo.nativeLibraryPath + "\n");
-    std::string type;
+    const AppqfInfo &appqfInfo = quickFixInfo.appqfInfo;
+    std::string info;
+    TextBuilder builder(info, QUICK_FIX_INFO_SIZE + appqfInfo.hqfInfos.size() * MODULE_QUICK_FIX_INFO_SIZE);
+    builder.AppendLine("ApplicationQuickFixInfo:");
+    builder.AppendLine("  bundle name: ", quickFixInfo.bundleName);
+    builder.AppendLine("  bundle version code: ", quickFixInfo.bundleVersionCode);
+    builder.AppendLine("  bundle version name: ", quickFixInfo.bundleVersionName);
+    builder.AppendLine("  patch version code: ", appqfInfo.versionCode);
+    builder.AppendLine("  patch version name: ", appqfInfo.versionName);
+    builder.AppendLine("  cpu abi: ", appqfInfo.cpuAbi);
+    builder.AppendLine("  native library path: ", appqfInfo.nativeLibraryPath);
+    const char *type = "";
     if (appqfInfo.type == AppExecFwk::QuickFixType::PATCH) {
         type = "patch";
     } else if (appqfInfo.type == AppExecFwk::QuickFixType::HOT_RELOAD) {
         type = "hotreload";
     }
-    info.append("  type: " + type + "\n");
-    for (auto hqfInfo : appqfInfo.hqfInfos) {
-        info.append("  ModuelQuickFixInfo:\n");
-        info.append("    module name: " + hqfInfo.moduleName + "\n");
-        info.append("    module sha256: " + hqfInfo.hapSha256 + "\n");
-        info.append("    file path: " + hqfInfo.hqfFilePath + "\n");
+    builder.AppendLine("  type: ", type);
+    for (const auto &hqfInfo : appqfInfo.hqfInfos) {
+        builder.AppendLine("  ModuelQuickFixInfo:");
+        builder.AppendLine("    module name: ", hqfInfo.moduleName);
+        builder.AppendLine("    module sha256: ", hqfInfo.hapSha256);
+        builder.AppendLine("    file path: ", hqfInfo.hqfFilePath);
     }
 
     return info;
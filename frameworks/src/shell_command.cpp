@@ -15,26 +15,77 @@
 
 #include "shell_command.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <getopt.h>
 #include "app_log_wrapper.h"
+#include "command_trace.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+constexpr const char *DEFAULT_TRACE_TARGET = "summary";
+constexpr const char *SUMMARY_TRACE_ENV = "1";
+constexpr const char *DISABLED_TRACE_ENV = "0";
+
+// "--trace" prints the summary line, "--trace=<file>" writes chrome trace-event json to the file
+bool ParseTraceOption(const char *arg, std::string &traceTarget)
+{
+    size_t optionLength = strlen(CommandTrace::TRACE_OPTION);
+    if (arg == nullptr || strncmp(arg, CommandTrace::TRACE_OPTION, optionLength) != 0) {
+        return false;
+    }
+    if (arg[optionLength] == '\0') {
+        traceTarget = DEFAULT_TRACE_TARGET;
+        return true;
+    }
+    if (arg[optionLength] != '=') {
+        return false;
+    }
+    traceTarget = arg[optionLength + 1] == '\0' ? DEFAULT_TRACE_TARGET : arg + optionLength + 1;
+    return true;
+}
+
+// "1" or "summary" prints the summary line, a path with a '/' gets the json, anything else disables the trace
+std::string ParseTraceEnv(const char *value)
+{
+    std::string traceTarget = value == nullptr ? "" : value;
+    if (traceTarget == SUMMARY_TRACE_ENV || traceTarget == DEFAULT_TRACE_TARGET) {
+        return DEFAULT_TRACE_TARGET;
+    }
+    if (traceTarget.find('/') != std::string::npos) {
+        return traceTarget;
+    }
+    if (!traceTarget.empty() && traceTarget != DISABLED_TRACE_ENV) {
+        APP_LOGW("ignore %{public}s=%{public}s", CommandTrace::TRACE_ENV, traceTarget.c_str());
+    }
+    return "";
+}
+}  // namespace
 
 ShellCommand::ShellCommand(int argc, char *argv[], std::string name)
 {
     opterr = 0;
+    std::string traceTarget = ParseTraceEnv(getenv(CommandTrace::TRACE_ENV));
+    // the trace option belongs to the tool, the command sees its usual argv in a copy, the argv of the caller
+    // is left as it is, argv[argc] is copied too for the commands which read it
+    args_.assign(argv, argv + argc + 1);
+    if (argc >= MIN_ARGUMENT_NUMBER && ParseTraceOption(args_[1], traceTarget)) {
+        args_.erase(args_.begin() + 1);
+        --argc;
+    }
+    CommandTrace::Start(traceTarget);
     argc_ = argc;
-    argv_ = argv;
+    argv_ = args_.data();
     name_ = name;
 
     if (argc < MIN_ARGUMENT_NUMBER) {
         cmd_ = "help";
         return;
     }
-    cmd_ = argv[1];
+    cmd_ = argv_[1];
     for (int i = 2; i < argc; i++) {
-        argList_.push_back(argv[i]);
+        argList_.push_back(argv_[i]);
     }
 }
 
@@ -72,16 +123,42 @@ std::string ShellCommand::ExecCommand()
         APP_LOGE("failed to create message map.\n");
     }
 
-    result = OnCommand();
+    result = TracedCall("ShellCommand::OnCommand", TraceCategory::COMMAND, [this]() { return OnCommand(); });
     if (result != OHOS::ERR_OK) {
         APP_LOGE("failed to execute your command.\n");
 
         resultReceiver_ = "error: failed to execute your command.\n";
     }
 
+    if (outputSink_ != nullptr) {
+        CommandTraceSpan outputSpan("OutputSink::Flush", TraceCategory::OUTPUT);
+        outputSink_->Write(std::move(resultReceiver_));
+        outputSink_->Flush();
+        resultReceiver_.clear();
+    }
+    CommandTrace::Finish();
     return resultReceiver_;
 }
 
+void ShellCommand::SetOutputSink(const std::shared_ptr<OutputSink> &outputSink)
+{
+    outputSink_ = outputSink;
+}
+
+void ShellCommand::WriteOutput(std::string &&data)
+{
+    if (outputSink_ == nullptr) {
+        resultReceiver_.append(data);
+        return;
+    }
+    CommandTraceSpan outputSpan("OutputSink::Write", TraceCategory::OUTPUT);
+    if (!resultReceiver_.empty()) {
+        outputSink_->Write(std::move(resultReceiver_));
+        resultReceiver_.clear();
+    }
+    outputSink_->Write(std::move(data));
+}
+
 std::string ShellCommand::GetCommandErrorMsg() const
 {
     std::string commandErrorMsg =
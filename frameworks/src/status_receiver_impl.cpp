@@ -23,12 +23,14 @@ namespace {
 const int32_t MINIMUM_WAITTING_TIME = 180; // 3 mins
 } // namespace
 
-StatusReceiverImpl::StatusReceiverImpl(int32_t waittingTime) : waittingTime_(waittingTime)
+StatusReceiverImpl::StatusReceiverImpl(int32_t waittingTime)
+    : waittingTime_(waittingTime), beginTime_(std::chrono::steady_clock::now())
 {
     APP_LOGI("create status receiver instance");
 }
 
-StatusReceiverImpl::StatusReceiverImpl() : waittingTime_(MINIMUM_WAITTING_TIME)
+StatusReceiverImpl::StatusReceiverImpl()
+    : waittingTime_(MINIMUM_WAITTING_TIME), beginTime_(std::chrono::steady_clock::now())
 {
     APP_LOGI("create status receiver instance");
 }
@@ -41,37 +43,77 @@ StatusReceiverImpl::~StatusReceiverImpl()
 void StatusReceiverImpl::OnFinished(const int32_t resultCode, const std::string &resultMsg)
 {
     APP_LOGI("on finished result is %{public}d, %{public}s", resultCode, resultMsg.c_str());
-    std::lock_guard<std::mutex> lock(setValueMutex_);
-    if (!isSetValue) {
-        isSetValue = true;
-        resultCodeSignal_.set_value(resultCode);
-        resultMsgSignal_.set_value(resultMsg);
-    } else {
-        APP_LOGW("resultCodeSignal_ is set");
+    int64_t expected = -1;
+    finishTime_.compare_exchange_strong(expected, GetElapsedTime());
+    if (!result_.SetValue(std::make_pair(resultCode, resultMsg))) {
+        APP_LOGW("result of the receiver is set");
     }
 }
 
 void StatusReceiverImpl::OnStatusNotify(const int progress)
 {
     APP_LOGI("on OnStatusNotify is %{public}d", progress);
+    int64_t elapsedTime = GetElapsedTime();
+    int64_t expected = -1;
+    firstProgressTime_.compare_exchange_strong(expected, elapsedTime);
+    std::lock_guard<std::mutex> lock(progressMutex_);
+    if (progressCallback_ != nullptr) {
+        progressCallback_(progress, elapsedTime);
+    }
+}
+
+void StatusReceiverImpl::SetProgressCallback(const ProgressCallback &callback)
+{
+    std::lock_guard<std::mutex> lock(progressMutex_);
+    progressCallback_ = callback;
+}
+
+int64_t StatusReceiverImpl::GetFirstProgressTime() const
+{
+    return firstProgressTime_.load();
+}
+
+int64_t StatusReceiverImpl::GetFinishTime() const
+{
+    return finishTime_.load();
+}
+
+int64_t StatusReceiverImpl::GetElapsedTime() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - beginTime_).count();
+}
+
+const CompletionSignal &StatusReceiverImpl::GetCompletion() const
+{
+    return result_;
+}
+
+CompletionSignal::WaitResult StatusReceiverImpl::WaitForResult(std::pair<int32_t, std::string> &result) const
+{
+    CompletionSignal::WaitResult waitResult =
+        result_.Wait(Deadline::After(std::chrono::seconds(waittingTime_)), result);
+    if (waitResult == CompletionSignal::WaitResult::CANCELED) {
+        APP_LOGW("wait for the result is canceled");
+    }
+    return waitResult;
 }
 
 int32_t StatusReceiverImpl::GetResultCode() const
 {
-    auto future = resultCodeSignal_.get_future();
-    if (future.wait_for(std::chrono::seconds(waittingTime_)) == std::future_status::ready) {
-        int32_t resultCode = future.get();
-        return resultCode;
+    std::pair<int32_t, std::string> result;
+    CompletionSignal::WaitResult waitResult = WaitForResult(result);
+    if (waitResult == CompletionSignal::WaitResult::READY) {
+        return result.first;
     }
-    return ERR_OPERATION_TIME_OUT;
+    return waitResult == CompletionSignal::WaitResult::CANCELED ? ERR_OPERATION_CANCELED : ERR_OPERATION_TIME_OUT;
 }
 
 std::string StatusReceiverImpl::GetResultMsg() const
 {
-    auto future = resultMsgSignal_.get_future();
-    if (future.wait_for(std::chrono::seconds(waittingTime_)) == std::future_status::ready) {
-        std::string resultMsg = future.get();
-        return resultMsg;
+    std::pair<int32_t, std::string> result;
+    if (WaitForResult(result) == CompletionSignal::WaitResult::READY) {
+        return result.second;
     }
     return "";
 }
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "text_builder.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+constexpr size_t GROWTH_FACTOR = 2;
+}  // namespace
+
+TextBuilder::TextBuilder(std::string &target, size_t reserveSize) : target_(target)
+{
+    Reserve(reserveSize);
+}
+
+void TextBuilder::Reserve(size_t size)
+{
+    if (target_.capacity() - target_.size() < size) {
+        target_.reserve(target_.size() + size);
+    }
+}
+
+size_t TextBuilder::GetSize() const
+{
+    return target_.size();
+}
+
+void TextBuilder::Grow(size_t size)
+{
+    // an exact reserve per append would reallocate on every line
+    if (target_.capacity() - target_.size() < size) {
+        target_.reserve(std::max(target_.size() + size, target_.capacity() * GROWTH_FACTOR));
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
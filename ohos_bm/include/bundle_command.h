@@ -16,6 +16,8 @@
 #ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_OHOS_BM_INCLUDE_BUNDLE_COMMAND_H
 #define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_OHOS_BM_INCLUDE_BUNDLE_COMMAND_H
 
+#include <string_view>
+
 #include "shell_command.h"
 #include "bundle_mgr_interface.h"
 #include "bundle_installer_interface.h"
@@ -270,7 +272,8 @@ private:
     ErrCode ParseSharedCommand(int32_t option, std::string &bundleName, bool &dumpSharedAll);
 
     // JSON output helper methods
-    std::string CreateSuccessResult(const std::string &data = "") const;
+    // the envelope is written around data, which is spliced in if it is json or wrapped as content if not
+    std::string CreateSuccessResult(std::string_view data = "") const;
     std::string CreateErrorResult(int32_t code, const std::string &message,
         const std::string &suggestion = "") const;
     std::string CreateErrorResult(const std::string &errCode, const std::string &message,
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_OHOS_BM_INCLUDE_OUTPUT_SINK_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_OHOS_BM_INCLUDE_OUTPUT_SINK_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+class OutputSink {
+public:
+    OutputSink() = default;
+    virtual ~OutputSink() = default;
+
+    // the sink takes the buffer of data, large payloads are not copied
+    virtual void Write(std::string &&data) = 0;
+    virtual void Write(const std::string &data) = 0;
+    virtual void Flush() = 0;
+};
+
+class StdoutSink : public OutputSink {
+public:
+    explicit StdoutSink(int fd = STDOUT_FD, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~StdoutSink() override;
+
+    void Write(std::string &&data) override;
+    void Write(const std::string &data) override;
+    void Flush() override;
+
+private:
+    static constexpr int STDOUT_FD = 1;
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+    static constexpr size_t MERGE_CHUNK_SIZE = 4 * 1024;
+
+    void FlushLocked();
+    bool WriteChunks(size_t begin, size_t end);
+
+    int fd_;
+    size_t bufferSize_;
+    size_t pendingSize_ = 0;
+    std::vector<std::string> chunks_;
+    std::mutex mutex_;
+    DISALLOW_COPY_AND_MOVE(StdoutSink);
+};
+
+class StringSink : public OutputSink {
+public:
+    StringSink() = default;
+    ~StringSink() override = default;
+
+    void Write(std::string &&data) override;
+    void Write(const std::string &data) override;
+    void Flush() override;
+    const std::string &GetContent() const;
+
+private:
+    std::string content_;
+    DISALLOW_COPY_AND_MOVE(StringSink);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_OHOS_BM_INCLUDE_OUTPUT_SINK_H
@@ -14,11 +14,14 @@
  */
 #include "bundle_command.h"
 
+#include <cctype>
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <future>
 #include <getopt.h>
+#include <string_view>
 #include <unistd.h>
 #include <vector>
 #include "app_log_wrapper.h"
@@ -41,6 +44,12 @@ namespace AppExecFwk {
 namespace {
 const int32_t INDEX_OFFSET = 2;
 const int32_t INVALID_ARGS_NUMBER = 2;
+const std::string SUCCESS_RESULT_PREFIX = "{\"type\":\"result\",\"status\":\"success\",\"data\":";
+const std::string CONTENT_WRAPPER_PREFIX = "{\"content\":";
+// the same nesting limit as cJSON_Parse
+constexpr uint32_t MAX_JSON_NESTING_DEPTH = 1000;
+constexpr size_t JSON_ESCAPE_SIZE = 2;
+constexpr size_t JSON_UNICODE_ESCAPE_SIZE = 6;
 
 const std::string UNINSTALL_OPTIONS = "hn:kv:s";
 const struct option UNINSTALL_LONG_OPTIONS[] = {
@@ -183,40 +192,253 @@ cJSON* SharedBundleInfoToJson(const SharedBundleInfo &info)
     cJSON_AddItemToObject(obj, "sharedModuleInfos", moduleArray);
     return obj;
 }
+
+// copies one json value into output without the insignificant whitespace, the payload is checked while it is
+// copied so that it is neither parsed into a tree nor printed again
+class JsonSplicer {
+public:
+    JsonSplicer(std::string_view data, std::string &output) : data_(data), output_(output) {}
+
+    bool Splice()
+    {
+        SkipWhitespace();
+        if (!SpliceValue(0)) {
+            return false;
+        }
+        SkipWhitespace();
+        return pos_ == data_.size();
+    }
+
+private:
+    void SkipWhitespace()
+    {
+        while (pos_ < data_.size() && (data_[pos_] == ' ' || data_[pos_] == '\t' || data_[pos_] == '\n' ||
+            data_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool SpliceValue(uint32_t depth)
+    {
+        if (pos_ >= data_.size() || depth > MAX_JSON_NESTING_DEPTH) {
+            return false;
+        }
+        switch (data_[pos_]) {
+            case '{':
+                return SpliceContainer(depth, '}');
+            case '[':
+                return SpliceContainer(depth, ']');
+            case '"':
+                return SpliceString();
+            case 't':
+                return SpliceLiteral("true");
+            case 'f':
+                return SpliceLiteral("false");
+            case 'n':
+                return SpliceLiteral("null");
+            default:
+                return SpliceNumber();
+        }
+    }
+
+    bool SpliceContainer(uint32_t depth, char close)
+    {
+        output_.push_back(data_[pos_++]);
+        SkipWhitespace();
+        if (pos_ < data_.size() && data_[pos_] == close) {
+            output_.push_back(data_[pos_++]);
+            return true;
+        }
+        while (true) {
+            if (close == '}') {
+                if (pos_ >= data_.size() || data_[pos_] != '"' || !SpliceString()) {
+                    return false;
+                }
+                SkipWhitespace();
+                if (pos_ >= data_.size() || data_[pos_] != ':') {
+                    return false;
+                }
+                output_.push_back(data_[pos_++]);
+                SkipWhitespace();
+            }
+            if (!SpliceValue(depth + 1)) {
+                return false;
+            }
+            SkipWhitespace();
+            if (pos_ >= data_.size()) {
+                return false;
+            }
+            char next = data_[pos_++];
+            output_.push_back(next);
+            if (next == close) {
+                return true;
+            }
+            if (next != ',') {
+                return false;
+            }
+            SkipWhitespace();
+        }
+    }
+
+    bool SpliceString()
+    {
+        size_t begin = pos_++;
+        while (pos_ < data_.size()) {
+            unsigned char ch = static_cast<unsigned char>(data_[pos_]);
+            if (ch == '"') {
+                ++pos_;
+                output_.append(data_.substr(begin, pos_ - begin));
+                return true;
+            }
+            if (ch < ' ') {
+                return false;
+            }
+            if (ch == '\\') {
+                if (pos_ + 1 >= data_.size() || !IsValidEscape()) {
+                    return false;
+                }
+                continue;
+            }
+            ++pos_;
+        }
+        return false;
+    }
+
+    bool IsValidEscape()
+    {
+        char escaped = data_[pos_ + 1];
+        if (escaped != 'u') {
+            pos_ += JSON_ESCAPE_SIZE;
+            return std::strchr("\"\\/bfnrt", escaped) != nullptr && escaped != '\0';
+        }
+        if (pos_ + JSON_UNICODE_ESCAPE_SIZE > data_.size()) {
+            return false;
+        }
+        for (size_t i = JSON_ESCAPE_SIZE; i < JSON_UNICODE_ESCAPE_SIZE; ++i) {
+            if (!std::isxdigit(static_cast<unsigned char>(data_[pos_ + i]))) {
+                return false;
+            }
+        }
+        pos_ += JSON_UNICODE_ESCAPE_SIZE;
+        return true;
+    }
+
+    bool SpliceLiteral(std::string_view literal)
+    {
+        if (data_.compare(pos_, literal.size(), literal) != 0) {
+            return false;
+        }
+        output_.append(literal);
+        pos_ += literal.size();
+        return true;
+    }
+
+    bool SpliceNumber()
+    {
+        size_t begin = pos_;
+        if (data_[pos_] == '-') {
+            ++pos_;
+        }
+        if (pos_ < data_.size() && data_[pos_] == '0') {
+            ++pos_;
+        } else if (SkipDigits() == 0) {
+            return false;
+        }
+        if (pos_ < data_.size() && data_[pos_] == '.') {
+            ++pos_;
+            if (SkipDigits() == 0) {
+                return false;
+            }
+        }
+        if (pos_ < data_.size() && (data_[pos_] == 'e' || data_[pos_] == 'E')) {
+            ++pos_;
+            if (pos_ < data_.size() && (data_[pos_] == '+' || data_[pos_] == '-')) {
+                ++pos_;
+            }
+            if (SkipDigits() == 0) {
+                return false;
+            }
+        }
+        output_.append(data_.substr(begin, pos_ - begin));
+        return true;
+    }
+
+    size_t SkipDigits()
+    {
+        size_t begin = pos_;
+        while (pos_ < data_.size() && std::isdigit(static_cast<unsigned char>(data_[pos_]))) {
+            ++pos_;
+        }
+        return pos_ - begin;
+    }
+
+    std::string_view data_;
+    std::string &output_;
+    size_t pos_ = 0;
+};
+
+// escapes the same characters as cJSON_Print
+void AppendJsonString(std::string_view data, std::string &output)
+{
+    output.push_back('"');
+    for (char ch : data) {
+        switch (ch) {
+            case '"':
+                output.append("\\\"");
+                break;
+            case '\\':
+                output.append("\\\\");
+                break;
+            case '\b':
+                output.append("\\b");
+                break;
+            case '\f':
+                output.append("\\f");
+                break;
+            case '\n':
+                output.append("\\n");
+                break;
+            case '\r':
+                output.append("\\r");
+                break;
+            case '\t':
+                output.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < ' ') {
+                    char escaped[JSON_UNICODE_ESCAPE_SIZE + 1] = {0};
+                    (void)snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(ch));
+                    output.append(escaped);
+                } else {
+                    output.push_back(ch);
+                }
+                break;
+        }
+    }
+    output.push_back('"');
+}
 }  // namespace
 
 BundleManagerShellCommand::BundleManagerShellCommand(int argc, char *argv[])
     : ShellCommand(argc, argv, TOOL_NAME)
 {}
 
-std::string BundleManagerShellCommand::CreateSuccessResult(const std::string &data) const
+std::string BundleManagerShellCommand::CreateSuccessResult(std::string_view data) const
 {
-    cJSON *result = cJSON_CreateObject();
-    if (result == nullptr) {
-        return "";
-    }
-    cJSON_AddStringToObject(result, "type", "result");
-    cJSON_AddStringToObject(result, "status", "success");
+    std::string result;
+    result.reserve(SUCCESS_RESULT_PREFIX.size() + CONTENT_WRAPPER_PREFIX.size() + data.size() + 1);
+    result.append(SUCCESS_RESULT_PREFIX);
     if (data.empty()) {
-        cJSON_AddItemToObject(result, "data", cJSON_CreateObject());
-    } else {
-        cJSON *parsed = cJSON_Parse(data.c_str());
-        if (parsed != nullptr) {
-            cJSON_AddItemToObject(result, "data", parsed);
-        } else {
-            cJSON *wrapper = cJSON_CreateObject();
-            cJSON_AddStringToObject(wrapper, "content", data.c_str());
-            cJSON_AddItemToObject(result, "data", wrapper);
-        }
-    }
-    char *output = cJSON_PrintUnformatted(result);
-    std::string ret;
-    if (output != nullptr) {
-        ret = std::string(output);
-        cJSON_free(output);
-    }
-    cJSON_Delete(result);
-    return ret;
+        result.append("{}");
+    } else if (!JsonSplicer(data, result).Splice()) {
+        // not json, drop what was spliced before the error and wrap the text
+        result.resize(SUCCESS_RESULT_PREFIX.size());
+        result.append(CONTENT_WRAPPER_PREFIX);
+        AppendJsonString(data, result);
+        result.push_back('}');
+    }
+    result.push_back('}');
+    return result;
 }
 
 std::string BundleManagerShellCommand::CreateErrorResult(int32_t code,
@@ -707,7 +929,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpSharedDependenciesCommand()
             cJSON_AddItemToObject(jsonResult, DEPENDENCIES.c_str(), depArray);
             char *output = cJSON_PrintBuffered(jsonResult, Constants::DUMP_INDENT, 1);
             if (output != nullptr) {
-                resultReceiver_ = CreateSuccessResult(std::string(output));
+                resultReceiver_ = CreateSuccessResult(output);
                 cJSON_free(output);
             } else {
                 APP_LOGE("cJSON_PrintBuffered failed");
@@ -823,7 +1045,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpSharedCommand()
             cJSON_AddItemToObject(jsonResult, SHARED_BUNDLE_INFO.c_str(), nameArray);
             char *output = cJSON_PrintBuffered(jsonResult, Constants::DUMP_INDENT, 1);
             if (output != nullptr) {
-                resultReceiver_ = CreateSuccessResult(std::string(output));
+                resultReceiver_ = CreateSuccessResult(output);
                 cJSON_free(output);
             } else {
                 APP_LOGE("cJSON_PrintBuffered failed");
@@ -851,7 +1073,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpSharedCommand()
             cJSON_AddItemToObject(jsonResult, SHARED_BUNDLE_INFO.c_str(), SharedBundleInfoToJson(sharedBundleInfo));
             char *output = cJSON_PrintBuffered(jsonResult, Constants::DUMP_INDENT, 1);
             if (output != nullptr) {
-                resultReceiver_ = CreateSuccessResult(std::string(output));
+                resultReceiver_ = CreateSuccessResult(output);
                 cJSON_free(output);
             } else {
                 APP_LOGE("cJSON_PrintBuffered failed");
@@ -1028,7 +1250,7 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
                 cJSON_AddStringToObject(cleanResult, "cache", STRING_CLEAN_CACHE_BUNDLE_OK.c_str());
                 char *output = cJSON_PrintUnformatted(cleanResult);
                 if (output != nullptr) {
-                    resultReceiver_ = CreateSuccessResult(std::string(output));
+                    resultReceiver_ = CreateSuccessResult(output);
                     cJSON_free(output);
                 } else {
                     APP_LOGE("cJSON_PrintUnformatted failed");
@@ -1047,7 +1269,7 @@ ErrCode BundleManagerShellCommand::RunAsCleanCommand()
                 cJSON_AddStringToObject(cleanResult, "data", STRING_CLEAN_DATA_BUNDLE_OK.c_str());
                 char *output = cJSON_PrintUnformatted(cleanResult);
                 if (output != nullptr) {
-                    resultReceiver_ = CreateSuccessResult(std::string(output));
+                    resultReceiver_ = CreateSuccessResult(output);
                     cJSON_free(output);
                 } else {
                     APP_LOGE("cJSON_PrintUnformatted failed");
@@ -1727,7 +1949,7 @@ ErrCode BundleManagerShellCommand::RunAsGetRecoverableAppsCommand()
     cJSON_AddItemToObject(jsonResult, "recoverableApps", bundleNameArray);
     char *output = cJSON_PrintBuffered(jsonResult, Constants::DUMP_INDENT, 1);
     if (output != nullptr) {
-        resultReceiver_ = CreateSuccessResult(std::string(output));
+        resultReceiver_ = CreateSuccessResult(output);
         cJSON_free(output);
     } else {
         APP_LOGE("cJSON_PrintBuffered failed");
@@ -15,11 +15,13 @@
 
 #include "app_log_wrapper.h"
 #include "bundle_command.h"
+#include "output_sink.h"
 
 int main(int argc, char *argv[])
 {
     APP_LOGI("ohos-bm exec start");
     OHOS::AppExecFwk::BundleManagerShellCommand cmd(argc, argv);
+    cmd.SetOutputSink(std::make_shared<OHOS::AppExecFwk::StdoutSink>());
     std::cout << cmd.ExecCommand() << std::endl;
     APP_LOGI("ohos-bm exec end");
     return 0;
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "output_sink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "app_log_wrapper.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+#ifdef IOV_MAX
+constexpr size_t MAX_IOV_COUNT = IOV_MAX;
+#else
+constexpr size_t MAX_IOV_COUNT = 1024;
+#endif
+} // namespace
+
+StdoutSink::StdoutSink(int fd, size_t bufferSize) : fd_(fd), bufferSize_(bufferSize)
+{}
+
+StdoutSink::~StdoutSink()
+{
+    Flush();
+}
+
+void StdoutSink::Write(std::string &&data)
+{
+    if (data.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    pendingSize_ += data.size();
+    if (data.size() < MERGE_CHUNK_SIZE && !chunks_.empty() &&
+        chunks_.back().size() + data.size() <= MERGE_CHUNK_SIZE) {
+        chunks_.back().append(data);
+    } else {
+        chunks_.emplace_back(std::move(data));
+    }
+    if (pendingSize_ >= bufferSize_) {
+        FlushLocked();
+    }
+}
+
+void StdoutSink::Write(const std::string &data)
+{
+    Write(std::string(data));
+}
+
+void StdoutSink::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushLocked();
+}
+
+void StdoutSink::FlushLocked()
+{
+    for (size_t begin = 0; begin < chunks_.size(); begin += MAX_IOV_COUNT) {
+        if (!WriteChunks(begin, std::min(chunks_.size(), begin + MAX_IOV_COUNT))) {
+            break;
+        }
+    }
+    chunks_.clear();
+    pendingSize_ = 0;
+}
+
+bool StdoutSink::WriteChunks(size_t begin, size_t end)
+{
+    std::vector<struct iovec> iovs;
+    iovs.reserve(end - begin);
+    for (size_t index = begin; index < end; ++index) {
+        iovs.push_back({ const_cast<char *>(chunks_[index].data()), chunks_[index].size() });
+    }
+    size_t iovIndex = 0;
+    while (iovIndex < iovs.size()) {
+        ssize_t written = writev(fd_, iovs.data() + iovIndex, static_cast<int>(iovs.size() - iovIndex));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            APP_LOGE("writev failed, errno: %{public}d", errno);
+            return false;
+        }
+        if (written == 0) {
+            APP_LOGE("writev wrote nothing");
+            return false;
+        }
+        // skip the fully written buffers and move forward inside the partially written one
+        size_t remain = static_cast<size_t>(written);
+        while (iovIndex < iovs.size() && remain >= iovs[iovIndex].iov_len) {
+            remain -= iovs[iovIndex].iov_len;
+            ++iovIndex;
+        }
+        if (iovIndex < iovs.size()) {
+            iovs[iovIndex].iov_base = static_cast<char *>(iovs[iovIndex].iov_base) + remain;
+            iovs[iovIndex].iov_len -= remain;
+        }
+    }
+    return true;
+}
+
+void StringSink::Write(std::string &&data)
+{
+    if (content_.empty()) {
+        content_ = std::move(data);
+        return;
+    }
+    content_.append(data);
+}
+
+void StringSink::Write(const std::string &data)
+{
+    content_.append(data);
+}
+
+void StringSink::Flush()
+{}
+
+const std::string &StringSink::GetContent() const
+{
+    return content_;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -115,9 +115,33 @@ std::string ShellCommand::ExecCommand()
             resultReceiver_ = "error: failed to execute your command.\n";
         }
     }
+
+    if (outputSink_ != nullptr) {
+        outputSink_->Write(std::move(resultReceiver_));
+        outputSink_->Flush();
+        resultReceiver_.clear();
+    }
     return resultReceiver_;
 }
 
+void ShellCommand::SetOutputSink(const std::shared_ptr<OutputSink> &outputSink)
+{
+    outputSink_ = outputSink;
+}
+
+void ShellCommand::WriteOutput(std::string &&data)
+{
+    if (outputSink_ == nullptr) {
+        resultReceiver_.append(data);
+        return;
+    }
+    if (!resultReceiver_.empty()) {
+        outputSink_->Write(std::move(resultReceiver_));
+        resultReceiver_.clear();
+    }
+    outputSink_->Write(std::move(data));
+}
+
 std::string ShellCommand::GetCommandErrorMsg() const
 {
     std::string commandErrorMsg =
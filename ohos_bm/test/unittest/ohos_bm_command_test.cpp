@@ -2425,6 +2425,45 @@ HWTEST_F(OhosBmCommandTest, JsonResult_0800, TestSize.Level0)
     EXPECT_NE(result.find("install param error"), std::string::npos);
 }
 
+/**
+ * @tc.name: JsonResult_0900
+ * @tc.desc: Test CreateSuccessResult splices formatted JSON data without its whitespace.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OhosBmCommandTest, JsonResult_0900, TestSize.Level0)
+{
+    char *argv[] = {
+        const_cast<char *>("ohos-bm"),
+        const_cast<char *>("help"),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]);
+    BundleManagerShellCommand cmd(argc, argv);
+    std::string data = "{\n    \"names\": [\"a b\", 18446744073709551615],\n    \"ok\": true\n}\n";
+    std::string result = cmd.CreateSuccessResult(data);
+    EXPECT_EQ(result, "{\"type\":\"result\",\"status\":\"success\","
+        "\"data\":{\"names\":[\"a b\",18446744073709551615],\"ok\":true}}");
+    result = cmd.CreateSuccessResult("");
+    EXPECT_EQ(result, "{\"type\":\"result\",\"status\":\"success\",\"data\":{}}");
+}
+
+/**
+ * @tc.name: JsonResult_1000
+ * @tc.desc: Test CreateSuccessResult wraps data that is only partly JSON as escaped content.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OhosBmCommandTest, JsonResult_1000, TestSize.Level0)
+{
+    char *argv[] = {
+        const_cast<char *>("ohos-bm"),
+        const_cast<char *>("help"),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]);
+    BundleManagerShellCommand cmd(argc, argv);
+    std::string result = cmd.CreateSuccessResult("{\"key\":[1,]}\n\t\"tail\"");
+    EXPECT_EQ(result, "{\"type\":\"result\",\"status\":\"success\","
+        "\"data\":{\"content\":\"{\\\"key\\\":[1,]}\\n\\t\\\"tail\\\"\"}}");
+}
+
 // ========== SetDisposedRule Extended Tests ==========
 
 /**
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bm_benchmark_utils.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+
+namespace {
+std::atomic<uint64_t> g_allocationCount = 0;
+std::atomic<uint64_t> g_allocationBytes = 0;
+
+void *CountedAllocate(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    return malloc(size == 0 ? 1 : size);
+}
+}  // namespace
+
+void *operator new(size_t size)
+{
+    void *ptr = CountedAllocate(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace OHOS {
+namespace AppExecFwk {
+CommandArgs::CommandArgs(const std::vector<std::string> &args) : args_(args)
+{
+    argv_.reserve(args_.size() + 1);
+    for (auto &arg : args_) {
+        argv_.emplace_back(const_cast<char *>(arg.c_str()));
+    }
+    argv_.emplace_back(nullptr);
+}
+
+int CommandArgs::GetArgc() const
+{
+    return static_cast<int>(args_.size());
+}
+
+char **CommandArgs::GetArgv()
+{
+    return argv_.data();
+}
+
+AllocationSnapshot GetAllocationSnapshot()
+{
+    AllocationSnapshot snapshot;
+    snapshot.count = g_allocationCount.load(std::memory_order_relaxed);
+    snapshot.bytes = g_allocationBytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+int64_t GetPeakRssKb()
+{
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return static_cast<int64_t>(usage.ru_maxrss);
+}
+
+void ReportMemoryCounters(benchmark::State &state, const AllocationSnapshot &begin)
+{
+    AllocationSnapshot end = GetAllocationSnapshot();
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(end.count - begin.count), benchmark::Counter::kAvgIterations);
+    state.counters["alloc_bytes"] = benchmark::Counter(
+        static_cast<double>(end.bytes - begin.bytes), benchmark::Counter::kAvgIterations);
+    state.counters["peak_rss_kb"] = static_cast<double>(GetPeakRssKb());
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_TEST_BENCHMARKTEST_BM_BM_BENCHMARK_UTILS_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_TEST_BENCHMARKTEST_BM_BM_BENCHMARK_UTILS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace OHOS {
+namespace AppExecFwk {
+struct AllocationSnapshot {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+// argv for a command line, the strings are owned by the object
+class CommandArgs {
+public:
+    explicit CommandArgs(const std::vector<std::string> &args);
+
+    int GetArgc() const;
+    char **GetArgv();
+
+private:
+    std::vector<std::string> args_;
+    std::vector<char *> argv_;
+};
+
+// counted by the global operator new of the benchmark binary
+AllocationSnapshot GetAllocationSnapshot();
+int64_t GetPeakRssKb();
+// report the allocations per iteration since begin and the peak rss of the process
+void ReportMemoryCounters(benchmark::State &state, const AllocationSnapshot &begin);
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_TEST_BENCHMARKTEST_BM_BM_BENCHMARK_UTILS_H
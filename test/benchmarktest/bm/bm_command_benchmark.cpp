@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#define private public
+#include "bundle_command.h"
+#undef private
+#include "bm_benchmark_utils.h"
+#include "iremote_broker.h"
+#include "iremote_object.h"
+#include "mock_bundle_installer_host.h"
+#include "mock_bundle_mgr_host.h"
+#include "quick_fix_command.h"
+
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const std::string TOOL_NAME = "bm";
+const std::string SYNTHETIC_BUNDLE_NAME = "com.example.synthetic.bundle0";
+constexpr int64_t MIN_BUNDLE_COUNT = 10;
+constexpr int64_t MAX_BUNDLE_COUNT = 1000;
+constexpr int64_t ABS_PATH_COUNT = 10000;
+constexpr int64_t ABS_PATH_DUPLICATE_INTERVAL = 10;
+constexpr uint32_t SYNTHETIC_VERSION_CODE = 1000000;
+const std::string SYNTHETIC_HAP_SHA256(64, 'a');
+
+sptr<IBundleMgr> GetMockBundleMgrProxy()
+{
+    static sptr<IBundleMgr> mgrProxy =
+        iface_cast<IBundleMgr>(sptr<IRemoteObject>(new (std::nothrow) MockBundleMgrHost()));
+    return mgrProxy;
+}
+
+sptr<IBundleInstaller> GetMockBundleInstallerProxy()
+{
+    static sptr<IBundleInstaller> installerProxy =
+        iface_cast<IBundleInstaller>(sptr<IRemoteObject>(new (std::nothrow) MockBundleInstallerHost()));
+    return installerProxy;
+}
+
+void RunBmCommand(benchmark::State &state, const std::vector<std::string> &args)
+{
+    MockBundleMgrHost::SetSyntheticBundleCount(static_cast<size_t>(state.range(0)));
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        CommandArgs commandArgs(args);
+        BundleManagerShellCommand cmd(commandArgs.GetArgc(), commandArgs.GetArgv());
+        cmd.bundleMgrProxy_ = GetMockBundleMgrProxy();
+        cmd.bundleInstallerProxy_ = GetMockBundleInstallerProxy();
+        optind = 0;
+        std::string result = cmd.ExecCommand();
+        benchmark::DoNotOptimize(result);
+    }
+    ReportMemoryCounters(state, begin);
+    MockBundleMgrHost::SetSyntheticBundleCount(0);
+}
+
+void BenchmarkBmHelp(benchmark::State &state)
+{
+    RunBmCommand(state, { TOOL_NAME, "help" });
+}
+
+void BenchmarkBmDumpAll(benchmark::State &state)
+{
+    RunBmCommand(state, { TOOL_NAME, "dump", "-a" });
+}
+
+void BenchmarkBmDumpBundle(benchmark::State &state)
+{
+    RunBmCommand(state, { TOOL_NAME, "dump", "-n", SYNTHETIC_BUNDLE_NAME });
+}
+
+void BenchmarkBmInstall(benchmark::State &state)
+{
+    RunBmCommand(state, { TOOL_NAME, "install", "-p", STRING_BUNDLE_PATH });
+}
+
+void BenchmarkBmUninstall(benchmark::State &state)
+{
+    RunBmCommand(state, { TOOL_NAME, "uninstall", "-n", SYNTHETIC_BUNDLE_NAME });
+}
+
+// relative and unnormalized paths with one duplicate in every ABS_PATH_DUPLICATE_INTERVAL
+void BenchmarkBmGetAbsPaths(benchmark::State &state)
+{
+    std::vector<std::string> paths;
+    paths.reserve(static_cast<size_t>(state.range(0)));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        int64_t fileIndex = (i % ABS_PATH_DUPLICATE_INTERVAL == 0) ? i / ABS_PATH_DUPLICATE_INTERVAL : i;
+        paths.emplace_back((i % 2 == 0 ? "./shared//" : "/data/test/../test/shared/") +
+            std::to_string(fileIndex) + ".hsp");
+    }
+    CommandArgs commandArgs({ TOOL_NAME, "install" });
+    BundleManagerShellCommand cmd(commandArgs.GetArgc(), commandArgs.GetArgv());
+    bool expandDirs = state.range(1) != 0;
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        std::vector<std::string> absPaths;
+        cmd.GetAbsPaths(paths, absPaths, expandDirs);
+        benchmark::DoNotOptimize(absPaths);
+    }
+    ReportMemoryCounters(state, begin);
+}
+
+void BuildQuickFixInfo(size_t hqfCount, AAFwk::ApplicationQuickFixInfo &quickFixInfo)
+{
+    quickFixInfo.bundleName = SYNTHETIC_BUNDLE_NAME;
+    quickFixInfo.bundleVersionCode = SYNTHETIC_VERSION_CODE;
+    quickFixInfo.bundleVersionName = "1.0.0";
+    quickFixInfo.appqfInfo.versionCode = SYNTHETIC_VERSION_CODE;
+    quickFixInfo.appqfInfo.versionName = "1.0.0";
+    quickFixInfo.appqfInfo.cpuAbi = "arm64-v8a";
+    quickFixInfo.appqfInfo.nativeLibraryPath = "patch_1000000/libs/arm64";
+    quickFixInfo.appqfInfo.type = QuickFixType::PATCH;
+    quickFixInfo.appqfInfo.hqfInfos.resize(hqfCount);
+    for (size_t i = 0; i < hqfCount; ++i) {
+        HqfInfo &hqfInfo = quickFixInfo.appqfInfo.hqfInfos[i];
+        hqfInfo.moduleName = "entry" + std::to_string(i);
+        hqfInfo.hapSha256 = SYNTHETIC_HAP_SHA256;
+        hqfInfo.hqfFilePath = "/data/app/el1/bundle/public/" + SYNTHETIC_BUNDLE_NAME + "/patch_1000000/" +
+            hqfInfo.moduleName + ".hqf";
+    }
+}
+
+// the per fragment concatenation that TextBuilder replaced, the baseline of the allocation counters
+std::string GetQuickFixInfoStringByConcat(const AAFwk::ApplicationQuickFixInfo &quickFixInfo)
+{
+    std::string info = "ApplicationQuickFixInfo:\n";
+    info.append("  bundle name: " + quickFixInfo.bundleName + "\n");
+    info.append("  bundle version code: " + std::to_string(quickFixInfo.bundleVersionCode) + "\n");
+    info.append("  bundle version name: " + quickFixInfo.bundleVersionName + "\n");
+    AppqfInfo appqfInfo = quickFixInfo.appqfInfo;
+    info.append("  patch version code: " + std::to_string(appqfInfo.versionCode) + "\n");
+    info.append("  patch version name: " + appqfInfo.versionName + "\n");
+    info.append("  cpu abi: " + appqfInfo.cpuAbi + "\n");
+    info.append("  native library path: " + appqfInfo.nativeLibraryPath + "\n");
+    info.append(std::string("  type: ") + "patch" + "\n");
+    for (auto hqfInfo : appqfInfo.hqfInfos) {
+        info.append("  ModuelQuickFixInfo:\n");
+        info.append("    module name: " + hqfInfo.moduleName + "\n");
+        info.append("    module sha256: " + hqfInfo.hapSha256 + "\n");
+        info.append("    file path: " + hqfInfo.hqfFilePath + "\n");
+    }
+    return info;
+}
+
+void BenchmarkQuickFixInfoString(benchmark::State &state)
+{
+    AAFwk::ApplicationQuickFixInfo quickFixInfo;
+    BuildQuickFixInfo(static_cast<size_t>(state.range(0)), quickFixInfo);
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        std::string info = QuickFixCommand::GetQuickFixInfoString(quickFixInfo);
+        benchmark::DoNotOptimize(info);
+    }
+    ReportMemoryCounters(state, begin);
+}
+
+void BenchmarkQuickFixInfoStringByConcat(benchmark::State &state)
+{
+    AAFwk::ApplicationQuickFixInfo quickFixInfo;
+    BuildQuickFixInfo(static_cast<size_t>(state.range(0)), quickFixInfo);
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        std::string info = GetQuickFixInfoStringByConcat(quickFixInfo);
+        benchmark::DoNotOptimize(info);
+    }
+    ReportMemoryCounters(state, begin);
+}
+}  // namespace
+
+BENCHMARK(BenchmarkBmGetAbsPaths)->Args({ ABS_PATH_COUNT, 0 })->Args({ ABS_PATH_COUNT, 1 });
+BENCHMARK(BenchmarkBmHelp)->Arg(0);
+BENCHMARK(BenchmarkBmDumpAll)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkBmDumpBundle)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkBmInstall)->Arg(MIN_BUNDLE_COUNT);
+BENCHMARK(BenchmarkBmUninstall)->Arg(MIN_BUNDLE_COUNT);
+BENCHMARK(BenchmarkQuickFixInfoString)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkQuickFixInfoStringByConcat)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <getopt.h>
+
+#define private public
+#include "bundle_test_tool.h"
+#undef private
+#include "bm_benchmark_utils.h"
+#include "iremote_broker.h"
+#include "iremote_object.h"
+#include "mock_bundle_installer_host.h"
+#include "mock_bundle_mgr_host.h"
+#include "mock_bundle_resource_host.h"
+#include "option_schema.h"
+
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const std::string TOOL_NAME = "bundle_test_tool";
+const std::string SYNTHETIC_BUNDLE_NAME_PREFIX = "com.example.synthetic.bundle";
+const std::string STRING_GET_EACH_BUNDLE_CACHE_STAT_OK = "getEachBundleCacheStat successfully\n";
+const std::string STRING_GET_ALL_JSON_PROFILE_OK = "getAllJsonProfile successfully\n";
+const std::string STRING_BATCH_GET_BUNDLE_INFO_OK = "batchGetBundleInfo successfully\n";
+const std::string STRING_GET_SIMPLE_APP_INFO_FOR_UID_OK = "getSimpleAppInfoForUid is ok \n";
+constexpr int64_t MIN_BUNDLE_COUNT = 10;
+constexpr int64_t MAX_BUNDLE_COUNT = 1000;
+constexpr int32_t FIRST_OPTION_INDEX = 2;
+constexpr int64_t FIRST_SYNTHETIC_UID = 20010000;
+constexpr size_t OUTPUT_HEAD_SIZE = 128;
+constexpr int32_t PROFILE_USER_ID = 100;
+const std::vector<std::string> SNAPSHOT_ARGS = {
+    TOOL_NAME, "snapshot", "-u", "100", "--file", "/data/local/tmp/bm_bundle_snapshot", "-w"
+};
+
+const std::string SHORT_OPTIONS_SNAPSHOT = "hu:f:wd";
+const struct option LONG_OPTIONS_SNAPSHOT[] = {
+    {"help", no_argument, nullptr, 'h'},
+    {"user-id", required_argument, nullptr, 'u'},
+    {"file", required_argument, nullptr, 'f'},
+    {"watch", no_argument, nullptr, 'w'},
+    {"delete", no_argument, nullptr, 'd'},
+    {nullptr, 0, nullptr, 0},
+};
+
+sptr<IBundleMgr> GetMockBundleMgrProxy()
+{
+    static sptr<IBundleMgr> mgrProxy =
+        iface_cast<IBundleMgr>(sptr<IRemoteObject>(new (std::nothrow) MockBundleMgrHost()));
+    return mgrProxy;
+}
+
+sptr<IBundleInstaller> GetMockBundleInstallerProxy()
+{
+    static sptr<IBundleInstaller> installerProxy =
+        iface_cast<IBundleInstaller>(sptr<IRemoteObject>(new (std::nothrow) MockBundleInstallerHost()));
+    return installerProxy;
+}
+
+sptr<IBundleResource> GetMockBundleResourceProxy()
+{
+    static sptr<IBundleResource> resourceProxy =
+        iface_cast<IBundleResource>(sptr<IRemoteObject>(new (std::nothrow) MockBundleResourceHost()));
+    return resourceProxy;
+}
+
+std::string ExecBundleTestToolCommand(const std::vector<std::string> &args)
+{
+    CommandArgs commandArgs(args);
+    BundleTestTool cmd(commandArgs.GetArgc(), commandArgs.GetArgv());
+    cmd.bundleMgrProxy_ = GetMockBundleMgrProxy();
+    cmd.bundleInstallerProxy_ = GetMockBundleInstallerProxy();
+    cmd.bundleResourceProxy_ = GetMockBundleResourceProxy();
+    optind = 0;
+    return cmd.ExecCommand();
+}
+
+// the command runs once untimed first, a command that misses one of expectedTexts in its output is reported as an
+// error, so a failing path is never timed
+void RunBundleTestToolCommand(benchmark::State &state, const std::vector<std::string> &args,
+    const std::vector<std::string> &expectedTexts)
+{
+    MockBundleMgrHost::SetSyntheticBundleCount(static_cast<size_t>(state.range(0)));
+    std::string output = ExecBundleTestToolCommand(args);
+    for (const auto &expectedText : expectedTexts) {
+        if (output.find(expectedText) == std::string::npos) {
+            std::string errorMsg = "unexpected output of " + args[1] + ": " + output.substr(0, OUTPUT_HEAD_SIZE);
+            state.SkipWithError(errorMsg.c_str());
+            MockBundleMgrHost::SetSyntheticBundleCount(0);
+            return;
+        }
+    }
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        std::string result = ExecBundleTestToolCommand(args);
+        benchmark::DoNotOptimize(result);
+    }
+    ReportMemoryCounters(state, begin);
+    MockBundleMgrHost::SetSyntheticBundleCount(0);
+}
+
+void BenchmarkGetEachBundleCacheStat(benchmark::State &state)
+{
+    RunBundleTestToolCommand(state, { TOOL_NAME, "getEachBundleCacheStat" }, { STRING_GET_EACH_BUNDLE_CACHE_STAT_OK });
+}
+
+void BenchmarkGetEachBundleCacheStatParallel(benchmark::State &state)
+{
+    RunBundleTestToolCommand(state, { TOOL_NAME, "getEachBundleCacheStat", "-j", "8" },
+        { STRING_GET_EACH_BUNDLE_CACHE_STAT_OK });
+}
+
+void BenchmarkGetAllJsonProfile(benchmark::State &state)
+{
+    RunBundleTestToolCommand(state, { TOOL_NAME, "getAllJsonProfile", "-p", "0", "-u", "100" },
+        { STRING_GET_ALL_JSON_PROFILE_OK, SYNTHETIC_BUNDLE_NAME_PREFIX + std::to_string(state.range(0) - 1) });
+}
+
+// the per fragment concatenation that TextBuilder replaced in GetAllJsonProfile, the baseline of the allocation
+// counters of BenchmarkJsonProfileText
+std::string GetJsonProfileTextByConcat(const std::vector<JsonProfileInfo> &profileInfos)
+{
+    std::string msg = "JsonProfileInfos:\n{\n";
+    for (const auto &info: profileInfos) {
+        msg +="     ";
+        msg += info.ToString();
+        msg += "\n";
+    }
+    msg += "}\n";
+    return msg;
+}
+
+void BenchmarkJsonProfileText(benchmark::State &state)
+{
+    MockBundleMgrHost::SetSyntheticBundleCount(static_cast<size_t>(state.range(0)));
+    CommandArgs commandArgs({ TOOL_NAME, "getAllJsonProfile" });
+    BundleTestTool cmd(commandArgs.GetArgc(), commandArgs.GetArgv());
+    cmd.bundleMgrProxy_ = GetMockBundleMgrProxy();
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        std::string msg;
+        ErrCode ret = cmd.GetAllJsonProfile(ProfileType::INTENT_PROFILE, PROFILE_USER_ID, msg);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(msg);
+    }
+    ReportMemoryCounters(state, begin);
+    MockBundleMgrHost::SetSyntheticBundleCount(0);
+}
+
+void BenchmarkJsonProfileTextByConcat(benchmark::State &state)
+{
+    MockBundleMgrHost::SetSyntheticBundleCount(static_cast<size_t>(state.range(0)));
+    sptr<IBundleMgr> mgrProxy = GetMockBundleMgrProxy();
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        std::vector<JsonProfileInfo> profileInfos;
+        ErrCode ret = mgrProxy->GetAllJsonProfile(ProfileType::INTENT_PROFILE, PROFILE_USER_ID, profileInfos);
+        std::string msg = GetJsonProfileTextByConcat(profileInfos);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(msg);
+    }
+    ReportMemoryCounters(state, begin);
+    MockBundleMgrHost::SetSyntheticBundleCount(0);
+}
+
+void BenchmarkBatchGetBundleInfo(benchmark::State &state)
+{
+    std::string bundleNames;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bundleNames.append(bundleNames.empty() ? "" : ",").append(SYNTHETIC_BUNDLE_NAME_PREFIX + std::to_string(i));
+    }
+    RunBundleTestToolCommand(state, { TOOL_NAME, "batchGetBundleInfo", "-n", bundleNames },
+        { STRING_BATCH_GET_BUNDLE_INFO_OK });
+}
+
+void BenchmarkGetSimpleAppInfoForUid(benchmark::State &state)
+{
+    std::string uids;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        uids.append(uids.empty() ? "" : ",").append(std::to_string(FIRST_SYNTHETIC_UID + i));
+    }
+    // the last uid resolves only when every chunk reached the mock
+    RunBundleTestToolCommand(state, { TOOL_NAME, "getSimpleAppInfoForUid", "-u", uids, "-j", "8", "-c", "32" },
+        { STRING_GET_SIMPLE_APP_INFO_FOR_UID_OK, SYNTHETIC_BUNDLE_NAME_PREFIX + std::to_string(state.range(0) - 1) });
+}
+
+// the parse cost of one invocation, without the command that follows it
+void BenchmarkParseOptionsWithSchema(benchmark::State &state)
+{
+    CommandArgs commandArgs(SNAPSHOT_ARGS);
+    for (auto _ : state) {
+        SnapshotOptions options;
+        std::string errorOption;
+        OptionParseResult result = BundleTestTool::GetSnapshotOptionSchema().Parse(commandArgs.GetArgc(),
+            commandArgs.GetArgv(), FIRST_OPTION_INDEX, options, errorOption);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(options);
+    }
+}
+
+void BenchmarkParseOptionsWithGetopt(benchmark::State &state)
+{
+    CommandArgs commandArgs(SNAPSHOT_ARGS);
+    for (auto _ : state) {
+        SnapshotOptions options;
+        optind = 0;
+        int32_t option = 0;
+        while ((option = getopt_long(commandArgs.GetArgc(), commandArgs.GetArgv(), SHORT_OPTIONS_SNAPSHOT.c_str(),
+            LONG_OPTIONS_SNAPSHOT, nullptr)) != -1) {
+            if (option == 'u') {
+                options.userId = std::stoi(optarg);
+            } else if (option == 'f') {
+                options.path = optarg;
+            } else if (option == 'w') {
+                options.isWatch = true;
+            } else if (option == 'd') {
+                options.isDelete = true;
+            }
+        }
+        benchmark::DoNotOptimize(options);
+    }
+}
+
+void BenchmarkOptionSchemaHelp(benchmark::State &state)
+{
+    for (auto _ : state) {
+        std::string help = BundleTestTool::GetSnapshotOptionSchema().GetHelp();
+        benchmark::DoNotOptimize(help);
+    }
+}
+}  // namespace
+
+BENCHMARK(BenchmarkGetEachBundleCacheStat)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkGetEachBundleCacheStatParallel)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkGetAllJsonProfile)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkJsonProfileText)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkJsonProfileTextByConcat)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkBatchGetBundleInfo)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkGetSimpleAppInfoForUid)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkParseOptionsWithSchema);
+BENCHMARK(BenchmarkParseOptionsWithGetopt);
+BENCHMARK(BenchmarkOptionSchemaHelp);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#define private public
+#include "bundle_command.h"
+#undef private
+#include "bm_benchmark_utils.h"
+#include "iremote_broker.h"
+#include "iremote_object.h"
+#include "mock_bundle_installer_host.h"
+#include "mock_bundle_mgr_host.h"
+
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const std::string TOOL_NAME = "ohos-bm";
+const std::string SYNTHETIC_BUNDLE_NAME = "com.example.synthetic.bundle0";
+constexpr int64_t MIN_BUNDLE_COUNT = 10;
+constexpr int64_t MAX_BUNDLE_COUNT = 1000;
+
+sptr<IBundleMgr> GetMockBundleMgrProxy()
+{
+    static sptr<IBundleMgr> mgrProxy =
+        iface_cast<IBundleMgr>(sptr<IRemoteObject>(new (std::nothrow) MockBundleMgrHost()));
+    return mgrProxy;
+}
+
+sptr<IBundleInstaller> GetMockBundleInstallerProxy()
+{
+    static sptr<IBundleInstaller> installerProxy =
+        iface_cast<IBundleInstaller>(sptr<IRemoteObject>(new (std::nothrow) MockBundleInstallerHost()));
+    return installerProxy;
+}
+
+void RunOhosBmCommand(benchmark::State &state, const std::vector<std::string> &args)
+{
+    MockBundleMgrHost::SetSyntheticBundleCount(static_cast<size_t>(state.range(0)));
+    AllocationSnapshot begin = GetAllocationSnapshot();
+    for (auto _ : state) {
+        CommandArgs commandArgs(args);
+        BundleManagerShellCommand cmd(commandArgs.GetArgc(), commandArgs.GetArgv());
+        cmd.bundleMgrProxy_ = GetMockBundleMgrProxy();
+        cmd.bundleInstallerProxy_ = GetMockBundleInstallerProxy();
+        optind = 0;
+        std::string result = cmd.ExecCommand();
+        benchmark::DoNotOptimize(result);
+    }
+    ReportMemoryCounters(state, begin);
+    MockBundleMgrHost::SetSyntheticBundleCount(0);
+}
+
+void BenchmarkOhosBmHelp(benchmark::State &state)
+{
+    RunOhosBmCommand(state, { TOOL_NAME, "--help" });
+}
+
+void BenchmarkOhosBmDumpAll(benchmark::State &state)
+{
+    RunOhosBmCommand(state, { TOOL_NAME, "dump", "-a" });
+}
+
+void BenchmarkOhosBmDumpBundle(benchmark::State &state)
+{
+    RunOhosBmCommand(state, { TOOL_NAME, "dump", "-n", SYNTHETIC_BUNDLE_NAME });
+}
+
+void BenchmarkOhosBmUninstall(benchmark::State &state)
+{
+    RunOhosBmCommand(state, { TOOL_NAME, "uninstall", "-n", SYNTHETIC_BUNDLE_NAME });
+}
+}  // namespace
+
+BENCHMARK(BenchmarkOhosBmHelp)->Arg(0);
+BENCHMARK(BenchmarkOhosBmDumpAll)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkOhosBmDumpBundle)->RangeMultiplier(10)->Range(MIN_BUNDLE_COUNT, MAX_BUNDLE_COUNT);
+BENCHMARK(BenchmarkOhosBmUninstall)->Arg(MIN_BUNDLE_COUNT);
+
+BENCHMARK_MAIN();
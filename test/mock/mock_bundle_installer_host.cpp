@@ -96,6 +96,9 @@ ErrCode MockBundleInstallerHost::StreamInstall(const std::vector<std::string> &b
     const InstallParam &installParam, const sptr<IStatusReceiver> &statusReceiver)
 {
     APP_LOGD("enter");
+    for (int32_t progress : STREAM_INSTALL_PROGRESSES) {
+        statusReceiver->OnStatusNotify(progress);
+    }
     statusReceiver->OnFinished(OHOS::ERR_OK, MSG_SUCCESS);
     return OHOS::ERR_OK;
 }
@@ -16,6 +16,8 @@
 #ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_BUNDLE_INSTALLER_HOST_H
 #define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_BUNDLE_INSTALLER_HOST_H
 
+#include <vector>
+
 #include "gmock/gmock.h"
 
 #include "iremote_stub.h"
@@ -29,6 +31,8 @@ namespace {
 const std::string MSG_SUCCESS = "[SUCCESS]";
 const std::string STRING_BUNDLE_PATH = "/data/test/bundle_test/testdemo.hap";
 const std::string STRING_OTHER_BUNDLE_PATH = "/data/test/bundle_test/othertestdemo.hap";
+// the progress notified by StreamInstall before the result, in order
+const std::vector<int32_t> STREAM_INSTALL_PROGRESSES = { 50, 100 };
 const std::string STRING_BUNDLE_INSTALL_PATH1 = "../../test/bundle_test1/";
 const std::string STRING_BUNDLE_INSTALL_PATH2 = "../../test/bundle_test2/";
 const std::string STRING_BUNDLE_NAME = "name";
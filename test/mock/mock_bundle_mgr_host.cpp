@@ -15,6 +15,10 @@
 
 #include "mock_bundle_mgr_host.h"
 
+#include <atomic>
+
+#include "appexecfwk_errors.h"
+
 using namespace OHOS::AAFwk;
 namespace OHOS {
 namespace AppExecFwk {
@@ -25,9 +29,87 @@ const std::string SECOND_BUNDLE_NAME = "com.example.bundle.two";
 constexpr int32_t CACHE_STATS_INDEX = 4;
 constexpr int64_t CACHE_SIZE_ONE = 100;
 constexpr int64_t CACHE_SIZE_TWO = 200;
+constexpr int32_t FIRST_BUNDLE_UID = 20010001;
+constexpr int32_t SECOND_BUNDLE_UID = 20010002;
+constexpr int32_t FIRST_SYNTHETIC_UID = 20010000;
+constexpr uint32_t BUNDLE_TARGET_VERSION = 12;
+constexpr uint32_t BUNDLE_VERSION_CODE = 1000000;
+constexpr int64_t BUNDLE_UPDATE_TIME = 1700000000000;
+const std::string COMPATIBLE_DEVICE_TYPE = "phone";
+const std::string SYNTHETIC_BUNDLE_NAME_PREFIX = "com.example.synthetic.bundle";
+const std::string ARCHIVE_BUNDLE_NAME_PREFIX = "com.example.";
+const std::string HAP_SUFFIX = ".hap";
+const std::string HSP_SUFFIX = ".hsp";
+constexpr size_t ARCHIVE_SUFFIX_SIZE = 4;
+constexpr size_t SYNTHETIC_MODULE_COUNT = 3;
+constexpr size_t SYNTHETIC_ABILITY_COUNT = 4;
+constexpr size_t SYNTHETIC_PERMISSION_COUNT = 10;
+constexpr size_t SYNTHETIC_DUMP_PADDING = 4096;
+constexpr size_t SYNTHETIC_PROFILE_SIZE = 512;
 
 bool g_getBundleInfosResult = true;
 bool g_getBundleStatsFailSecondBundle = false;
+size_t g_syntheticBundleCount = 0;
+size_t g_firstBundleCloneCount = 0;
+std::atomic<size_t> g_dumpLabelCount(0);
+
+bool IsArchiveFile(const std::string &path)
+{
+    return path.size() > ARCHIVE_SUFFIX_SIZE &&
+        (path.compare(path.size() - ARCHIVE_SUFFIX_SIZE, ARCHIVE_SUFFIX_SIZE, HAP_SUFFIX) == 0 ||
+        path.compare(path.size() - ARCHIVE_SUFFIX_SIZE, ARCHIVE_SUFFIX_SIZE, HSP_SUFFIX) == 0);
+}
+
+// the haps and hsps of one bundle are kept in one directory, which names the bundle,
+// eg: /data/test/bundle_test/testdemo.hap and /data/test/bundle_test/ are both com.example.bundle_test
+std::string GetArchiveBundleName(const std::string &hapFilePath)
+{
+    std::string path = hapFilePath;
+    while (!path.empty() && path.back() == '/') {
+        path.pop_back();
+    }
+    if (IsArchiveFile(path)) {
+        size_t slashPos = path.rfind('/');
+        path.resize(slashPos == std::string::npos ? 0 : slashPos);
+    }
+    return ARCHIVE_BUNDLE_NAME_PREFIX + path.substr(path.rfind('/') + 1);
+}
+
+void BuildSyntheticBundleInfo(const std::string &bundleName, BundleInfo &bundleInfo)
+{
+    bundleInfo.name = bundleName;
+    bundleInfo.label = bundleName + ".label";
+    bundleInfo.vendor = "example";
+    bundleInfo.versionCode = 1000000;
+    bundleInfo.versionName = "1.0.0";
+    for (size_t i = 0; i < SYNTHETIC_PERMISSION_COUNT; ++i) {
+        bundleInfo.reqPermissions.emplace_back("ohos.permission.SYNTHETIC_" + std::to_string(i));
+    }
+    for (size_t i = 0; i < SYNTHETIC_MODULE_COUNT; ++i) {
+        HapModuleInfo hapModuleInfo;
+        hapModuleInfo.name = MODULE_NAME + std::to_string(i);
+        hapModuleInfo.moduleName = hapModuleInfo.name;
+        hapModuleInfo.package = hapModuleInfo.name;
+        for (size_t j = 0; j < SYNTHETIC_ABILITY_COUNT; ++j) {
+            AbilityInfo abilityInfo;
+            abilityInfo.bundleName = bundleName;
+            abilityInfo.moduleName = hapModuleInfo.name;
+            abilityInfo.name = "EntryAbility" + std::to_string(j);
+            abilityInfo.label = abilityInfo.name + ".label";
+            abilityInfo.description = "description of " + abilityInfo.name + " in " + bundleName;
+            abilityInfo.uri = "dataability://" + bundleName + "/" + abilityInfo.name;
+            hapModuleInfo.abilityInfos.emplace_back(abilityInfo);
+            bundleInfo.abilityInfos.emplace_back(abilityInfo);
+        }
+        bundleInfo.moduleNames.emplace_back(hapModuleInfo.name);
+        bundleInfo.hapModuleInfos.emplace_back(std::move(hapModuleInfo));
+    }
+}
+
+std::string GetSyntheticBundleName(size_t index)
+{
+    return SYNTHETIC_BUNDLE_NAME_PREFIX + std::to_string(index);
+}
 } // namespace
 
 void MockBundleMgrHost::SetGetBundleInfosReturn(bool result)
@@ -40,13 +122,45 @@ void MockBundleMgrHost::SetGetBundleStatsFailSecondBundle(bool enable)
     g_getBundleStatsFailSecondBundle = enable;
 }
 
+void MockBundleMgrHost::SetSyntheticBundleCount(size_t count)
+{
+    g_syntheticBundleCount = count;
+}
+
+void MockBundleMgrHost::SetFirstBundleCloneCount(size_t count)
+{
+    g_firstBundleCloneCount = count;
+}
+
+void MockBundleMgrHost::ResetDumpLabelCount()
+{
+    g_dumpLabelCount = 0;
+}
+
+size_t MockBundleMgrHost::GetDumpLabelCount()
+{
+    return g_dumpLabelCount.load();
+}
+
 bool MockBundleMgrHost::DumpInfos(
     const DumpFlag flag, const std::string &bundleName, int32_t userId, std::string &result)
 {
     APP_LOGD("enter");
+    if (flag == DumpFlag::DUMP_BUNDLE_LABEL) {
+        g_dumpLabelCount.fetch_add(1);
+    }
     APP_LOGD("flag: %{public}d", flag);
     APP_LOGD("bundleName: %{public}s", bundleName.c_str());
-    if (bundleName.size() > 0) {
+    if (g_syntheticBundleCount > 0 && flag == DumpFlag::DUMP_BUNDLE_LIST) {
+        result.clear();
+        for (size_t i = 0; i < g_syntheticBundleCount; ++i) {
+            result.append(GetSyntheticBundleName(i)).append("\n");
+        }
+    } else if (g_syntheticBundleCount > 0 && flag == DumpFlag::DUMP_BUNDLE_INFO) {
+        // a dump of one bundle is a few kilobytes of json on a real device
+        result = "{\"name\": \"" + bundleName + "\", \"detail\": \"" +
+            std::string(SYNTHETIC_DUMP_PADDING, 'x') + "\"}\n";
+    } else if (bundleName.size() > 0) {
         result = bundleName + "\n";
     } else {
         result = "OK";
@@ -91,6 +205,20 @@ ErrCode MockBundleMgrHost::SetAbilityEnabled(const AbilityInfo &abilityInfo, boo
 bool MockBundleMgrHost::GetBundleArchiveInfo(const std::string &hapFilePath, const BundleFlag flag,
     BundleInfo &bundleInfo)
 {
+    bundleInfo.name = GetArchiveBundleName(hapFilePath);
+    bundleInfo.moduleNames.emplace_back(MODULE_NAME);
+    return true;
+}
+
+bool MockBundleMgrHost::GetBundleInfo(const std::string &bundleName, const BundleFlag flag, BundleInfo &bundleInfo,
+    int32_t userId)
+{
+    if (bundleName != FIRST_BUNDLE_NAME) {
+        return false;
+    }
+    bundleInfo.name = bundleName;
+    bundleInfo.versionCode = BUNDLE_VERSION_CODE;
+    bundleInfo.updateTime = BUNDLE_UPDATE_TIME;
     bundleInfo.moduleNames.emplace_back(MODULE_NAME);
     return true;
 }
@@ -101,14 +229,31 @@ bool MockBundleMgrHost::GetBundleInfos(int32_t flags, std::vector<BundleInfo> &b
         return false;
     }
     bundleInfos.clear();
+    if (g_syntheticBundleCount > 0) {
+        bundleInfos.resize(g_syntheticBundleCount);
+        for (size_t i = 0; i < g_syntheticBundleCount; ++i) {
+            BuildSyntheticBundleInfo(GetSyntheticBundleName(i), bundleInfos[i]);
+            bundleInfos[i].uid = FIRST_SYNTHETIC_UID + static_cast<int32_t>(i);
+        }
+        return true;
+    }
     BundleInfo first;
     first.name = FIRST_BUNDLE_NAME;
     first.appIndex = 0;
+    first.uid = FIRST_BUNDLE_UID;
+    first.targetVersion = BUNDLE_TARGET_VERSION;
     bundleInfos.emplace_back(first);
+    for (size_t i = 1; i <= g_firstBundleCloneCount; ++i) {
+        BundleInfo clone = first;
+        clone.appIndex = static_cast<int32_t>(i);
+        bundleInfos.emplace_back(clone);
+    }
 
     BundleInfo second;
     second.name = SECOND_BUNDLE_NAME;
     second.appIndex = 1;
+    second.uid = SECOND_BUNDLE_UID;
+    second.targetVersion = BUNDLE_TARGET_VERSION;
     bundleInfos.emplace_back(second);
     return true;
 }
@@ -128,5 +273,83 @@ bool MockBundleMgrHost::GetBundleStats(const std::string &bundleName, int32_t us
     }
     return true;
 }
+
+ErrCode MockBundleMgrHost::BatchGetBundleInfo(const std::vector<std::string> &bundleNames, int32_t flags,
+    std::vector<BundleInfo> &bundleInfos, int32_t userId)
+{
+    bundleInfos.clear();
+    for (const auto &bundleName : bundleNames) {
+        BundleInfo bundleInfo;
+        if (g_syntheticBundleCount > 0) {
+            BuildSyntheticBundleInfo(bundleName, bundleInfo);
+        } else {
+            bundleInfo.name = bundleName;
+        }
+        bundleInfos.emplace_back(std::move(bundleInfo));
+    }
+    return ERR_OK;
+}
+
+ErrCode MockBundleMgrHost::BatchGetCompatibleDeviceType(const std::vector<std::string> &bundleNames,
+    std::vector<BundleCompatibleDeviceType> &compatibleDeviceTypes)
+{
+    compatibleDeviceTypes.clear();
+    for (const auto &bundleName : bundleNames) {
+        BundleCompatibleDeviceType compatibleDeviceType;
+        compatibleDeviceType.bundleName = bundleName;
+        if (bundleName == FIRST_BUNDLE_NAME || bundleName == SECOND_BUNDLE_NAME) {
+            compatibleDeviceType.compatibleDeviceType = COMPATIBLE_DEVICE_TYPE;
+            compatibleDeviceType.errCode = ERR_OK;
+        } else {
+            compatibleDeviceType.errCode = ERR_BUNDLE_MANAGER_BUNDLE_NOT_EXIST;
+        }
+        compatibleDeviceTypes.emplace_back(std::move(compatibleDeviceType));
+    }
+    return ERR_OK;
+}
+
+ErrCode MockBundleMgrHost::GetSimpleAppInfoForUid(const std::vector<std::int32_t> &uids,
+    std::vector<SimpleAppInfo> &simpleAppInfo)
+{
+    simpleAppInfo.clear();
+    for (int32_t uid : uids) {
+        SimpleAppInfo info;
+        info.uid = uid;
+        // the synthetic bundles take the uids from FIRST_SYNTHETIC_UID on
+        if (g_syntheticBundleCount > 0 && uid >= FIRST_SYNTHETIC_UID &&
+            static_cast<size_t>(uid - FIRST_SYNTHETIC_UID) < g_syntheticBundleCount) {
+            info.bundleName = GetSyntheticBundleName(static_cast<size_t>(uid - FIRST_SYNTHETIC_UID));
+            info.appIndex = 0;
+        } else if (uid == FIRST_BUNDLE_UID) {
+            info.bundleName = FIRST_BUNDLE_NAME;
+            info.appIndex = 0;
+        } else if (uid == SECOND_BUNDLE_UID) {
+            info.bundleName = SECOND_BUNDLE_NAME;
+            info.appIndex = 1;
+        } else {
+            info.ret = ERR_BUNDLE_MANAGER_INVALID_UID;
+        }
+        simpleAppInfo.emplace_back(std::move(info));
+    }
+    return ERR_OK;
+}
+
+ErrCode MockBundleMgrHost::GetAllJsonProfile(ProfileType profileType, int32_t userId,
+    std::vector<JsonProfileInfo> &profileInfos)
+{
+    if (g_syntheticBundleCount == 0) {
+        return BundleMgrHost::GetAllJsonProfile(profileType, userId, profileInfos);
+    }
+    profileInfos.clear();
+    profileInfos.resize(g_syntheticBundleCount);
+    for (size_t i = 0; i < g_syntheticBundleCount; ++i) {
+        profileInfos[i].userId = userId;
+        profileInfos[i].bundleName = GetSyntheticBundleName(i);
+        profileInfos[i].moduleName = MODULE_NAME;
+        profileInfos[i].profileType = profileType;
+        profileInfos[i].profile = "{\"padding\":\"" + std::string(SYNTHETIC_PROFILE_SIZE, 'x') + "\"}";
+    }
+    return ERR_OK;
+}
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file
@@ -27,6 +27,13 @@ class MockBundleMgrHost : public BundleMgrHost {
 public:
     static void SetGetBundleInfosReturn(bool result);
     static void SetGetBundleStatsFailSecondBundle(bool enable);
+    // synthesize count bundles with realistic sizes in the query and dump interfaces, 0 to disable
+    static void SetSyntheticBundleCount(size_t count);
+    // list count clones of the first bundle after it, with the appIndexes from 1 on
+    static void SetFirstBundleCloneCount(size_t count);
+    // the label dumps since the last reset
+    static void ResetDumpLabelCount();
+    static size_t GetDumpLabelCount();
 
     ErrCode CleanBundleCacheFiles(const std::string &bundleName, const sptr<ICleanCacheCallback> cleanCacheCallback,
         int32_t userId = Constants::UNSPECIFIED_USERID, int32_t appIndex = 0) override;
@@ -39,10 +46,20 @@ public:
     ErrCode SetAbilityEnabled(const AbilityInfo &abilityInfo, bool isEnable,
         int32_t userId = Constants::UNSPECIFIED_USERID) override;
     bool GetBundleArchiveInfo(const std::string &hapFilePath, const BundleFlag flag, BundleInfo &bundleInfo) override;
+    bool GetBundleInfo(const std::string &bundleName, const BundleFlag flag, BundleInfo &bundleInfo,
+        int32_t userId = Constants::UNSPECIFIED_USERID) override;
     bool GetBundleInfos(int32_t flags, std::vector<BundleInfo> &bundleInfos,
         int32_t userId = Constants::UNSPECIFIED_USERID) override;
     bool GetBundleStats(const std::string &bundleName, int32_t userId, std::vector<int64_t> &bundleStats,
         int32_t appIndex = 0, uint32_t statFlag = 0) override;
+    ErrCode BatchGetBundleInfo(const std::vector<std::string> &bundleNames, int32_t flags,
+        std::vector<BundleInfo> &bundleInfos, int32_t userId = Constants::UNSPECIFIED_USERID) override;
+    ErrCode BatchGetCompatibleDeviceType(const std::vector<std::string> &bundleNames,
+        std::vector<BundleCompatibleDeviceType> &compatibleDeviceTypes) override;
+    ErrCode GetSimpleAppInfoForUid(const std::vector<std::int32_t> &uids,
+        std::vector<SimpleAppInfo> &simpleAppInfo) override;
+    ErrCode GetAllJsonProfile(ProfileType profileType, int32_t userId,
+        std::vector<JsonProfileInfo> &profileInfos) override;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
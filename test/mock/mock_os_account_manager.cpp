@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_os_account_manager.h"
+
+#include <atomic>
+
+#include "os_account_manager.h"
+
+namespace OHOS {
+namespace {
+std::atomic<size_t> g_foregroundUserQueryCount {0};
+std::atomic<size_t> g_foregroundStateQueryCount {0};
+}  // namespace
+
+namespace AppExecFwk {
+void MockOsAccountManager::ResetQueryCount()
+{
+    g_foregroundUserQueryCount = 0;
+    g_foregroundStateQueryCount = 0;
+}
+
+size_t MockOsAccountManager::GetForegroundUserQueryCount()
+{
+    return g_foregroundUserQueryCount;
+}
+
+size_t MockOsAccountManager::GetForegroundStateQueryCount()
+{
+    return g_foregroundStateQueryCount;
+}
+}  // namespace AppExecFwk
+
+namespace AccountSA {
+ErrCode OsAccountManager::GetForegroundOsAccountLocalId(int32_t &localId)
+{
+    ++g_foregroundUserQueryCount;
+    localId = AppExecFwk::MockOsAccountManager::MOCK_FOREGROUND_USER_ID;
+    return ERR_OK;
+}
+
+ErrCode OsAccountManager::IsOsAccountForeground(const int32_t localId, bool &isForeground)
+{
+    ++g_foregroundStateQueryCount;
+    isForeground = localId == AppExecFwk::MockOsAccountManager::MOCK_FOREGROUND_USER_ID;
+    return ERR_OK;
+}
+}  // namespace AccountSA
+}  // namespace OHOS
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_OS_ACCOUNT_MANAGER_H
+#define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_OS_ACCOUNT_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace AppExecFwk {
+// counts the queries of the mock OsAccountManager, whose foreground user is MOCK_FOREGROUND_USER_ID
+class MockOsAccountManager {
+public:
+    static constexpr int32_t MOCK_FOREGROUND_USER_ID = 100;
+
+    static void ResetQueryCount();
+    static size_t GetForegroundUserQueryCount();
+    static size_t GetForegroundStateQueryCount();
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_OS_ACCOUNT_MANAGER_H
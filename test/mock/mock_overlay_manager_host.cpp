@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_overlay_manager_host.h"
+
+#include "appexecfwk_errors.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const std::string TARGET_BUNDLE_NAME = "com.example.bundle.one";
+const std::string OVERLAY_BUNDLE_NAME = "com.example.bundle.two";
+const std::string OVERLAY_MODULE_NAME = "feature";
+const std::string TARGET_MODULE_NAME = "entry";
+constexpr int32_t OVERLAY_PRIORITY = 1;
+constexpr int32_t OVERLAY_STATE = 1;
+
+bool g_queryOverlayBundleFailed = false;
+}  // namespace
+
+void MockOverlayManagerHost::SetQueryOverlayBundleFailed(bool enable)
+{
+    g_queryOverlayBundleFailed = enable;
+}
+
+ErrCode MockOverlayManagerHost::GetAllOverlayModuleInfo(const std::string &bundleName,
+    std::vector<OverlayModuleInfo> &overlayModuleInfos, int32_t userId)
+{
+    if (bundleName != OVERLAY_BUNDLE_NAME) {
+        return ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NON_OVERLAY_BUNDLE;
+    }
+    OverlayModuleInfo overlayModuleInfo;
+    overlayModuleInfo.bundleName = OVERLAY_BUNDLE_NAME;
+    overlayModuleInfo.moduleName = OVERLAY_MODULE_NAME;
+    overlayModuleInfo.targetModuleName = TARGET_MODULE_NAME;
+    overlayModuleInfo.priority = OVERLAY_PRIORITY;
+    overlayModuleInfo.state = OVERLAY_STATE;
+    overlayModuleInfos.emplace_back(overlayModuleInfo);
+    return ERR_OK;
+}
+
+ErrCode MockOverlayManagerHost::GetOverlayBundleInfoForTarget(const std::string &targetBundleName,
+    std::vector<OverlayBundleInfo> &overlayBundleInfo, int32_t userId)
+{
+    if (g_queryOverlayBundleFailed) {
+        return ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_PERMISSION_DENIED;
+    }
+    if (targetBundleName == OVERLAY_BUNDLE_NAME) {
+        return ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_TARGET_BUNDLE_IS_OVERLAY_BUNDLE;
+    }
+    if (targetBundleName != TARGET_BUNDLE_NAME) {
+        return ERR_BUNDLEMANAGER_OVERLAY_QUERY_FAILED_NO_OVERLAY_BUNDLE_INFO;
+    }
+    OverlayBundleInfo info;
+    info.bundleName = OVERLAY_BUNDLE_NAME;
+    info.priority = OVERLAY_PRIORITY;
+    info.state = OVERLAY_STATE;
+    overlayBundleInfo.emplace_back(info);
+    return ERR_OK;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
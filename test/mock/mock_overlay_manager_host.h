@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_OVERLAY_MANAGER_HOST_H
+#define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_OVERLAY_MANAGER_HOST_H
+
+#include "overlay_manager_host.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+// the second bundle of the mock bundle mgr is an overlay bundle of the first one
+class MockOverlayManagerHost : public OverlayManagerHost {
+public:
+    // fail every overlay bundle query with an error other than a missing overlay
+    static void SetQueryOverlayBundleFailed(bool enable);
+
+    ErrCode GetAllOverlayModuleInfo(const std::string &bundleName, std::vector<OverlayModuleInfo> &overlayModuleInfos,
+        int32_t userId = Constants::UNSPECIFIED_USERID) override;
+    ErrCode GetOverlayBundleInfoForTarget(const std::string &targetBundleName,
+        std::vector<OverlayBundleInfo> &overlayBundleInfo, int32_t userId = Constants::UNSPECIFIED_USERID) override;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_APPEXECFWK_STANDARD_TOOLS_TEST_MOCK_MOCK_OVERLAY_MANAGER_HOST_H
@@ -537,6 +537,160 @@ HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2200, Function | MediumTest | TestSi
     EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_NO_BUNDLE_NAME_OPTION + "\n" + HELP_MSG_DUMP);
 }
 
+/**
+ * @tc.number: Bm_Command_Dump_2300
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -a" command writes the result to the output sink.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2300, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    auto outputSink = std::make_shared<StringSink>();
+    cmd.SetOutputSink(outputSink);
+    EXPECT_EQ(cmd.ExecCommand(), "");
+    EXPECT_EQ(outputSink->GetContent(), "OK");
+}
+
+/**
+ * @tc.number: Bm_Command_Dump_2400
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -d <device-id>" command writes the error message to the output sink.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2400, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-d"),
+        const_cast<char*>(DEFAULT_DEVICE_TIME.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    auto outputSink = std::make_shared<StringSink>();
+    cmd.SetOutputSink(outputSink);
+    EXPECT_EQ(cmd.ExecCommand(), "");
+    EXPECT_EQ(outputSink->GetContent(), HELP_MSG_NO_BUNDLE_NAME_OPTION + "\n" + HELP_MSG_DUMP);
+}
+
+/**
+ * @tc.number: Bm_Command_Dump_2500
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -a --offset <offset> --limit <limit>" command lists one page of the sorted bundles.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2500, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>("--offset"),
+        const_cast<char*>("0"),
+        const_cast<char*>("--limit"),
+        const_cast<char*>("1"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    std::string message = cmd.ExecCommand();
+    EXPECT_NE(message.find(":\n\tcom.example.bundle.one\nbundle count: 2\nnext offset: 1\n"), std::string::npos);
+    EXPECT_EQ(message.find("com.example.bundle.two"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bm_Command_Dump_2600
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -a --offset <offset>" command writes the rest of the list and the clones to the sink.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2600, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>("--offset"),
+        const_cast<char*>("0"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    auto outputSink = std::make_shared<StringSink>();
+    cmd.SetOutputSink(outputSink);
+    EXPECT_EQ(cmd.ExecCommand(), "");
+    EXPECT_NE(outputSink->GetContent().find(":\n\tcom.example.bundle.one\n\tcom.example.bundle.two (appIndex: 1)\n"
+        "bundle count: 2\n"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bm_Command_Dump_2700
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -n <bundle-name> --offset <offset>" command is rejected.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2700, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(STRING_BUNDLE_NAME.c_str()),
+        const_cast<char*>("--offset"),
+        const_cast<char*>("1"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_DUMP_PAGE_WITHOUT_ALL + "\n" + HELP_MSG_DUMP);
+}
+
+/**
+ * @tc.number: Bm_Command_Dump_2800
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -a --label --offset <offset>" command queries the label of a cloned bundle once
+ *           and shows the appIndex of the clone.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_2800, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>("--label"),
+        const_cast<char*>("--offset"),
+        const_cast<char*>("0"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    MockBundleMgrHost::SetFirstBundleCloneCount(1);
+    MockBundleMgrHost::ResetDumpLabelCount();
+    std::string message = cmd.ExecCommand();
+    size_t dumpLabelCount = MockBundleMgrHost::GetDumpLabelCount();
+    MockBundleMgrHost::SetFirstBundleCloneCount(0);
+    EXPECT_EQ(message, "com.example.bundle.one\ncom.example.bundle.one (appIndex: 1)\n"
+        "com.example.bundle.two (appIndex: 1)\nbundle count: 3\n");
+    // one label query for each bundle name, not for each clone
+    EXPECT_EQ(dumpLabelCount, 2u);
+}
+
 /**
  * @tc.number: Bm_Command_Shared_0001
  * @tc.name: ExecCommand
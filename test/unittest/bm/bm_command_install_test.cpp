@@ -14,16 +14,27 @@
  */
 
 #include <gtest/gtest.h>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
 #define private public
 #include "bundle_command.h"
 #undef private
+#include "bm_zip_test_utils.h"
 #include "bundle_constants.h"
 #include "bundle_installer_interface.h"
+#include "content_hash_cache.h"
+#include "hap_verifier.h"
 #include "iremote_broker.h"
 #include "iremote_object.h"
 #include "mock_bundle_mgr_host.h"
 #include "mock_bundle_installer_host.h"
+#include "nlohmann/json.hpp"
 
 using namespace testing::ext;
 using namespace OHOS;
@@ -31,6 +42,12 @@ using namespace OHOS::AAFwk;
 using namespace OHOS::AppExecFwk;
 
 namespace OHOS {
+namespace {
+const std::string VERIFY_BUNDLE_NAME = "com.example.verify";
+const std::string VERIFY_OTHER_BUNDLE_NAME = "com.example.verify.other";
+constexpr uint32_t VERIFY_VERSION_CODE = 1000000;
+} // namespace
+
 class BmCommandInstallTest : public ::testing::Test {
 public:
     static void SetUpTestCase();
@@ -1212,4 +1229,732 @@ HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5000, Function | MediumTest |
     auto ret = cmd.IsInstallOption(index);
     EXPECT_FALSE(ret);
 }
-} // OHOS
\ No newline at end of file
+
+/**
+ * @tc.number: Bm_Command_Install_5100
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify "bm install -p <bundle-path> ... --parallel <parallel-number>" groups the paths by bundle.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5100, Function | MediumTest | TestSize.Level1)
+{
+    // the two haps belong to one bundle
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(STRING_BUNDLE_INSTALL_PATH1.c_str()),
+        const_cast<char*>(STRING_BUNDLE_PATH.c_str()),
+        const_cast<char*>(STRING_BUNDLE_INSTALL_PATH2.c_str()),
+        const_cast<char*>(STRING_OTHER_BUNDLE_PATH.c_str()),
+        const_cast<char*>("--parallel"),
+        const_cast<char*>("2"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    std::string result = cmd.ExecCommand();
+    EXPECT_EQ(result.find(STRING_INSTALL_BUNDLE_OK + "\n"), 0);
+    EXPECT_NE(result.find("bundle count: 3\n"), std::string::npos);
+    EXPECT_NE(result.find("fail count: 0\n"), std::string::npos);
+
+    std::vector<BundleInstallGroup> groups;
+    cmd.GroupBundlePathsByBundleName({ STRING_BUNDLE_PATH, STRING_BUNDLE_INSTALL_PATH1, STRING_OTHER_BUNDLE_PATH },
+        1, groups);
+    ASSERT_EQ(groups.size(), 2);
+    EXPECT_EQ(groups[0].bundleName, "com.example.bundle_test");
+    EXPECT_EQ(groups[0].bundlePaths, std::vector<std::string>({ STRING_BUNDLE_PATH, STRING_OTHER_BUNDLE_PATH }));
+    EXPECT_EQ(groups[1].bundleName, "com.example.bundle_test1");
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5200
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm install -p <bundle-path> --parallel 0" command.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5200, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(STRING_BUNDLE_PATH.c_str()),
+        const_cast<char*>("--parallel"),
+        const_cast<char*>("0"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), STRING_REQUIRE_CORRECT_VALUE);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5300
+ * @tc.name: ExecCommand
+ * @tc.desc: 1.Test the IsInstallOption.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5300, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("--parallel"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+    int index = 2;
+    auto ret = cmd.IsInstallOption(index);
+    EXPECT_TRUE(ret);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5400
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm install -p <bundle-path> --progress" command.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5400, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(STRING_BUNDLE_PATH.c_str()),
+        const_cast<char*>("--progress"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(cmd.ExecCommand(), STRING_INSTALL_BUNDLE_OK + "\n");
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_TRUE(cmd.showProgress_);
+
+    // one progress event per notify in order, then the finished event with the latency
+    std::vector<nlohmann::json> events;
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line)) {
+        events.emplace_back(nlohmann::json::parse(line, nullptr, false));
+    }
+    ASSERT_EQ(events.size(), STREAM_INSTALL_PROGRESSES.size() + 1);
+    int64_t lastTimestamp = 0;
+    int64_t lastElapsedTime = 0;
+    for (size_t index = 0; index < events.size(); ++index) {
+        const nlohmann::json &event = events[index];
+        ASSERT_TRUE(event.is_object());
+        EXPECT_EQ(event["operation"], "install");
+        EXPECT_EQ(event["target"], STRING_BUNDLE_PATH);
+        EXPECT_GE(event["timestamp"].get<int64_t>(), lastTimestamp);
+        lastTimestamp = event["timestamp"].get<int64_t>();
+        if (index == STREAM_INSTALL_PROGRESSES.size()) {
+            break;
+        }
+        EXPECT_EQ(event["event"], "progress");
+        EXPECT_EQ(event["progress"], STREAM_INSTALL_PROGRESSES[index]);
+        EXPECT_GE(event["elapsedMs"].get<int64_t>(), lastElapsedTime);
+        lastElapsedTime = event["elapsedMs"].get<int64_t>();
+    }
+    const nlohmann::json &finished = events.back();
+    EXPECT_EQ(finished["event"], "finished");
+    EXPECT_EQ(finished["resultCode"], ERR_OK);
+    EXPECT_EQ(finished["timeToFirstProgressMs"], events.front()["elapsedMs"]);
+    EXPECT_GE(finished["timeToFinishMs"].get<int64_t>(), lastElapsedTime);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5500
+ * @tc.name: StatusReceiverImpl
+ * @tc.desc: Verify the progress callback and the latency of StatusReceiverImpl.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5500, Function | MediumTest | TestSize.Level1)
+{
+    sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl());
+    ASSERT_NE(statusReceiver, nullptr);
+    EXPECT_EQ(statusReceiver->GetFirstProgressTime(), -1);
+    EXPECT_EQ(statusReceiver->GetFinishTime(), -1);
+
+    int32_t lastProgress = 0;
+    statusReceiver->SetProgressCallback([&lastProgress](int32_t progress, int64_t elapsedTime) {
+        lastProgress = progress;
+    });
+    statusReceiver->OnStatusNotify(50);
+    statusReceiver->OnStatusNotify(100);
+    statusReceiver->OnFinished(ERR_OK, MSG_SUCCESS);
+    EXPECT_EQ(lastProgress, 100);
+    EXPECT_GE(statusReceiver->GetFirstProgressTime(), 0);
+    EXPECT_GE(statusReceiver->GetFinishTime(), statusReceiver->GetFirstProgressTime());
+    EXPECT_EQ(statusReceiver->GetResultCode(), ERR_OK);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5600
+ * @tc.name: GetAbsPaths
+ * @tc.desc: Verify GetAbsPaths keeps the paths which can not be resolved as they are and removes the duplicated ones.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5600, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // ".." after a symbolic link is not the parent of the link, so a path is never resolved lexically
+    std::vector<std::string> paths = {
+        "/data/test/bundle_test_missing/./second.hap",
+        "/data/test/bundle_test_missing/first.hap",
+        "",
+        "/data/test/other_missing/../bundle_test_missing/second.hap",
+        "/data/test/bundle_test_missing/first.hap",
+    };
+    std::vector<std::string> absPaths;
+    cmd.GetAbsPaths(paths, absPaths);
+    std::vector<std::string> expectPaths = {
+        "/data/test/bundle_test_missing/./second.hap",
+        "/data/test/bundle_test_missing/first.hap",
+        "/data/test/other_missing/../bundle_test_missing/second.hap",
+    };
+    EXPECT_EQ(absPaths, expectPaths);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5700
+ * @tc.name: GetAbsPaths
+ * @tc.desc: Verify GetAbsPaths resolves the real paths and expands the directories with their symbolic links.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5700, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+
+    char *currentPathPtr = getcwd(nullptr, 0);
+    ASSERT_NE(currentPathPtr, nullptr);
+    std::string currentPath = currentPathPtr;
+    free(currentPathPtr);
+    if (currentPath.back() != '/') {
+        currentPath.push_back('/');
+    }
+
+    // nothing is asserted after the directory is made, so it is always removed
+    char dirTemplate[] = "/data/local/tmp/bm_abs_paths_XXXXXX";
+    char *dirPath = mkdtemp(dirTemplate);
+    ASSERT_NE(dirPath, nullptr);
+    std::string bundleDir = dirPath;
+    char *realDirPtr = realpath(dirPath, nullptr);
+    std::string realDir = realDirPtr == nullptr ? bundleDir : realDirPtr;
+    free(realDirPtr);
+    std::vector<std::string> fileNames = { "feature.hsp", "entry.hap", "readme.txt", "sub/shared.hsp" };
+    mkdir((bundleDir + "/sub").c_str(), S_IRWXU);
+    for (const auto &fileName : fileNames) {
+        std::ofstream file(bundleDir + "/" + fileName);
+    }
+    EXPECT_EQ(symlink((bundleDir + "/sub/shared.hsp").c_str(), (bundleDir + "/linked.hsp").c_str()), 0);
+
+    std::vector<std::string> absPaths;
+    cmd.GetAbsPaths({ bundleDir + "/", "./" + STRING_BUNDLE_NAME, bundleDir + "/sub/../entry.hap" }, absPaths, true);
+    std::vector<std::string> expectPaths = {
+        realDir + "/entry.hap",
+        realDir + "/feature.hsp",
+        realDir + "/sub/shared.hsp",
+        currentPath + "./" + STRING_BUNDLE_NAME,
+    };
+    EXPECT_EQ(absPaths, expectPaths);
+
+    unlink((bundleDir + "/linked.hsp").c_str());
+    for (const auto &fileName : fileNames) {
+        unlink((bundleDir + "/" + fileName).c_str());
+    }
+    rmdir((bundleDir + "/sub").c_str());
+    rmdir(bundleDir.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5800
+ * @tc.name: StatusReceiverImpl
+ * @tc.desc: Verify the result of StatusReceiverImpl can be read many times and the first one wins.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5800, Function | MediumTest | TestSize.Level1)
+{
+    sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl());
+    ASSERT_NE(statusReceiver, nullptr);
+    EXPECT_FALSE(statusReceiver->GetCompletion().IsSignaled());
+    statusReceiver->OnFinished(ERR_OK, MSG_SUCCESS);
+    statusReceiver->OnFinished(IStatusReceiver::ERR_OPERATION_TIME_OUT, "");
+    EXPECT_TRUE(statusReceiver->GetCompletion().IsSignaled());
+    EXPECT_EQ(statusReceiver->GetResultCode(), ERR_OK);
+    EXPECT_EQ(statusReceiver->GetResultCode(), ERR_OK);
+    EXPECT_EQ(statusReceiver->GetResultMsg(), MSG_SUCCESS);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_5900
+ * @tc.name: CompletionSignal
+ * @tc.desc: Verify WaitAny and WaitAll on many status receivers.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_5900, Function | MediumTest | TestSize.Level1)
+{
+    sptr<StatusReceiverImpl> first(new (std::nothrow) StatusReceiverImpl());
+    sptr<StatusReceiverImpl> second(new (std::nothrow) StatusReceiverImpl());
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    std::vector<const CompletionSignal *> signals = { &first->GetCompletion(), &second->GetCompletion() };
+    Deadline deadline = Deadline::After(std::chrono::milliseconds(10));
+    EXPECT_EQ(CompletionSignal::WaitAll(signals, deadline), CompletionSignal::WaitResult::TIMEOUT);
+
+    second->OnFinished(ERR_OK, MSG_SUCCESS);
+    size_t index = signals.size();
+    EXPECT_EQ(CompletionSignal::WaitAny(signals, Deadline::Never(), index), CompletionSignal::WaitResult::READY);
+    EXPECT_EQ(index, 1);
+
+    first->OnFinished(ERR_OK, MSG_SUCCESS);
+    EXPECT_EQ(CompletionSignal::WaitAll(signals, Deadline::Never()), CompletionSignal::WaitResult::READY);
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6000
+ * @tc.name: CompletionSignal
+ * @tc.desc: Verify the waits are bounded by the scoped deadline and stopped by the cancellation.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6000, Function | MediumTest | TestSize.Level1)
+{
+    sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl());
+    ASSERT_NE(statusReceiver, nullptr);
+    {
+        ScopedDeadline scopedDeadline(Deadline::After(std::chrono::milliseconds(10)));
+        EXPECT_EQ(statusReceiver->GetResultCode(), IStatusReceiver::ERR_OPERATION_TIME_OUT);
+    }
+
+    CompletionSignal::RequestCancel();
+    EXPECT_EQ(statusReceiver->GetCompletion().Wait(Deadline::Never()), CompletionSignal::WaitResult::CANCELED);
+    CompletionSignal::ResetCancel();
+    EXPECT_FALSE(CompletionSignal::IsCancelRequested());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6100
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm install -p <bundle-path> --verify" command fails before any ipc with a broken file.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6100, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundlePath = "/data/local/tmp/bm_verify_broken.hap";
+    {
+        std::ofstream file(bundlePath);
+        file << "this is not a zip archive";
+    }
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(bundlePath.c_str()),
+        const_cast<char*>("--verify"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    std::string message = cmd.ExecCommand();
+    EXPECT_EQ(message.find(STRING_INSTALL_BUNDLE_NG), 0);
+    EXPECT_NE(message.find(bundlePath + ": "), std::string::npos);
+    unlink(bundlePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6200
+ * @tc.name: VerifyArchives
+ * @tc.desc: Verify VerifyArchives reports every file that can not be checked.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6200, Function | MediumTest | TestSize.Level1)
+{
+    std::string emptyPath = "/data/local/tmp/bm_verify_empty.hsp";
+    {
+        std::ofstream file(emptyPath);
+    }
+    std::string missingPath = "/data/local/tmp/bm_verify_missing.hap";
+    std::vector<HapVerifyResult> results;
+    std::string errorMsg;
+    EXPECT_FALSE(HapVerifier::VerifyArchives({ emptyPath, missingPath }, 2, false, results, errorMsg));
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_FALSE(results[0].isValid);
+    EXPECT_EQ(results[0].errorMsg, "not a zip archive");
+    EXPECT_FALSE(results[1].isValid);
+    EXPECT_EQ(results[1].errorMsg, "can not open the file");
+    EXPECT_NE(errorMsg.find(missingPath), std::string::npos);
+
+    results.clear();
+    errorMsg.clear();
+    EXPECT_TRUE(HapVerifier::VerifyArchives({}, 2, false, results, errorMsg));
+    EXPECT_TRUE(errorMsg.empty());
+    unlink(emptyPath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6300
+ * @tc.name: IsInstallUnchanged
+ * @tc.desc: Verify a file is unchanged only while its hash and the installed build match the cache.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6300, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundlePath = "/data/local/tmp/bm_skip_unchanged.hap";
+    std::string cachePath = "/data/local/tmp/bm_skip_unchanged_cache.json";
+    {
+        std::ofstream file(bundlePath);
+        file << "the content of the hap";
+    }
+    ContentHashEntry entry;
+    ASSERT_TRUE(ContentHashCache::ComputeHash(bundlePath, entry.hash, entry.size));
+    entry.bundleName = "com.example.bundle.one";
+    entry.moduleName = "moduleName";
+    entry.versionCode = 1000000;
+    entry.buildId = "1700000000000";
+    ContentHashCache savedCache(cachePath);
+    savedCache.Update(bundlePath, entry);
+    ASSERT_TRUE(savedCache.Save());
+
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    SetMockObjects(cmd);
+    ContentHashCache hashCache(cachePath);
+    hashCache.Load();
+    std::vector<ContentHashEntry> fileEntries;
+    EXPECT_TRUE(cmd.IsInstallUnchanged({ bundlePath }, Constants::DEFAULT_USERID, hashCache, fileEntries));
+    ASSERT_EQ(fileEntries.size(), 1);
+    EXPECT_EQ(fileEntries[0].size, entry.size);
+
+    entry.versionCode = 1;
+    hashCache.Update(bundlePath, entry);
+    EXPECT_FALSE(cmd.IsInstallUnchanged({ bundlePath }, Constants::DEFAULT_USERID, hashCache, fileEntries));
+
+    // another build of the same version installed in between
+    entry.versionCode = 1000000;
+    entry.buildId = "1600000000000";
+    hashCache.Update(bundlePath, entry);
+    EXPECT_FALSE(cmd.IsInstallUnchanged({ bundlePath }, Constants::DEFAULT_USERID, hashCache, fileEntries));
+
+    // a cache which other users may write is not trusted
+    ASSERT_EQ(chmod(cachePath.c_str(), S_IRUSR | S_IWUSR | S_IWOTH), 0);
+    hashCache.Load();
+    EXPECT_FALSE(cmd.IsInstallUnchanged({ bundlePath }, Constants::DEFAULT_USERID, hashCache, fileEntries));
+
+    {
+        std::ofstream file(bundlePath, std::ios::app);
+        file << " changed";
+    }
+    hashCache.Load();
+    EXPECT_FALSE(cmd.IsInstallUnchanged({ bundlePath }, Constants::DEFAULT_USERID, hashCache, fileEntries));
+    ASSERT_EQ(fileEntries.size(), 1);
+    EXPECT_NE(fileEntries[0].hash, entry.hash);
+    unlink(bundlePath.c_str());
+    unlink(cachePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6400
+ * @tc.name: VerifyArchive
+ * @tc.desc: Verify VerifyArchive reports an FA model hap and a hap without any profile.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6400, Function | MediumTest | TestSize.Level1)
+{
+    std::string faModelPath = "/data/local/tmp/bm_verify_fa_model.hap";
+    std::string noProfilePath = "/data/local/tmp/bm_verify_no_profile.hap";
+    WriteStoredZipFile(faModelPath, "config.json", "{\"app\":{\"bundleName\":\"com.example.fa\"}}");
+    WriteStoredZipFile(noProfilePath, "resources.index", "resources");
+
+    HapVerifyResult result;
+    EXPECT_FALSE(HapVerifier::VerifyArchive(faModelPath, result));
+    EXPECT_EQ(result.errorMsg, "FA model not supported by --verify");
+    EXPECT_FALSE(HapVerifier::VerifyArchive(noProfilePath, result));
+    EXPECT_EQ(result.errorMsg, "module.json is not found");
+    unlink(faModelPath.c_str());
+    unlink(noProfilePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6500
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm install -p <bundle-path> --verify" command installs a hap whose module.json is valid.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6500, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundlePath = "/data/local/tmp/bm_verify_valid.hap";
+    WriteStoredZipFile(bundlePath, "module.json", GetModuleJson(VERIFY_BUNDLE_NAME, "entry", VERIFY_VERSION_CODE));
+
+    HapVerifyResult result;
+    EXPECT_TRUE(HapVerifier::VerifyArchive(bundlePath, result));
+    EXPECT_TRUE(result.isValid);
+    EXPECT_TRUE(result.errorMsg.empty());
+    EXPECT_EQ(result.bundleName, VERIFY_BUNDLE_NAME);
+    EXPECT_EQ(result.moduleName, "entry");
+    EXPECT_EQ(result.versionCode, VERIFY_VERSION_CODE);
+
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(bundlePath.c_str()),
+        const_cast<char*>("--verify"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), STRING_INSTALL_BUNDLE_OK + "\n");
+    unlink(bundlePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6600
+ * @tc.name: VerifyArchives
+ * @tc.desc: Verify VerifyArchives rejects the haps of two bundles unless many bundles are allowed.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6600, Function | MediumTest | TestSize.Level1)
+{
+    std::string entryPath = "/data/local/tmp/bm_verify_entry.hap";
+    std::string otherPath = "/data/local/tmp/bm_verify_other.hap";
+    WriteStoredZipFile(entryPath, "module.json", GetModuleJson(VERIFY_BUNDLE_NAME, "entry", VERIFY_VERSION_CODE));
+    WriteStoredZipFile(otherPath, "module.json", GetModuleJson(VERIFY_OTHER_BUNDLE_NAME, "entry", VERIFY_VERSION_CODE));
+
+    std::vector<HapVerifyResult> results;
+    std::string errorMsg;
+    EXPECT_FALSE(HapVerifier::VerifyArchives({ entryPath, otherPath }, 2, false, results, errorMsg));
+    EXPECT_EQ(errorMsg, otherPath + ": bundleName " + VERIFY_OTHER_BUNDLE_NAME + " is not the same as " +
+        VERIFY_BUNDLE_NAME + " of " + entryPath + "\n");
+
+    errorMsg.clear();
+    EXPECT_TRUE(HapVerifier::VerifyArchives({ entryPath, otherPath }, 2, true, results, errorMsg));
+    EXPECT_TRUE(errorMsg.empty());
+    unlink(entryPath.c_str());
+    unlink(otherPath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6700
+ * @tc.name: VerifyArchives
+ * @tc.desc: Verify VerifyArchives rejects the haps of one bundle with different versionCodes.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6700, Function | MediumTest | TestSize.Level1)
+{
+    std::string entryPath = "/data/local/tmp/bm_verify_entry.hap";
+    std::string featurePath = "/data/local/tmp/bm_verify_feature.hap";
+    WriteStoredZipFile(entryPath, "module.json", GetModuleJson(VERIFY_BUNDLE_NAME, "entry", VERIFY_VERSION_CODE));
+    WriteStoredZipFile(featurePath, "module.json",
+        GetModuleJson(VERIFY_BUNDLE_NAME, "feature", VERIFY_VERSION_CODE + 1));
+
+    std::vector<HapVerifyResult> results;
+    std::string errorMsg;
+    EXPECT_FALSE(HapVerifier::VerifyArchives({ entryPath, featurePath }, 2, false, results, errorMsg));
+    EXPECT_EQ(errorMsg, featurePath + ": versionCode " + std::to_string(VERIFY_VERSION_CODE + 1) +
+        " is not the same as " + std::to_string(VERIFY_VERSION_CODE) + " of " + entryPath + "\n");
+    unlink(entryPath.c_str());
+    unlink(featurePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6800
+ * @tc.name: VerifyArchives
+ * @tc.desc: Verify VerifyArchives rejects two haps of one bundle with the same module.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6800, Function | MediumTest | TestSize.Level1)
+{
+    std::string entryPath = "/data/local/tmp/bm_verify_entry.hap";
+    std::string copyPath = "/data/local/tmp/bm_verify_entry_copy.hap";
+    WriteStoredZipFile(entryPath, "module.json", GetModuleJson(VERIFY_BUNDLE_NAME, "entry", VERIFY_VERSION_CODE));
+    WriteStoredZipFile(copyPath, "module.json", GetModuleJson(VERIFY_BUNDLE_NAME, "entry", VERIFY_VERSION_CODE));
+
+    std::vector<HapVerifyResult> results;
+    std::string errorMsg;
+    EXPECT_FALSE(HapVerifier::VerifyArchives({ entryPath, copyPath }, 2, false, results, errorMsg));
+    EXPECT_EQ(errorMsg, copyPath + ": module entry is repeated\n");
+    unlink(entryPath.c_str());
+    unlink(copyPath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_6900
+ * @tc.name: StatusReceiverImpl
+ * @tc.desc: Verify a canceled wait of StatusReceiverImpl is reported with its own code and message.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_6900, Function | MediumTest | TestSize.Level1)
+{
+    sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl());
+    ASSERT_NE(statusReceiver, nullptr);
+    CompletionSignal::RequestCancel();
+    int32_t resultCode = statusReceiver->GetResultCode();
+    std::string resultMsg = statusReceiver->GetResultMsg();
+    CompletionSignal::ResetCancel();
+    EXPECT_EQ(resultCode, StatusReceiverImpl::ERR_OPERATION_CANCELED);
+    EXPECT_NE(resultCode, IStatusReceiver::ERR_OPERATION_TIME_OUT);
+    EXPECT_EQ(resultMsg, "");
+
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    cmd.CreateMessageMap();
+    EXPECT_EQ(cmd.GetMessageFromCode(resultCode), "code:" + std::to_string(resultCode) + "\n" +
+        "error: operation canceled.\n");
+}
+
+/**
+ * @tc.number: Bm_Command_Install_7000
+ * @tc.name: CompletionSignal
+ * @tc.desc: Verify a single SIGINT terminates the tool out of any wait, as in a blocking ipc call,
+ *           and cancels the waits in progress.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_7000, Function | MediumTest | TestSize.Level1)
+{
+    EXPECT_EXIT({
+        CompletionSignal::InstallInterruptHandler();
+        raise(SIGINT);
+        exit(0);
+    }, testing::KilledBySignal(SIGINT), "");
+
+    EXPECT_EXIT({
+        CompletionSignal::InstallInterruptHandler();
+        sptr<StatusReceiverImpl> statusReceiver(new (std::nothrow) StatusReceiverImpl());
+        // the interrupt comes while the main thread waits for the result
+        std::thread interruptThread([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            raise(SIGINT);
+        });
+        int32_t resultCode = statusReceiver->GetResultCode();
+        interruptThread.join();
+        exit(resultCode == StatusReceiverImpl::ERR_OPERATION_CANCELED ? 0 : 1);
+    }, testing::ExitedWithCode(0), "");
+}
+
+/**
+ * @tc.number: Bm_Command_Install_7100
+ * @tc.name: ContentHashCache
+ * @tc.desc: Verify the content hash cache is empty when its group may write it, another user owns it or it is
+ *           reached through a symbolic link.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_7100, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundlePath = "/data/local/tmp/bm_trusted_cache.hap";
+    std::string cachePath = "/data/local/tmp/bm_trusted_cache.json";
+    std::string linkPath = "/data/local/tmp/bm_trusted_cache_link.json";
+    {
+        std::ofstream file(bundlePath);
+        file << "the content of the hap";
+    }
+    ContentHashEntry entry;
+    ASSERT_TRUE(ContentHashCache::ComputeHash(bundlePath, entry.hash, entry.size));
+    entry.bundleName = "com.example.bundle.one";
+    ContentHashCache savedCache(cachePath);
+    savedCache.Update(bundlePath, entry);
+    ASSERT_TRUE(savedCache.Save());
+
+    ContentHashCache hashCache(cachePath);
+    ContentHashEntry cachedEntry;
+    hashCache.Load();
+    EXPECT_TRUE(hashCache.Lookup(bundlePath, entry.hash, entry.size, cachedEntry));
+
+    ASSERT_EQ(chmod(cachePath.c_str(), S_IRUSR | S_IWUSR | S_IWGRP), 0);
+    hashCache.Load();
+    EXPECT_FALSE(hashCache.Lookup(bundlePath, entry.hash, entry.size, cachedEntry));
+    ASSERT_EQ(chmod(cachePath.c_str(), S_IRUSR | S_IWUSR), 0);
+
+    ASSERT_EQ(chown(cachePath.c_str(), geteuid() + 1, static_cast<gid_t>(-1)), 0);
+    hashCache.Load();
+    EXPECT_FALSE(hashCache.Lookup(bundlePath, entry.hash, entry.size, cachedEntry));
+    ASSERT_EQ(chown(cachePath.c_str(), geteuid(), static_cast<gid_t>(-1)), 0);
+
+    unlink(linkPath.c_str());
+    ASSERT_EQ(symlink(cachePath.c_str(), linkPath.c_str()), 0);
+    ContentHashCache linkCache(linkPath);
+    linkCache.Load();
+    EXPECT_FALSE(linkCache.Lookup(bundlePath, entry.hash, entry.size, cachedEntry));
+    hashCache.Load();
+    EXPECT_TRUE(hashCache.Lookup(bundlePath, entry.hash, entry.size, cachedEntry));
+    unlink(linkPath.c_str());
+    unlink(cachePath.c_str());
+    unlink(bundlePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Install_7200
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm install -p <bundle-path> --force" command installs a file which the cache skips.
+ */
+HWTEST_F(BmCommandInstallTest, Bm_Command_Install_7200, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundlePath = "/data/local/tmp/bm_force_unchanged.hap";
+    {
+        std::ofstream file(bundlePath);
+        file << "the content of the hap";
+    }
+    ContentHashEntry entry;
+    ASSERT_TRUE(ContentHashCache::ComputeHash(bundlePath, entry.hash, entry.size));
+    entry.bundleName = "com.example.bundle.one";
+    entry.moduleName = "moduleName";
+    entry.versionCode = 1000000;
+    entry.buildId = "1700000000000";
+    ContentHashCache savedCache;
+    savedCache.Update(bundlePath, entry);
+    ASSERT_TRUE(savedCache.Save());
+    ASSERT_EQ(setenv(ContentHashCache::SKIP_UNCHANGED_ENV, "1", 1), 0);
+
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(bundlePath.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), STRING_INSTALL_BUNDLE_OK + "\n" +
+        ContentHashCache::FormatAvoidedSize(1, entry.size));
+
+    char *forceArgv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(bundlePath.c_str()),
+        const_cast<char*>(ContentHashCache::FORCE_OPTION),
+        const_cast<char*>(""),
+    };
+    optind = 0;
+    BundleManagerShellCommand forceCmd(sizeof(forceArgv) / sizeof(forceArgv[0]) - 1, forceArgv);
+    SetMockObjects(forceCmd);
+    EXPECT_EQ(forceCmd.ExecCommand(), STRING_INSTALL_BUNDLE_OK + "\n");
+    unsetenv(ContentHashCache::SKIP_UNCHANGED_ENV);
+    unlink(ContentHashCache::DEFAULT_CACHE_PATH);
+    unlink(bundlePath.c_str());
+}
+} // OHOS
@@ -23,6 +23,8 @@
 #include "iremote_object.h"
 #include "mock_bundle_installer_host.h"
 #include "mock_bundle_mgr_host.h"
+#include "mock_overlay_manager_host.h"
+#include "nlohmann/json.hpp"
 
 using namespace testing::ext;
 using namespace OHOS::AAFwk;
@@ -348,6 +350,116 @@ HWTEST_F(BmCommandOverlayTest, Bm_Command_Overlay_0017, Function | MediumTest |
     EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_OVERLAY);
 }
 
+/**
+ * @tc.number: Bm_Command_Overlay_0018
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump-overlay -a" command fails without an overlay manager.
+ */
+HWTEST_F(BmCommandOverlayTest, Bm_Command_Overlay_0018, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(overlay_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), STRING_DUMP_OVERLAY_NG + "\n");
+}
+
+/**
+ * @tc.number: Bm_Command_Overlay_0019
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump-overlay --all -b <bundle-name>" command.
+ */
+HWTEST_F(BmCommandOverlayTest, Bm_Command_Overlay_0019, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(overlay_.c_str()),
+        const_cast<char*>("--all"),
+        const_cast<char*>("-b"),
+        const_cast<char*>(STRING_BUNDLE_NAME.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_OVERLAY);
+}
+
+#ifdef BUNDLE_FRAMEWORK_OVERLAY_INSTALLATION
+/**
+ * @tc.number: Bm_Command_Overlay_0020
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump-overlay -a" command dumps the overlay edges and skips the bundles without overlay.
+ */
+HWTEST_F(BmCommandOverlayTest, Bm_Command_Overlay_0020, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(overlay_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+    cmd.overlayManagerProxy_ = sptr<IOverlayManager>(new (std::nothrow) MockOverlayManagerHost());
+
+    std::string result = cmd.ExecCommand();
+    std::string prefix = STRING_DUMP_OVERLAY_OK + "\n";
+    ASSERT_EQ(result.compare(0, prefix.size(), prefix), 0);
+    nlohmann::json graph = nlohmann::json::parse(result.substr(prefix.size()), nullptr, false);
+    ASSERT_FALSE(graph.is_discarded());
+    EXPECT_EQ(graph["bundleCount"], 2);
+    EXPECT_EQ(graph["overlayModules"], nlohmann::json::parse(
+        R"({"com.example.bundle.two": [["feature", "entry", 1, 1]]})"));
+    EXPECT_EQ(graph["overlayBundles"], nlohmann::json::parse(
+        R"({"com.example.bundle.one": [["com.example.bundle.two", 1, 1]]})"));
+}
+
+/**
+ * @tc.number: Bm_Command_Overlay_0021
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump-overlay -a" command fails when an overlay query fails with another error.
+ */
+HWTEST_F(BmCommandOverlayTest, Bm_Command_Overlay_0021, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(overlay_.c_str()),
+        const_cast<char*>("-a"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+    cmd.overlayManagerProxy_ = sptr<IOverlayManager>(new (std::nothrow) MockOverlayManagerHost());
+
+    MockOverlayManagerHost::SetQueryOverlayBundleFailed(true);
+    std::string result = cmd.ExecCommand();
+    MockOverlayManagerHost::SetQueryOverlayBundleFailed(false);
+    EXPECT_EQ(result, STRING_DUMP_OVERLAY_NG + "\n");
+}
+#endif
+
 /**
  * @tc.number: Bm_Command_Target_Overlay_0001
  * @tc.name: ExecCommand
@@ -14,11 +14,17 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdint>
+#include <fstream>
+#include <unistd.h>
 
 #define protected public
 #include "bundle_command.h"
 #include "quick_fix_command.h"
 #undef protected
+#include "bm_zip_test_utils.h"
+#include "content_hash_cache.h"
+#include "hap_verifier.h"
 
 using namespace testing::ext;
 using namespace OHOS;
@@ -345,6 +351,147 @@ HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Apply_0900, TestSize.Level1)
     EXPECT_EQ(cmd.ExecCommand(), "apply quickfix failed with errno: 8520706.\n");
 }
 
+/**
+ * @tc.name: Bm_Command_QuickFix_Apply_1000
+ * @tc.desc: "bm quickfix --apply -f <file-path> -f <file-path>" test, every -f is the patch set of one bundle.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Apply_1000, TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("--apply"),
+        const_cast<char*>("-f"),
+        const_cast<char*>("/data/storage/el1/aa.hqf"),
+        const_cast<char*>("--file-path"),
+        const_cast<char*>("/data/storage/el2/bb.hqf"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // a set whose bundle can not be read from its hqf files is not applied
+    std::string failedMsg = ": can not open the file.\n";
+    EXPECT_EQ(cmd.ExecCommand(), "patch set 1: apply quickfix failed with error: /data/storage/el1/aa.hqf" +
+        failedMsg + "patch set 2: apply quickfix failed with error: /data/storage/el2/bb.hqf" + failedMsg +
+        "patch set count: 2, success count: 0, fail count: 2\n");
+}
+
+/**
+ * @tc.name: Bm_Command_QuickFix_Apply_1100
+ * @tc.desc: Test ApplyQuickFixes with an empty patch set.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Apply_1100, TestSize.Level1)
+{
+    std::string resultInfo;
+    EXPECT_EQ(QuickFixCommand::ApplyQuickFixes({}, resultInfo), ERR_INVALID_VALUE);
+    EXPECT_EQ(resultInfo, "quick fix file is empty.\n");
+
+    resultInfo.clear();
+    std::vector<std::vector<std::string>> patchSets = { {}, {} };
+    EXPECT_EQ(QuickFixCommand::ApplyQuickFixes(patchSets, resultInfo), ERR_INVALID_VALUE);
+    EXPECT_NE(resultInfo.find("patch set count: 2, success count: 0, fail count: 2\n"), std::string::npos);
+}
+
+/**
+ * @tc.name: Bm_Command_QuickFix_Apply_1200
+ * @tc.desc: Test ApplyQuickFixes reads the bundle of every patch set from patch.json before the apply.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Apply_1200, TestSize.Level1)
+{
+    std::string onePath = "/data/test/bm_quick_fix_one.hqf";
+    std::string twoPath = "/data/test/bm_quick_fix_two.hqf";
+    std::string noPatchPath = "/data/test/bm_quick_fix_no_patch.hqf";
+    WriteStoredZipFile(onePath, "patch.json", "{\"app\":{\"bundleName\":\"com.example.one\",\"versionCode\":1}}");
+    WriteStoredZipFile(twoPath, "patch.json", "{\"app\":{\"bundleName\":\"com.example.two\",\"versionCode\":1}}");
+    WriteStoredZipFile(noPatchPath, "module.json", "{}");
+
+    std::string bundleName;
+    std::string errorMsg;
+    EXPECT_TRUE(HapVerifier::GetQuickFixBundleName(onePath, bundleName, errorMsg));
+    EXPECT_EQ(bundleName, "com.example.one");
+    EXPECT_FALSE(HapVerifier::GetQuickFixBundleName(noPatchPath, bundleName, errorMsg));
+    EXPECT_EQ(errorMsg, "patch.json is not found");
+
+    // neither set is applied, so no result of another bundle can be taken for them
+    std::string resultInfo;
+    std::vector<std::vector<std::string>> patchSets = { { onePath, twoPath }, { noPatchPath } };
+    EXPECT_EQ(QuickFixCommand::ApplyQuickFixes(patchSets, resultInfo), ERR_INVALID_VALUE);
+    EXPECT_EQ(resultInfo, "patch set 1: apply quickfix failed with error: " + twoPath +
+        ": bundleName com.example.two is not the same as com.example.one.\n"
+        "patch set 2: apply quickfix failed with error: " + noPatchPath + ": patch.json is not found.\n"
+        "patch set count: 2, success count: 0, fail count: 2\n");
+    unlink(onePath.c_str());
+    unlink(twoPath.c_str());
+    unlink(noPatchPath.c_str());
+}
+
+/**
+ * @tc.name: Bm_Command_QuickFix_Apply_1300
+ * @tc.desc: Test the apply of a patch set is skipped only while its files and the applied patch match the cache.
+ * @tc.type: FUNC
+ */
+HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Apply_1300, TestSize.Level1)
+{
+    std::string entryPath = "/data/test/bm_quick_fix_skip_entry.hqf";
+    std::string featurePath = "/data/test/bm_quick_fix_skip_feature.hqf";
+    std::string cachePath = "/data/test/bm_quick_fix_skip_cache.json";
+    WriteStoredZipFile(entryPath, "patch.json", "{\"app\":{\"bundleName\":\"com.example.skip\"}}");
+    WriteStoredZipFile(featurePath, "patch.json", "{\"app\":{\"bundleName\":\"com.example.skip\",\"v\":2}}");
+    AAFwk::ApplicationQuickFixInfo quickFixInfo;
+    quickFixInfo.bundleName = "com.example.skip";
+    quickFixInfo.appqfInfo.versionCode = 1000000;
+    HqfInfo hqfInfo;
+    hqfInfo.moduleName = "entry";
+    hqfInfo.hapSha256 = "entrySha256";
+    quickFixInfo.appqfInfo.hqfInfos.emplace_back(hqfInfo);
+
+    ContentHashCache savedCache(cachePath);
+    for (const auto &path : { entryPath, featurePath }) {
+        ContentHashEntry entry;
+        ASSERT_TRUE(ContentHashCache::ComputeHash(path, entry.hash, entry.size));
+        entry.bundleName = quickFixInfo.bundleName;
+        entry.versionCode = static_cast<int64_t>(quickFixInfo.appqfInfo.versionCode);
+        entry.buildId = ContentHashCache::ComputeTextHash(QuickFixCommand::GetQuickFixInfoString(quickFixInfo));
+        savedCache.Update(path, entry);
+    }
+    ASSERT_TRUE(savedCache.Save());
+    ContentHashCache hashCache(cachePath);
+    hashCache.Load();
+
+    std::vector<std::string> realPaths;
+    std::vector<ContentHashEntry> fileEntries;
+    ContentHashEntry record;
+    EXPECT_TRUE(QuickFixCommand::IsQuickFixUnchanged({ entryPath, featurePath }, hashCache, realPaths, fileEntries,
+        record));
+    ASSERT_EQ(fileEntries.size(), 2);
+    EXPECT_EQ(record.bundleName, quickFixInfo.bundleName);
+    EXPECT_TRUE(QuickFixCommand::IsQuickFixStillApplied(record, quickFixInfo));
+
+    // another patch of the same version applied in between
+    AAFwk::ApplicationQuickFixInfo otherInfo = quickFixInfo;
+    otherInfo.appqfInfo.hqfInfos[0].hapSha256 = "otherSha256";
+    EXPECT_FALSE(QuickFixCommand::IsQuickFixStillApplied(record, otherInfo));
+    otherInfo = quickFixInfo;
+    otherInfo.appqfInfo.versionCode = 1000001;
+    EXPECT_FALSE(QuickFixCommand::IsQuickFixStillApplied(record, otherInfo));
+
+    // a directory is not hashed and a file that is not recorded is applied
+    EXPECT_FALSE(QuickFixCommand::IsQuickFixUnchanged({ "/data/test" }, hashCache, realPaths, fileEntries, record));
+    WriteStoredZipFile(featurePath, "patch.json", "{\"app\":{\"bundleName\":\"com.example.skip\",\"v\":3}}");
+    EXPECT_FALSE(QuickFixCommand::IsQuickFixUnchanged({ entryPath, featurePath }, hashCache, realPaths, fileEntries,
+        record));
+    ASSERT_EQ(fileEntries.size(), 2);
+    EXPECT_FALSE(fileEntries[1].hash.empty());
+    unlink(entryPath.c_str());
+    unlink(featurePath.c_str());
+    unlink(cachePath.c_str());
+}
+
 /**
  * @tc.name: Bm_Command_QuickFix_Query_0100
  * @tc.desc: "bm quickfix -q" test.
@@ -589,6 +736,50 @@ HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Query_1200, TestSize.Level1)
         "file path: step3\n");
 }
 
+/**
+ * @tc.name: Bm_Command_QuickFix_Query_1300
+ * @tc.desc: Test GetQuickFixInfoString keeps the text byte for byte with every field and several modules
+ * @tc.type: FUNC
+ */
+HWTEST_F(BmCommandQuickFixTest, Bm_Command_QuickFix_Query_1300, TestSize.Level1)
+{
+    AAFwk::ApplicationQuickFixInfo quickFixInfo;
+    quickFixInfo.bundleName = "com.example.bundle";
+    quickFixInfo.bundleVersionCode = UINT32_MAX;
+    quickFixInfo.bundleVersionName = "1.0.0";
+    quickFixInfo.appqfInfo.versionCode = 1000000;
+    quickFixInfo.appqfInfo.versionName = "1.0.1";
+    quickFixInfo.appqfInfo.cpuAbi = "arm64-v8a";
+    quickFixInfo.appqfInfo.nativeLibraryPath = "patch_1000000/libs/arm64";
+    quickFixInfo.appqfInfo.type = AppExecFwk::QuickFixType::UNKNOWN;
+    const std::vector<std::string> moduleNames = { "entry", "feature" };
+    for (const auto &moduleName : moduleNames) {
+        HqfInfo hqfInfo;
+        hqfInfo.moduleName = moduleName;
+        hqfInfo.hapSha256 = moduleName + "Sha256";
+        hqfInfo.hqfFilePath = "/data/app/el1/bundle/public/com.example.bundle/patch_1000000/" + moduleName + ".hqf";
+        quickFixInfo.appqfInfo.hqfInfos.emplace_back(hqfInfo);
+    }
+    std::string ret = QuickFixCommand::GetQuickFixInfoString(quickFixInfo);
+    EXPECT_EQ(ret, "ApplicationQuickFixInfo:\n"
+        "  bundle name: com.example.bundle\n"
+        "  bundle version code: 4294967295\n"
+        "  bundle version name: 1.0.0\n"
+        "  patch version code: 1000000\n"
+        "  patch version name: 1.0.1\n"
+        "  cpu abi: arm64-v8a\n"
+        "  native library path: patch_1000000/libs/arm64\n"
+        "  type: \n"
+        "  ModuelQuickFixInfo:\n"
+        "    module name: entry\n"
+        "    module sha256: entrySha256\n"
+        "    file path: /data/app/el1/bundle/public/com.example.bundle/patch_1000000/entry.hqf\n"
+        "  ModuelQuickFixInfo:\n"
+        "    module name: feature\n"
+        "    module sha256: featureSha256\n"
+        "    file path: /data/app/el1/bundle/public/com.example.bundle/patch_1000000/feature.hqf\n");
+}
+
 /**
  * @tc.name: Bm_Command_QuickFix_Remove_0001
  * @tc.desc: "bm quickfix -r" test.
@@ -13,20 +13,27 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <sstream>
 
 #define private public
 #define protected public
 
 #include "bundle_command.h"
 #undef private
+#include "bundle_command_common.h"
 #include "bundle_installer_interface.h"
+#include "command_trace.h"
 #include "iremote_broker.h"
 #include "iremote_object.h"
 #include "mock_bundle_installer_host.h"
 #include "mock_bundle_mgr_host.h"
+#include "mock_os_account_manager.h"
 #include "parameter.h"
 #include "parameters.h"
+#include "text_builder.h"
 
 using namespace testing::ext;
 using namespace OHOS::AAFwk;
@@ -672,6 +679,91 @@ HWTEST_F(BmCommandTest, Bm_Command_Clean_0017, Function | MediumTest | TestSize.
     EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_CLEAN);
 }
 
+/**
+ * @tc.number: Bm_Command_Clean_0018
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm clean -n <bundle-name>,<bundle-name> -c --parallel 2" command.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Clean_0018, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundleNames = STRING_BUNDLE_NAME + ",otherName";
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("clean"),
+        const_cast<char*>("-n"),
+        const_cast<char*>(bundleNames.c_str()),
+        const_cast<char*>("-c"),
+        const_cast<char*>("--parallel"),
+        const_cast<char*>("2"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    std::string result = cmd.ExecCommand();
+    EXPECT_EQ(result.find(STRING_CLEAN_CACHE_BUNDLE_OK + "\n"), 0);
+    EXPECT_NE(result.find("bundleName: " + STRING_BUNDLE_NAME + ", result: success, reclaimed: 0 bytes"),
+        std::string::npos);
+    EXPECT_NE(result.find("bundleName: otherName, result: success"), std::string::npos);
+    EXPECT_NE(result.find("bundle count: 2\nsuccess count: 2\nfail count: 0\n"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bm_Command_Clean_0019
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm clean -c --all-third-party" command.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Clean_0019, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("clean"),
+        const_cast<char*>("-c"),
+        const_cast<char*>("--all-third-party"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    std::string result = cmd.ExecCommand();
+    EXPECT_EQ(result.find(STRING_CLEAN_CACHE_BUNDLE_OK + "\n"), 0);
+    EXPECT_NE(result.find("bundleName: com.example.bundle.one, result: success"), std::string::npos);
+    EXPECT_NE(result.find("bundleName: com.example.bundle.two, result: success"), std::string::npos);
+    EXPECT_NE(result.find("bundle count: 2\n"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bm_Command_Clean_0020
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm clean -n <bundle-name>,<bundle-name> -c -d" command cleans the cache and the data.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Clean_0020, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundleNames = STRING_BUNDLE_NAME + ",otherName";
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("clean"),
+        const_cast<char*>("-n"),
+        const_cast<char*>(bundleNames.c_str()),
+        const_cast<char*>("-c"),
+        const_cast<char*>("-d"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    // the cache clean succeeds with the mock, the data clean fails without the app manager, as in Bm_Command_Clean_0006
+    std::string result = cmd.ExecCommand();
+    EXPECT_EQ(result.find(STRING_CLEAN_BUNDLE_PARTIAL_NG + "\n"), 0);
+    EXPECT_NE(result.find("bundleName: " + STRING_BUNDLE_NAME + ", result: failed, cache: success, data: failed"),
+        std::string::npos);
+    EXPECT_NE(result.find("bundleName: otherName, result: failed, cache: success, data: failed"), std::string::npos);
+    EXPECT_NE(result.find("bundle count: 2\nsuccess count: 0\nfail count: 2\n"), std::string::npos);
+}
+
 /**
  * @tc.number: Bm_Command_Enable_0001
  * @tc.name: ExecCommand
@@ -1850,4 +1942,248 @@ HWTEST_F(BmCommandTest, BundleManagerShellCommand_0200, Function | MediumTest |
     option = originOption;
     EXPECT_EQ(ret, OHOS::ERR_INVALID_VALUE);
 }
-} // namespace OHOS
\ No newline at end of file
+
+/**
+ * @tc.number: BundleManagerShellCommand_0210
+ * @tc.name: ExecBatchScript
+ * @tc.desc: Verify the commands of a batch script are executed in one process.
+ */
+HWTEST_F(BmCommandTest, BundleManagerShellCommand_0210, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("batch"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+    cmd.CreateCommandMap();
+    cmd.CreateMessageMap();
+
+    std::istringstream input("# install and uninstall\n\nbm install -p " + STRING_BUNDLE_PATH +
+        "\nuninstall -n " + STRING_BUNDLE_NAME + "\n");
+    std::ostringstream output;
+    cmd.ExecBatchScript(input, output);
+    EXPECT_NE(output.str().find(STRING_INSTALL_BUNDLE_OK + "\n[batch] line 3 result: success"), std::string::npos);
+    EXPECT_NE(output.str().find(STRING_UNINSTALL_BUNDLE_OK + "\n[batch] line 4 result: success"),
+        std::string::npos);
+    EXPECT_NE(cmd.resultReceiver_.find("batch command count: 2\n"), std::string::npos);
+    EXPECT_NE(cmd.resultReceiver_.find("fail count: 0\n"), std::string::npos);
+}
+
+/**
+ * @tc.number: BundleManagerShellCommand_0220
+ * @tc.name: ExecBatchScript
+ * @tc.desc: Verify the nested batch and the unknown command are reported as failed.
+ */
+HWTEST_F(BmCommandTest, BundleManagerShellCommand_0220, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("batch"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+    cmd.CreateCommandMap();
+    cmd.CreateMessageMap();
+
+    std::istringstream input("batch -f script.txt\nxxx\n");
+    std::ostringstream output;
+    cmd.ExecBatchScript(input, output);
+    EXPECT_NE(output.str().find(STRING_BATCH_NESTED_NG), std::string::npos);
+    EXPECT_NE(output.str().find("[batch] line 2 result: failed"), std::string::npos);
+    EXPECT_NE(cmd.resultReceiver_.find("fail count: 2\n"), std::string::npos);
+    EXPECT_EQ(cmd.cmd_, "batch");
+}
+
+/**
+ * @tc.number: BundleManagerShellCommand_0230
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f <script-path>" command with a nonexistent script.
+ */
+HWTEST_F(BmCommandTest, BundleManagerShellCommand_0230, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("batch"),
+        const_cast<char*>("-f"),
+        const_cast<char*>("/data/test/nonexistent_script.txt"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), STRING_BATCH_OPEN_FILE_NG + "\n");
+}
+
+/**
+ * @tc.number: BundleManagerShellCommand_0240
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f" command with no argument.
+ */
+HWTEST_F(BmCommandTest, BundleManagerShellCommand_0240, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("batch"),
+        const_cast<char*>("-f"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), STRING_REQUIRE_CORRECT_VALUE + HELP_MSG_BATCH);
+}
+
+/**
+ * @tc.number: Bm_Command_Trace_0100
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm --trace=<file> help" command writes chrome trace json and runs "bm help".
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Trace_0100, Function | MediumTest | TestSize.Level1)
+{
+    const std::string tracePath = "/data/test/bm_trace.json";
+    std::string traceOption = std::string(CommandTrace::TRACE_OPTION) + "=" + tracePath;
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(traceOption.c_str()),
+        const_cast<char*>("help"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.argc_, argc - 1);
+    EXPECT_EQ(cmd.cmd_, "help");
+    EXPECT_EQ(argv[0], TOOL_NAME.c_str());
+    EXPECT_EQ(argv[1], traceOption.c_str());
+    EXPECT_TRUE(CommandTrace::IsEnabled());
+    cmd.ExecCommand();
+    EXPECT_FALSE(CommandTrace::IsEnabled());
+
+    std::ifstream traceFile(tracePath);
+    std::stringstream trace;
+    trace << traceFile.rdbuf();
+    EXPECT_EQ(trace.str().find("{\"traceEvents\":["), 0);
+    EXPECT_NE(trace.str().find("\"name\":\"ShellCommand::OnCommand\",\"cat\":\"command\""), std::string::npos);
+    remove(tracePath.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Trace_0200
+ * @tc.name: FormatSummary
+ * @tc.desc: Verify the trace summary adds up the events of each category.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Trace_0200, Function | MediumTest | TestSize.Level1)
+{
+    std::vector<TraceEvent> events(3);
+    events[0].category = TraceCategory::IPC;
+    events[0].wallUs = 100;
+    events[0].cpuUs = 10;
+    events[1].category = TraceCategory::IPC;
+    events[1].wallUs = 200;
+    events[1].cpuUs = 20;
+    events[2].category = TraceCategory::COMMAND;
+    events[2].wallUs = 400;
+    events[2].cpuUs = 40;
+
+    EXPECT_EQ(CommandTrace::FormatSummary(events), "trace: command 1 x 400us cpu 40us, ipc 2 x 300us cpu 30us\n");
+    EXPECT_EQ(CommandTrace::FormatSummary({}), "trace:\n");
+}
+
+/**
+ * @tc.number: Bm_Command_Trace_0300
+ * @tc.name: ShellCommand
+ * @tc.desc: Verify BM_TRACE enables the trace only for "1", "summary" or a file path.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Trace_0300, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>("help"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    const std::vector<std::pair<std::string, bool>> traceEnvs = {
+        {"1", true}, {"summary", true}, {"/data/test/bm_trace.json", true},
+        {"0", false}, {"", false}, {"yes", false},
+    };
+    for (const auto &[traceEnv, isEnabled] : traceEnvs) {
+        setenv(CommandTrace::TRACE_ENV, traceEnv.c_str(), 1);
+        BundleManagerShellCommand cmd(argc, argv);
+        EXPECT_EQ(CommandTrace::IsEnabled(), isEnabled) << traceEnv;
+    }
+    unsetenv(CommandTrace::TRACE_ENV);
+    CommandTrace::Start("");
+}
+
+/**
+ * @tc.number: Bm_Command_User_Cache_0100
+ * @tc.name: GetCurrentUserId
+ * @tc.desc: Verify the resolved user is kept until the user cache is invalidated.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_User_Cache_0100, Function | MediumTest | TestSize.Level1)
+{
+    const int32_t userId = 100;
+    EXPECT_EQ(BundleCommandCommon::GetCurrentUserId(userId), userId);
+#ifdef ACCOUNT_ENABLE
+    const int32_t backgroundUserId = 101;
+    BundleCommandCommon::InvalidateUserCache();
+    MockOsAccountManager::ResetQueryCount();
+    for (int32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID),
+            MockOsAccountManager::MOCK_FOREGROUND_USER_ID);
+        EXPECT_TRUE(BundleCommandCommon::IsUserForeground(MockOsAccountManager::MOCK_FOREGROUND_USER_ID));
+        EXPECT_FALSE(BundleCommandCommon::IsUserForeground(backgroundUserId));
+    }
+    EXPECT_EQ(MockOsAccountManager::GetForegroundUserQueryCount(), 1);
+    // one query per user
+    EXPECT_EQ(MockOsAccountManager::GetForegroundStateQueryCount(), 2);
+
+    BundleCommandCommon::InvalidateUserCache();
+    EXPECT_EQ(BundleCommandCommon::GetCurrentUserId(Constants::UNSPECIFIED_USERID),
+        MockOsAccountManager::MOCK_FOREGROUND_USER_ID);
+    EXPECT_TRUE(BundleCommandCommon::IsUserForeground(MockOsAccountManager::MOCK_FOREGROUND_USER_ID));
+    EXPECT_EQ(MockOsAccountManager::GetForegroundUserQueryCount(), 2);
+    EXPECT_EQ(MockOsAccountManager::GetForegroundStateQueryCount(), 3);
+#endif
+}
+
+/**
+ * @tc.number: Bm_Command_Text_Builder_0100
+ * @tc.name: TextBuilder
+ * @tc.desc: Verify the builder formats strings, chars and integers in place and keeps the existing text.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Text_Builder_0100, Function | MediumTest | TestSize.Level1)
+{
+    std::string text = "head\n";
+    TextBuilder builder(text, 64);
+    EXPECT_GE(text.capacity(), text.size() + 64);
+    const std::string bundleName = "com.example.bundle";
+    builder.AppendLine("bundleName: ", bundleName, ", appIndex: ", static_cast<int32_t>(-1));
+    builder.Append(std::string_view("size: "), static_cast<int64_t>(INT64_MAX), ' ', static_cast<uint32_t>(0));
+    EXPECT_EQ(text, "head\nbundleName: com.example.bundle, appIndex: -1\nsize: 9223372036854775807 0");
+    EXPECT_EQ(builder.GetSize(), text.size());
+}
+} // namespace OHOS
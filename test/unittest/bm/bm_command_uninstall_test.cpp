@@ -15,6 +15,9 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <unistd.h>
+
 #define private public
 #include "bundle_command.h"
 #undef private
@@ -30,6 +33,11 @@ using namespace OHOS::AAFwk;
 using namespace OHOS::AppExecFwk;
 
 namespace OHOS {
+namespace {
+const std::string STRING_OTHER_BUNDLE_NAME = "otherName";
+const std::string STRING_THIRD_BUNDLE_NAME = "thirdName";
+} // namespace
+
 class BmCommandUninstallTest : public ::testing::Test {
 public:
     static void SetUpTestCase();
@@ -712,4 +720,124 @@ HWTEST_F(BmCommandUninstallTest, Bm_Command_Uninstall_2700, Function | MediumTes
 
     EXPECT_EQ(cmd.ExecCommand(), STRING_UNINSTALL_BUNDLE_OK + "\n");
 }
-} // OHOS
\ No newline at end of file
+
+/**
+ * @tc.number: Bm_Command_Uninstall_2800
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm uninstall -n <bundle-name> --progress" command.
+ */
+HWTEST_F(BmCommandUninstallTest, Bm_Command_Uninstall_2800, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(STRING_BUNDLE_NAME.c_str()),
+        const_cast<char*>("--progress"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), STRING_UNINSTALL_BUNDLE_OK + "\n");
+}
+
+/**
+ * @tc.number: Bm_Command_Uninstall_2900
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm uninstall -n <bundle-name>,<bundle-name> -n <bundle-name> --parallel 2" command.
+ */
+HWTEST_F(BmCommandUninstallTest, Bm_Command_Uninstall_2900, Function | MediumTest | TestSize.Level1)
+{
+    std::string bundleNames = STRING_BUNDLE_NAME + "," + STRING_OTHER_BUNDLE_NAME;
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(bundleNames.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(STRING_THIRD_BUNDLE_NAME.c_str()),
+        const_cast<char*>("--parallel"),
+        const_cast<char*>("2"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    std::string result = cmd.ExecCommand();
+    EXPECT_EQ(result.find(STRING_UNINSTALL_BUNDLE_OK + "\n"), 0);
+    EXPECT_NE(result.find("bundleName: " + STRING_THIRD_BUNDLE_NAME + ", result: success"), std::string::npos);
+    EXPECT_NE(result.find("bundle count: 3\n"), std::string::npos);
+    EXPECT_NE(result.find("fail count: 0\n"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bm_Command_Uninstall_3000
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm uninstall --from-file <file-path>" command skips comments and repeated names.
+ */
+HWTEST_F(BmCommandUninstallTest, Bm_Command_Uninstall_3000, Function | MediumTest | TestSize.Level1)
+{
+    std::string filePath = "/data/local/tmp/bm_uninstall_names_" + std::to_string(getpid());
+    {
+        std::ofstream nameFile(filePath);
+        ASSERT_TRUE(nameFile.is_open());
+        nameFile << "# bundles to remove\n" << STRING_BUNDLE_NAME << "\n\n" << STRING_OTHER_BUNDLE_NAME << " \n" <<
+            STRING_BUNDLE_NAME << "\n";
+    }
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("--from-file"),
+        const_cast<char*>(filePath.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    std::string result = cmd.ExecCommand();
+    unlink(filePath.c_str());
+    EXPECT_EQ(result.find(STRING_UNINSTALL_BUNDLE_OK + "\n"), 0);
+    EXPECT_NE(result.find("bundle count: 2\n"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bm_Command_Uninstall_3100
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm uninstall -n <bundle-name> -n <bundle-name> -m <module-name>" command is rejected.
+ */
+HWTEST_F(BmCommandUninstallTest, Bm_Command_Uninstall_3100, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TOOL_NAME.c_str()),
+        const_cast<char*>(cmd_.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(STRING_BUNDLE_NAME.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(STRING_OTHER_BUNDLE_NAME.c_str()),
+        const_cast<char*>("-m"),
+        const_cast<char*>(STRING_MODULE_NAME.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+
+    BundleManagerShellCommand cmd(argc, argv);
+
+    // set the mock objects
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.ExecCommand(), STRING_UNINSTALL_MULTIPLE_BUNDLES_NG + "\n" + HELP_MSG_UNINSTALL);
+}
+} // OHOS
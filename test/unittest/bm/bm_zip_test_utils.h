@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_TEST_UNITTEST_BM_BM_ZIP_TEST_UTILS_H
+#define FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_TEST_UNITTEST_BM_BM_ZIP_TEST_UTILS_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "zlib.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+inline void AppendUint16(std::string &data, uint16_t value)
+{
+    data.push_back(static_cast<char>(value & 0xFF));
+    data.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+inline void AppendUint32(std::string &data, uint32_t value)
+{
+    AppendUint16(data, static_cast<uint16_t>(value & 0xFFFF));
+    AppendUint16(data, static_cast<uint16_t>(value >> 16));
+}
+
+// the module.json of a stage model hap
+inline std::string GetModuleJson(const std::string &bundleName, const std::string &moduleName, uint32_t versionCode)
+{
+    return "{\"app\": {\"bundleName\": \"" + bundleName + "\", \"bundleType\": \"app\", \"versionCode\": " +
+        std::to_string(versionCode) + ", \"versionName\": \"1.0.0\", \"minAPIVersion\": 12, " +
+        "\"targetAPIVersion\": 12}, \"module\": {\"name\": \"" + moduleName + "\", \"type\": \"entry\", " +
+        "\"deviceTypes\": [\"default\"]}}";
+}
+
+// a zip file with one stored entry, eg: an hqf file with patch.json or a hap file with module.json
+inline void WriteStoredZipFile(const std::string &path, const std::string &entryName, const std::string &content)
+{
+    uint32_t crc = static_cast<uint32_t>(
+        crc32(0L, reinterpret_cast<const Bytef *>(content.data()), static_cast<uInt>(content.size())));
+    std::string localHeader;
+    AppendUint32(localHeader, 0x04034b50);
+    AppendUint16(localHeader, 10);
+    AppendUint16(localHeader, 0);
+    AppendUint16(localHeader, 0);
+    AppendUint32(localHeader, 0);
+    AppendUint32(localHeader, crc);
+    AppendUint32(localHeader, content.size());
+    AppendUint32(localHeader, content.size());
+    AppendUint16(localHeader, entryName.size());
+    AppendUint16(localHeader, 0);
+    localHeader.append(entryName).append(content);
+
+    std::string centralDir;
+    AppendUint32(centralDir, 0x02014b50);
+    AppendUint16(centralDir, 10);
+    AppendUint16(centralDir, 10);
+    AppendUint16(centralDir, 0);
+    AppendUint16(centralDir, 0);
+    AppendUint32(centralDir, 0);
+    AppendUint32(centralDir, crc);
+    AppendUint32(centralDir, content.size());
+    AppendUint32(centralDir, content.size());
+    AppendUint16(centralDir, entryName.size());
+    AppendUint16(centralDir, 0);
+    AppendUint16(centralDir, 0);
+    AppendUint16(centralDir, 0);
+    AppendUint16(centralDir, 0);
+    AppendUint32(centralDir, 0);
+    AppendUint32(centralDir, 0);
+    centralDir.append(entryName);
+
+    std::string endOfCentralDir;
+    AppendUint32(endOfCentralDir, 0x06054b50);
+    AppendUint16(endOfCentralDir, 0);
+    AppendUint16(endOfCentralDir, 0);
+    AppendUint16(endOfCentralDir, 1);
+    AppendUint16(endOfCentralDir, 1);
+    AppendUint32(endOfCentralDir, centralDir.size());
+    AppendUint32(endOfCentralDir, localHeader.size());
+    AppendUint16(endOfCentralDir, 0);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << localHeader << centralDir << endOfCentralDir;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // FOUNDATION_BUNDLEMANAGER_BUNDLE_TOOL_TEST_UNITTEST_BM_BM_ZIP_TEST_UTILS_H
@@ -154,4 +154,83 @@ HWTEST_F(BundleTestToolCacheStatTest, Bundle_Test_Tool_Get_Each_Bundle_Cache_Sta
     EXPECT_NE(msg.find("fail count: 1"), std::string::npos);
     EXPECT_NE(msg.find("total cache size: 100"), std::string::npos);
 }
+
+/**
+ * @tc.number: Bundle_Test_Tool_Get_Each_Bundle_Cache_Stat_0400
+ * @tc.name: GetEachBundleCacheStat
+ * @tc.desc: Verify GetEachBundleCacheStat keeps the bundle order when the stats are queried concurrently.
+ */
+HWTEST_F(BundleTestToolCacheStatTest, Bundle_Test_Tool_Get_Each_Bundle_Cache_Stat_0400,
+    Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>("bundle_test_tool"),
+        const_cast<char*>("getEachBundleCacheStat"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+
+    std::string msg;
+    bool ret = cmd.GetEachBundleCacheStat(100, msg, 2);
+
+    EXPECT_TRUE(ret);
+    size_t firstPos = msg.find("bundleName: com.example.bundle.one, appIndex: 0, cache size: 100");
+    size_t secondPos = msg.find("bundleName: com.example.bundle.two, appIndex: 1, cache size: 200");
+    EXPECT_NE(firstPos, std::string::npos);
+    EXPECT_NE(secondPos, std::string::npos);
+    EXPECT_LT(firstPos, secondPos);
+    EXPECT_NE(msg.find("total cache size: 300"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Get_Each_Bundle_Cache_Stat_0500
+ * @tc.name: GetEachBundleCacheStat
+ * @tc.desc: Verify GetEachBundleCacheStat with batch size still reports every bundle.
+ */
+HWTEST_F(BundleTestToolCacheStatTest, Bundle_Test_Tool_Get_Each_Bundle_Cache_Stat_0500,
+    Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>("bundle_test_tool"),
+        const_cast<char*>("getEachBundleCacheStat"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+
+    std::string msg;
+    bool ret = cmd.GetEachBundleCacheStat(100, msg, 2, 1);
+
+    EXPECT_TRUE(ret);
+    EXPECT_NE(msg.find("success count: 2"), std::string::npos);
+    EXPECT_NE(msg.find("fail count: 0"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Get_Each_Bundle_Cache_Stat_0600
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify "getEachBundleCacheStat -j 0" is rejected.
+ */
+HWTEST_F(BundleTestToolCacheStatTest, Bundle_Test_Tool_Get_Each_Bundle_Cache_Stat_0600,
+    Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>("bundle_test_tool"),
+        const_cast<char*>("getEachBundleCacheStat"),
+        const_cast<char*>("-j"),
+        const_cast<char*>("0"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+
+    int32_t userId = 0;
+    int32_t jobs = 0;
+    int32_t batchSize = 0;
+    EXPECT_EQ(cmd.EachBundleCacheStatCommonFunc(userId, jobs, batchSize), OHOS::ERR_INVALID_VALUE);
+}
 }  // namespace OHOS
@@ -0,0 +1,691 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define private public
+#include "bundle_test_tool.h"
+#undef private
+
+#include "bm_zip_test_utils.h"
+#include "iremote_broker.h"
+#include "iremote_object.h"
+#include "mock_bundle_installer_host.h"
+#include "mock_bundle_mgr_host.h"
+#include "nlohmann/json.hpp"
+#include "option_schema.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace OHOS {
+namespace {
+const std::string TEST_TOOL_NAME = "bundle_test_tool";
+const std::string FIRST_BUNDLE_NAME = "com.example.bundle.one";
+const std::string SECOND_BUNDLE_NAME = "com.example.bundle.two";
+const std::string THIRD_BUNDLE_NAME = "com.example.bundle.three";
+const std::string SNAPSHOT_PATH = "/data/local/tmp/bundle_test_tool_snapshot_test";
+const std::string SNAPSHOT_USER_ID = "100";
+const std::string SPM_MODULE_DIR = "/data/local/tmp/bundle_test_tool_spm_module_test";
+const std::string SPM_BUNDLE_NAME = "com.example.spm";
+const std::string STRING_PARSE_SPM_MODULE_OK = "parseSpmModule successfully\n";
+const std::string STRING_PARSE_SPM_MODULE_NG = "parseSpmModule failed\n";
+const std::string QUICK_FIX_DIR = "/data/local/tmp/bundle_test_tool_quick_fix_test";
+constexpr int32_t FIRST_BUNDLE_UID = 20010001;
+constexpr int32_t SECOND_BUNDLE_UID = 20010002;
+constexpr int32_t MAX_TEST_USER_ID = 10000;
+
+std::string GetPatchJson(const std::string &bundleName)
+{
+    return "{\"app\":{\"bundleName\":\"" + bundleName + "\",\"versionCode\":1}}";
+}
+
+struct TestOptions {
+    int32_t userId = -1;
+    std::string name;
+    std::vector<std::string> paths;
+    bool isWatch = false;
+};
+
+constexpr OptionField<TestOptions> TEST_OPTION_FIELDS[] = {
+    Int32Option('u', "user-id", &TestOptions::userId, "user-id", 0, MAX_TEST_USER_ID, "specify a user id"),
+    StringOption('n', "bundle-name", &TestOptions::name, "bundle-name", "specify a bundle name"),
+    StringListOption('p', "module-json-path", &TestOptions::paths, "path", "specify a path\ncan be repeated", true),
+    FlagOption('w', "watch", &TestOptions::isWatch, "watch"),
+};
+
+constexpr OptionSchema<TestOptions> TEST_OPTION_SCHEMA("usage: test <options>\n", TEST_OPTION_FIELDS);
+
+// a stage model module.json of SPM_BUNDLE_NAME
+void WriteSpmModuleJson(const std::string &path, const std::string &moduleName)
+{
+    std::ofstream file(path);
+    file << "{\"app\": {\"bundleName\": \"" << SPM_BUNDLE_NAME << "\", \"bundleType\": \"app\", " <<
+        "\"versionCode\": 1000000, \"versionName\": \"1.0.0\", \"minAPIVersion\": 12, \"targetAPIVersion\": 12}, " <<
+        "\"module\": {\"name\": \"" << moduleName << "\", \"type\": \"entry\", \"deviceTypes\": [\"default\"], " <<
+        "\"requestPermissions\": [{\"name\": \"ohos.permission.INTERNET\"}]}}";
+}
+} // namespace
+
+class BundleTestToolTest : public testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+    void MakeMockObjects();
+    void SetMockObjects(BundleTestTool &cmd) const;
+
+    sptr<IBundleMgr> mgrProxyPtr_;
+    sptr<IBundleInstaller> installerProxyPtr_;
+};
+
+void BundleTestToolTest::SetUp()
+{
+    optind = 0;
+    MakeMockObjects();
+}
+
+void BundleTestToolTest::TearDown()
+{}
+
+void BundleTestToolTest::MakeMockObjects()
+{
+    auto mgrHostPtr = sptr<IRemoteObject>(new (std::nothrow) MockBundleMgrHost());
+    mgrProxyPtr_ = iface_cast<IBundleMgr>(mgrHostPtr);
+
+    auto installerHostPtr = sptr<IRemoteObject>(new (std::nothrow) MockBundleInstallerHost());
+    installerProxyPtr_ = iface_cast<IBundleInstaller>(installerHostPtr);
+}
+
+void BundleTestToolTest::SetMockObjects(BundleTestTool &cmd) const
+{
+    cmd.bundleMgrProxy_ = mgrProxyPtr_;
+    cmd.bundleInstallerProxy_ = installerProxyPtr_;
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Batch_Get_Bundle_Info_0100
+ * @tc.name: StreamBatchGetBundleInfo
+ * @tc.desc: Verify StreamBatchGetBundleInfo prints one bundle info per line across chunks.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Batch_Get_Bundle_Info_0100, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("batchGetBundleInfo"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+
+    std::vector<std::string> bundleNames = { FIRST_BUNDLE_NAME, SECOND_BUNDLE_NAME, THIRD_BUNDLE_NAME };
+    std::ostringstream output;
+    size_t bundleCount = 0;
+    ErrCode ret = cmd.StreamBatchGetBundleInfo(bundleNames, 0, 100, 2, output, bundleCount);
+
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(bundleCount, bundleNames.size());
+    std::istringstream lines(output.str());
+    std::string line;
+    size_t lineCount = 0;
+    while (std::getline(lines, line)) {
+        nlohmann::json jsonObject = nlohmann::json::parse(line, nullptr, false);
+        ASSERT_FALSE(jsonObject.is_discarded());
+        EXPECT_EQ(jsonObject["name"], bundleNames[lineCount]);
+        ++lineCount;
+    }
+    EXPECT_EQ(lineCount, bundleNames.size());
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Batch_Get_Bundle_Info_0200
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify "batchGetBundleInfo -n <bundle-name> -s -c 0" is rejected.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Batch_Get_Bundle_Info_0200, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("batchGetBundleInfo"),
+        const_cast<char*>("-n"),
+        const_cast<char*>(FIRST_BUNDLE_NAME.c_str()),
+        const_cast<char*>("-s"),
+        const_cast<char*>("-c"),
+        const_cast<char*>("0"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.RunAsBatchGetBundleInfo(), OHOS::ERR_INVALID_VALUE);
+    EXPECT_NE(cmd.resultReceiver_.find("error: option requires a correct value."), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Batch_Get_Compatible_Device_Type_0100
+ * @tc.name: RunAsBatchGetCompatibleDeviceType
+ * @tc.desc: Verify "batchGetCompatibleDeviceType" queries a repeated bundle name once and keeps the input order.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Batch_Get_Compatible_Device_Type_0100,
+    Function | MediumTest | TestSize.Level1)
+{
+    std::string bundleNames = SECOND_BUNDLE_NAME + "," + FIRST_BUNDLE_NAME + "," + SECOND_BUNDLE_NAME;
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("batchGetCompatibleDeviceType"),
+        const_cast<char*>("-n"),
+        const_cast<char*>(bundleNames.c_str()),
+        const_cast<char*>("-n"),
+        const_cast<char*>(THIRD_BUNDLE_NAME.c_str()),
+        const_cast<char*>("-c"),
+        const_cast<char*>("1"),
+        const_cast<char*>("-j"),
+        const_cast<char*>("2"),
+        const_cast<char*>("-l"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.RunAsBatchGetCompatibleDeviceType(), ERR_OK);
+
+    std::istringstream lines(cmd.resultReceiver_);
+    std::string line;
+    ASSERT_TRUE(std::getline(lines, line));
+    nlohmann::json jsonResult = nlohmann::json::parse(line, nullptr, false);
+    ASSERT_TRUE(jsonResult.is_array());
+    ASSERT_EQ(jsonResult.size(), 4);
+    EXPECT_EQ(jsonResult[0]["bundleName"], SECOND_BUNDLE_NAME);
+    EXPECT_EQ(jsonResult[1]["bundleName"], FIRST_BUNDLE_NAME);
+    EXPECT_EQ(jsonResult[2], jsonResult[0]);
+    EXPECT_EQ(jsonResult[0]["compatibleDeviceType"], "phone");
+    EXPECT_EQ(jsonResult[3]["bundleName"], THIRD_BUNDLE_NAME);
+    EXPECT_TRUE(jsonResult[3].contains("errCode"));
+    EXPECT_NE(cmd.resultReceiver_.find("input count: 4, unique count: 3\n"), std::string::npos);
+    EXPECT_NE(cmd.resultReceiver_.find("chunk count: 3, chunk latency(us) p50: "), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Batch_Get_Compatible_Device_Type_0200
+ * @tc.name: RunAsBatchGetCompatibleDeviceType
+ * @tc.desc: Verify "batchGetCompatibleDeviceType" queries all the bundles in one chunk without a chunk size.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Batch_Get_Compatible_Device_Type_0200,
+    Function | MediumTest | TestSize.Level1)
+{
+    std::string bundleNames = SECOND_BUNDLE_NAME + "," + FIRST_BUNDLE_NAME;
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("batchGetCompatibleDeviceType"),
+        const_cast<char*>("-n"),
+        const_cast<char*>(bundleNames.c_str()),
+        const_cast<char*>("-l"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.RunAsBatchGetCompatibleDeviceType(), ERR_OK);
+    EXPECT_NE(cmd.resultReceiver_.find("chunk count: 1, chunk latency(us) p50: "), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Get_Simple_App_Info_For_Uid_0100
+ * @tc.name: RunAsGetSimpleAppInfoForUid
+ * @tc.desc: Verify "getSimpleAppInfoForUid" prints one line per uid in the input order.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Get_Simple_App_Info_For_Uid_0100,
+    Function | MediumTest | TestSize.Level1)
+{
+    std::string uids = std::to_string(SECOND_BUNDLE_UID) + "," + std::to_string(FIRST_BUNDLE_UID);
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("getSimpleAppInfoForUid"),
+        const_cast<char*>("-u"),
+        const_cast<char*>(uids.c_str()),
+        const_cast<char*>("-c"),
+        const_cast<char*>("1"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.RunAsGetSimpleAppInfoForUid(), ERR_OK);
+
+    size_t secondPos = cmd.resultReceiver_.find(SECOND_BUNDLE_NAME);
+    size_t firstPos = cmd.resultReceiver_.find(FIRST_BUNDLE_NAME);
+    ASSERT_NE(secondPos, std::string::npos);
+    ASSERT_NE(firstPos, std::string::npos);
+    EXPECT_LT(secondPos, firstPos);
+    EXPECT_EQ(cmd.resultReceiver_.find("unique count"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Get_Simple_App_Info_For_Uid_0200
+ * @tc.name: RunAsGetSimpleAppInfoForUid
+ * @tc.desc: Verify "getSimpleAppInfoForUid" rejects a uid that is not a number.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Get_Simple_App_Info_For_Uid_0200,
+    Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("getSimpleAppInfoForUid"),
+        const_cast<char*>("-u"),
+        const_cast<char*>("20010001,uid"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.RunAsGetSimpleAppInfoForUid(), OHOS::ERR_INVALID_VALUE);
+    EXPECT_EQ(cmd.resultReceiver_.find("error: option requires a correct value"), 0);
+    EXPECT_NE(cmd.resultReceiver_.find("  -u, --uid <uid>"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Snapshot_0100
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify "snapshot -u 100 -f <file-path>" writes a snapshot searchable by bundle name and uid.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Snapshot_0100, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("snapshot"),
+        const_cast<char*>("-u"),
+        const_cast<char*>(SNAPSHOT_USER_ID.c_str()),
+        const_cast<char*>("-f"),
+        const_cast<char*>(SNAPSHOT_PATH.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+
+    EXPECT_EQ(cmd.RunAsSnapshotCommand(), OHOS::ERR_OK);
+    EXPECT_NE(cmd.resultReceiver_.find("bundle count: 2"), std::string::npos);
+
+    // a snapshot without a watcher is never used by the queries, it is opened here only to inspect it
+    BundleSnapshot snapshot;
+    EXPECT_FALSE(snapshot.Open(SNAPSHOT_PATH));
+    ASSERT_TRUE(snapshot.Open(SNAPSHOT_PATH, false));
+    EXPECT_EQ(snapshot.GetUserId(), std::stoi(SNAPSHOT_USER_ID));
+    BundleSnapshotRecord record;
+    EXPECT_TRUE(snapshot.FindByBundleName(FIRST_BUNDLE_NAME, 0, record));
+    EXPECT_EQ(record.uid, FIRST_BUNDLE_UID);
+    EXPECT_FALSE(snapshot.FindByBundleName(SECOND_BUNDLE_NAME, 0, record));
+    EXPECT_TRUE(snapshot.FindByUid(SECOND_BUNDLE_UID, record));
+    EXPECT_EQ(record.bundleName, SECOND_BUNDLE_NAME);
+    EXPECT_EQ(record.appIndex, 1);
+    EXPECT_FALSE(snapshot.FindByBundleName(THIRD_BUNDLE_NAME, 0, record));
+    BundleSnapshot::Invalidate(SNAPSHOT_PATH);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Snapshot_0200
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify "getUidByBundleName" reads the snapshot set by BM_SNAPSHOT only while its watcher holds the lock.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Snapshot_0200, Function | MediumTest | TestSize.Level1)
+{
+    int32_t lockFd = BundleSnapshot::LockWatcher(SNAPSHOT_PATH);
+    ASSERT_GE(lockFd, 0);
+    EXPECT_LT(BundleSnapshot::LockWatcher(SNAPSHOT_PATH), 0);
+    std::vector<BundleSnapshotRecord> records(1);
+    records[0].bundleName = FIRST_BUNDLE_NAME;
+    records[0].uid = FIRST_BUNDLE_UID;
+    EXPECT_TRUE(BundleSnapshot::Write(SNAPSHOT_PATH, std::stoi(SNAPSHOT_USER_ID), true, records));
+    setenv("BM_SNAPSHOT", SNAPSHOT_PATH.c_str(), 1);
+
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("getUidByBundleName"),
+        const_cast<char*>("-n"),
+        const_cast<char*>(FIRST_BUNDLE_NAME.c_str()),
+        const_cast<char*>("-u"),
+        const_cast<char*>(SNAPSHOT_USER_ID.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.RunGetUidByBundleName(), OHOS::ERR_OK);
+    EXPECT_EQ(cmd.resultReceiver_, std::to_string(FIRST_BUNDLE_UID) + "\n");
+
+    BundleSnapshot::UnlockWatcher(lockFd);
+    BundleSnapshot snapshot;
+    EXPECT_FALSE(snapshot.Open(SNAPSHOT_PATH));
+
+    BundleSnapshot::Invalidate(SNAPSHOT_PATH);
+    optind = 0;
+    cmd.resultReceiver_.clear();
+    EXPECT_EQ(cmd.RunGetUidByBundleName(), OHOS::ERR_OK);
+    EXPECT_NE(cmd.resultReceiver_, std::to_string(FIRST_BUNDLE_UID) + "\n");
+    unsetenv("BM_SNAPSHOT");
+    unlink((SNAPSHOT_PATH + ".lock").c_str());
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Parse_Spm_Module_0100
+ * @tc.name: RunAsParseSpmModule
+ * @tc.desc: Verify "parseSpmModule" searches the directories and reports every module.json on its own line.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Parse_Spm_Module_0100, Function | MediumTest | TestSize.Level1)
+{
+    std::string subDir = SPM_MODULE_DIR + "/entry";
+    ASSERT_TRUE(mkdir(SPM_MODULE_DIR.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    ASSERT_TRUE(mkdir(subDir.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    std::string brokenPath = subDir + "/module.json";
+    {
+        std::ofstream file(brokenPath);
+        file << "{";
+    }
+    std::string missingPath = SPM_MODULE_DIR + "/missing/module.json";
+
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("parseSpmModule"),
+        const_cast<char*>("-p"),
+        const_cast<char*>(SPM_MODULE_DIR.c_str()),
+        const_cast<char*>("-p"),
+        const_cast<char*>(missingPath.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    optind = 0;
+    EXPECT_EQ(cmd.RunAsParseSpmModule(), OHOS::ERR_INVALID_VALUE);
+    EXPECT_NE(cmd.resultReceiver_.find(brokenPath + ": failed to parse file\n"), std::string::npos);
+    EXPECT_NE(cmd.resultReceiver_.find(missingPath + ": failed to open file\n"), std::string::npos);
+    EXPECT_NE(cmd.resultReceiver_.find("module count: 2\nfail count: 2\n"), std::string::npos);
+
+    unlink(brokenPath.c_str());
+    rmdir(subDir.c_str());
+    rmdir(SPM_MODULE_DIR.c_str());
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Parse_Spm_Module_0200
+ * @tc.name: RunAsParseSpmModule
+ * @tc.desc: Verify "parseSpmModule" without the required -p prints the generated help.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Parse_Spm_Module_0200, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("parseSpmModule"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    optind = 0;
+    EXPECT_EQ(cmd.RunAsParseSpmModule(), OHOS::ERR_INVALID_VALUE);
+    EXPECT_EQ(cmd.resultReceiver_.find(HELP_MSG_NO_OPTION + "\n"), 0);
+    EXPECT_NE(cmd.resultReceiver_.find("  -p, --module-json-path <path>          specify module.json file path"),
+        std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Parse_Spm_Module_0300
+ * @tc.name: RunAsParseSpmModule
+ * @tc.desc: Verify "parseSpmModule" with one file prints the readable json and the messages of a single parse.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Parse_Spm_Module_0300, Function | MediumTest | TestSize.Level1)
+{
+    ASSERT_TRUE(mkdir(SPM_MODULE_DIR.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    std::string validPath = SPM_MODULE_DIR + "/valid.json";
+    WriteSpmModuleJson(validPath, "entry");
+    std::string brokenPath = SPM_MODULE_DIR + "/broken.json";
+    {
+        std::ofstream file(brokenPath);
+        file << "{";
+    }
+    std::string missingPath = SPM_MODULE_DIR + "/missing.json";
+    const std::vector<std::string> paths = { validPath, brokenPath, missingPath };
+    std::vector<std::string> outputs;
+    std::vector<ErrCode> results;
+    for (const auto &path : paths) {
+        char *argv[] = {
+            const_cast<char*>(TEST_TOOL_NAME.c_str()),
+            const_cast<char*>("parseSpmModule"),
+            const_cast<char*>("-p"),
+            const_cast<char*>(path.c_str()),
+            const_cast<char*>(""),
+        };
+        int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+        BundleTestTool cmd(argc, argv);
+        optind = 0;
+        results.emplace_back(cmd.RunAsParseSpmModule());
+        outputs.emplace_back(cmd.resultReceiver_);
+    }
+
+    EXPECT_EQ(results[0], OHOS::ERR_OK);
+    ASSERT_EQ(outputs[0].find(STRING_PARSE_SPM_MODULE_OK), 0);
+    std::string moduleText = outputs[0].substr(STRING_PARSE_SPM_MODULE_OK.size());
+    EXPECT_NE(moduleText.find("\n    \"bundleName\": \"" + SPM_BUNDLE_NAME + "\""), std::string::npos);
+    nlohmann::json moduleInfo = nlohmann::json::parse(moduleText, nullptr, false);
+    ASSERT_TRUE(moduleInfo.is_object());
+    EXPECT_EQ(moduleInfo["bundleName"], SPM_BUNDLE_NAME);
+    EXPECT_EQ(moduleInfo["moduleName"], "entry");
+    EXPECT_EQ(results[1], OHOS::ERR_INVALID_VALUE);
+    EXPECT_EQ(outputs[1], STRING_PARSE_SPM_MODULE_NG);
+    EXPECT_EQ(results[2], OHOS::ERR_INVALID_VALUE);
+    EXPECT_EQ(outputs[2], STRING_PARSE_SPM_MODULE_NG + "failed to open file: " + missingPath + "\n");
+
+    unlink(validPath.c_str());
+    unlink(brokenPath.c_str());
+    rmdir(SPM_MODULE_DIR.c_str());
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Parse_Spm_Module_0400
+ * @tc.name: RunAsParseSpmModule
+ * @tc.desc: Verify "parseSpmModule" with a directory prints one compact json line per module.json file.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Parse_Spm_Module_0400, Function | MediumTest | TestSize.Level1)
+{
+    const std::vector<std::string> moduleNames = { "entry", "feature" };
+    ASSERT_TRUE(mkdir(SPM_MODULE_DIR.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    std::vector<std::string> modulePaths;
+    for (const auto &moduleName : moduleNames) {
+        std::string subDir = SPM_MODULE_DIR + "/" + moduleName;
+        ASSERT_TRUE(mkdir(subDir.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+        modulePaths.emplace_back(subDir + "/module.json");
+        WriteSpmModuleJson(modulePaths.back(), moduleName);
+    }
+
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("parseSpmModule"),
+        const_cast<char*>("-p"),
+        const_cast<char*>(SPM_MODULE_DIR.c_str()),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    optind = 0;
+    EXPECT_EQ(cmd.RunAsParseSpmModule(), OHOS::ERR_OK);
+    std::string output = cmd.resultReceiver_;
+    EXPECT_NE(output.find("module count: 2\nfail count: 0\n"), std::string::npos);
+    for (size_t i = 0; i < moduleNames.size(); ++i) {
+        std::string prefix = modulePaths[i] + ": ";
+        size_t linePos = output.find(prefix);
+        ASSERT_NE(linePos, std::string::npos);
+        size_t lineEnd = output.find('\n', linePos);
+        ASSERT_NE(lineEnd, std::string::npos);
+        nlohmann::json moduleInfo = nlohmann::json::parse(
+            output.substr(linePos + prefix.size(), lineEnd - linePos - prefix.size()), nullptr, false);
+        ASSERT_TRUE(moduleInfo.is_object());
+        EXPECT_EQ(moduleInfo["bundleName"], SPM_BUNDLE_NAME);
+        EXPECT_EQ(moduleInfo["moduleName"], moduleNames[i]);
+        unlink(modulePaths[i].c_str());
+        rmdir((SPM_MODULE_DIR + "/" + moduleNames[i]).c_str());
+    }
+    rmdir(SPM_MODULE_DIR.c_str());
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Option_Schema_0100
+ * @tc.name: OptionSchema::Parse
+ * @tc.desc: Verify the schema parses short, long, grouped and repeated options and rejects values out of range.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Option_Schema_0100, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("test"),
+        const_cast<char*>("-u100"),
+        const_cast<char*>("--bundle-name=com.example.bundle.one"),
+        const_cast<char*>("-wp"),
+        const_cast<char*>("/a"),
+        const_cast<char*>("--module-json-path"),
+        const_cast<char*>("/b"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    TestOptions options;
+    std::string errorOption;
+    EXPECT_EQ(TEST_OPTION_SCHEMA.Parse(argc, argv, 2, options, errorOption), OptionParseResult::OK);
+    EXPECT_EQ(options.userId, 100);
+    EXPECT_EQ(options.name, FIRST_BUNDLE_NAME);
+    EXPECT_TRUE(options.isWatch);
+    EXPECT_EQ(options.paths, (std::vector<std::string> { "/a", "/b" }));
+
+    char *outOfRange[] = { argv[0], argv[1], const_cast<char*>("-u"), const_cast<char*>("10001") };
+    EXPECT_EQ(TEST_OPTION_SCHEMA.Parse(4, outOfRange, 2, options, errorOption), OptionParseResult::INVALID_VALUE);
+    char *missingValue[] = { argv[0], argv[1], const_cast<char*>("--bundle-name") };
+    EXPECT_EQ(TEST_OPTION_SCHEMA.Parse(3, missingValue, 2, options, errorOption), OptionParseResult::MISSING_VALUE);
+    char *unknown[] = { argv[0], argv[1], const_cast<char*>("-x") };
+    EXPECT_EQ(TEST_OPTION_SCHEMA.Parse(3, unknown, 2, options, errorOption), OptionParseResult::UNKNOWN_OPTION);
+    EXPECT_EQ(errorOption, "-x");
+    TestOptions emptyOptions;
+    EXPECT_EQ(TEST_OPTION_SCHEMA.Parse(2, argv, 2, emptyOptions, errorOption), OptionParseResult::MISSING_REQUIRED);
+    EXPECT_EQ(errorOption, "--module-json-path");
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Option_Schema_0200
+ * @tc.name: OptionSchema::GetHelp and OptionSchema::GetInputSchema
+ * @tc.desc: Verify the help text and the input schema are generated from the same options.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Option_Schema_0200, Function | MediumTest | TestSize.Level1)
+{
+    std::string help = TEST_OPTION_SCHEMA.GetHelp();
+    EXPECT_EQ(help.find("usage: test <options>\noptions list:\n"), 0);
+    EXPECT_NE(help.find("  -u, --user-id <user-id>                specify a user id\n"), std::string::npos);
+    EXPECT_NE(help.find("specify a path\n                                           can be repeated\n"),
+        std::string::npos);
+
+    nlohmann::json schema = nlohmann::json::parse(TEST_OPTION_SCHEMA.GetInputSchema(), nullptr, false);
+    ASSERT_FALSE(schema.is_discarded());
+    EXPECT_EQ(schema["properties"]["userId"]["type"], "integer");
+    EXPECT_EQ(schema["properties"]["userId"]["maximum"], MAX_TEST_USER_ID);
+    EXPECT_EQ(schema["properties"]["bundleName"]["type"], "string");
+    EXPECT_EQ(schema["properties"]["moduleJsonPath"]["description"], "specify a path can be repeated");
+    EXPECT_EQ(schema["properties"]["watch"]["type"], "boolean");
+    EXPECT_EQ(schema["required"], nlohmann::json::array({ "moduleJsonPath" }));
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Deploy_Quick_Fix_0100
+ * @tc.name: RunAsDeployQuickFix
+ * @tc.desc: Verify "deployQuickFix --multi-bundle" fails without any hqf file and lists the option in the help.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Deploy_Quick_Fix_0100, Function | MediumTest | TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("deployQuickFix"),
+        const_cast<char*>("--multi-bundle"),
+        const_cast<char*>("-p"),
+        const_cast<char*>("/data/local/tmp/bundle_test_tool_quick_fix_not_exist"),
+        const_cast<char*>(""),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleTestTool cmd(argc, argv);
+    optind = 0;
+    EXPECT_NE(cmd.RunAsDeployQuickFix(), OHOS::ERR_OK);
+    EXPECT_EQ(cmd.resultReceiver_.find("deploy quick fix failed\n"), 0);
+    EXPECT_EQ(cmd.resultReceiver_.find("bundle count: "), std::string::npos);
+
+    char *helpArgv[] = {
+        const_cast<char*>(TEST_TOOL_NAME.c_str()),
+        const_cast<char*>("deployQuickFix"),
+        const_cast<char*>("-h"),
+        const_cast<char*>(""),
+    };
+    BundleTestTool helpCmd(sizeof(helpArgv) / sizeof(helpArgv[0]) - 1, helpArgv);
+    optind = 0;
+    helpCmd.RunAsDeployQuickFix();
+    EXPECT_NE(helpCmd.resultReceiver_.find("  --multi-bundle"), std::string::npos);
+}
+
+/**
+ * @tc.number: Bundle_Test_Tool_Deploy_Quick_Fix_0200
+ * @tc.name: GroupQuickFixPathsByBundle
+ * @tc.desc: Verify the hqf files are grouped by the bundleName of their patch.json across the patch directories,
+ *           and every invalid patch path is reported.
+ */
+HWTEST_F(BundleTestToolTest, Bundle_Test_Tool_Deploy_Quick_Fix_0200, Function | MediumTest | TestSize.Level1)
+{
+    std::string firstDir = QUICK_FIX_DIR + "/first";
+    std::string secondDir = QUICK_FIX_DIR + "/second";
+    ASSERT_TRUE(mkdir(QUICK_FIX_DIR.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    ASSERT_TRUE(mkdir(firstDir.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    ASSERT_TRUE(mkdir(secondDir.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+    // the first directory mixes two bundles, the second one holds another patch of the first bundle
+    std::string firstPath = firstDir + "/entry.hqf";
+    std::string secondPath = firstDir + "/other.hqf";
+    std::string thirdPath = secondDir + "/feature.hqf";
+    WriteStoredZipFile(firstPath, "patch.json", GetPatchJson(FIRST_BUNDLE_NAME));
+    WriteStoredZipFile(secondPath, "patch.json", GetPatchJson(SECOND_BUNDLE_NAME));
+    WriteStoredZipFile(thirdPath, "patch.json", GetPatchJson(FIRST_BUNDLE_NAME));
+
+    std::map<std::string, std::set<std::string>> groupedPaths;
+    std::string errorMsg;
+    EXPECT_TRUE(BundleTestTool::GroupQuickFixPathsByBundle({ firstDir, secondDir }, groupedPaths, errorMsg));
+    EXPECT_EQ(errorMsg, "");
+    EXPECT_EQ(groupedPaths.size(), 2u);
+    EXPECT_EQ(groupedPaths[FIRST_BUNDLE_NAME], std::set<std::string>({ firstPath, thirdPath }));
+    EXPECT_EQ(groupedPaths[SECOND_BUNDLE_NAME], std::set<std::string>({ secondPath }));
+
+    std::string invalidPath = QUICK_FIX_DIR + "/not_exist";
+    std::string noPatchPath = secondDir + "/no_patch.hqf";
+    WriteStoredZipFile(noPatchPath, "module.json", "{}");
+    groupedPaths.clear();
+    EXPECT_FALSE(BundleTestTool::GroupQuickFixPathsByBundle({ invalidPath, secondDir }, groupedPaths, errorMsg));
+    EXPECT_EQ(errorMsg, invalidPath + ": path is invalid\n" + noPatchPath + ": patch.json is not found\n");
+
+    remove(firstPath.c_str());
+    remove(secondPath.c_str());
+    remove(thirdPath.c_str());
+    remove(noPatchPath.c_str());
+    rmdir(firstDir.c_str());
+    rmdir(secondDir.c_str());
+    rmdir(QUICK_FIX_DIR.c_str());
+}
+}  // namespace OHOS